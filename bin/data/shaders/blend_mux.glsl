@@ -1,6 +1,18 @@
 #pragma include "./blend.glsl"
 
 vec3 blendMux(int blendMode, vec3 background, vec3 color, float a) {
+#ifdef BLEND_MODE
+    // Specialized variant: the mode is fixed at compile time, so there is no branch to evaluate per fragment
+#if BLEND_MODE == 0
+    return blendScreen(background, correctGamma(color, 0.4545), a);
+#elif BLEND_MODE == 1
+    return blendScreen(background, color, a);
+#elif BLEND_MODE == 2
+    return blendAdd(background, color, a);
+#else
+    return vec3(1.0, 0.0, 1.0);
+#endif
+#else
     if (blendMode == 0) {
         return blendScreen(background, correctGamma(color, 0.4545), a);
     } else if (blendMode == 1) {
@@ -10,6 +22,7 @@ vec3 blendMux(int blendMode, vec3 background, vec3 color, float a) {
     } else {
        return vec3(1.0, 0.0, 1.0);
     }
+#endif
 }
 
 // Former 1
@@ -0,0 +1,6 @@
+// Per-draw glow parameters, uploaded by DrawManager::shadeGlow as one vec4 array instead of a uniform each.
+// [0], [1]: shape, see each shader
+// [2]: rgba
+// [3]: glowIntensity, glowDampenRadius, blendMode, toneMap. Variants compiled with BLEND_MODE and TONE_MAP
+//      defined ignore the last two.
+uniform vec4 glowParams[4];
@@ -0,0 +1,58 @@
+// Film grain stage: animated monochrome grain added to color.
+// Pixel-local, so ShaderPipeline can fuse it. Reads the including shader's time uniform.
+
+uniform float grainIntensity;  // 0.0 - 1.0, default 0.05
+uniform float grainSize;       // 1.0 - 4.0, default 1.5
+
+// Pseudo-random noise function
+float filmGrainRand(vec2 co) {
+    return fract(sin(dot(co.xy, vec2(12.9898, 78.233))) * 43758.5453);
+}
+
+// 2D noise function
+float filmGrainNoise(vec2 p) {
+    vec2 i = floor(p);
+    vec2 f = fract(p);
+
+    // Smooth interpolation
+    f = f * f * (3.0 - 2.0 * f);
+
+    // Four corners of the pixel
+    float a = filmGrainRand(i);
+    float b = filmGrainRand(i + vec2(1.0, 0.0));
+    float c = filmGrainRand(i + vec2(0.0, 1.0));
+    float d = filmGrainRand(i + vec2(1.0, 1.0));
+
+    // Bilinear interpolation
+    return mix(mix(a, b, f.x), mix(c, d, f.x), f.y);
+}
+
+// Animated grain with temporal variation
+float filmGrainAmount(vec2 uv, float time) {
+    // Scale UV by grain size
+    vec2 grainUV = uv / grainSize;
+
+    // Add time-based variation for animation
+    float t = time * 2.0;
+    vec2 offset = vec2(filmGrainRand(vec2(t)), filmGrainRand(vec2(t + 1.0)));
+
+    // Generate multi-octave noise for more organic grain
+    float n = filmGrainNoise(grainUV + offset);
+    n += 0.5 * filmGrainNoise(grainUV * 2.0 + offset * 2.0);
+    n += 0.25 * filmGrainNoise(grainUV * 4.0 + offset * 4.0);
+
+    // Normalize
+    n /= 1.75;
+
+    // Center around 0 and scale by intensity
+    return (n - 0.5) * grainIntensity;
+}
+
+vec4 filmGrain(vec4 color, vec2 uv) {
+    // Add grain to all RGB channels (monochromatic grain)
+    color.rgb += vec3(filmGrainAmount(uv, time));
+
+    // Ensure we don't clip or go below 0
+    color.rgb = clamp(color.rgb, 0.0, 1.0);
+    return color;
+}
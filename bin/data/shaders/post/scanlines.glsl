@@ -0,0 +1,36 @@
+// Scanlines stage: animated CRT lines and vignette applied to color.
+// Pixel-local, so ShaderPipeline can fuse it. Reads the including shader's resolution and time uniforms.
+
+uniform float scanlineIntensity;  // 0.0 - 1.0, default 0.3
+uniform float scanlineCount;      // Lines per screen, default 200.0
+uniform float scanlineSpeed;      // Animation speed, default 0.1
+uniform float vignette;           // 0.0 - 1.0, default 0.3
+
+// Vignette effect (darkens edges)
+float scanlinesVignette(vec2 uv) {
+    uv = uv * 2.0 - 1.0;  // Center coordinates (-1 to 1)
+    float dist = length(uv);
+    return 1.0 - smoothstep(0.5, 1.5, dist) * vignette;
+}
+
+vec4 scanlines(vec4 color, vec2 uv) {
+    vec2 normalizedUV = uv / resolution;
+
+    // Animated scanline position
+    float scanlineOffset = time * scanlineSpeed;
+    float scanlinePos = mod(normalizedUV.y * scanlineCount + scanlineOffset, 1.0);
+
+    // Create scanline pattern (sine wave for smooth lines)
+    float scanline = sin(scanlinePos * 3.14159 * 2.0) * 0.5 + 0.5;
+    scanline = 1.0 - (scanline * scanlineIntensity);
+
+    // Apply scanlines
+    color.rgb *= scanline;
+
+    // Apply vignette
+    if (vignette > 0.0) {
+        float vignetteAmount = scanlinesVignette(normalizedUV);
+        color.rgb *= vignetteAmount;
+    }
+    return color;
+}
@@ -4,25 +4,32 @@ precision highp float;
 #pragma include "../shaders/glow.glsl"
 #pragma include "../shaders/sdf.glsl"
 #pragma include "../shaders/blend_mux.glsl"
+#pragma include "../shaders/glow_params.glsl"
 
 uniform sampler2D tex0;
 
 uniform vec2 screenDimensions; // Not used for GL2, only necessary for ES2 where we need pct coords.
-uniform vec3 from;
-uniform vec3 to;
-uniform float r;
-uniform float g;
-uniform float b;
-uniform float a;
-uniform float glowIntensity;
-uniform float glowDampenRadius;
-uniform int blendMode;
-uniform bool toneMap;
 varying vec2 texCoordVarying;
 
 
 void main()
 {
+    vec3 from = glowParams[0].xyz;
+    vec3 to = glowParams[1].xyz;
+    float r = glowParams[2].r;
+    float g = glowParams[2].g;
+    float b = glowParams[2].b;
+    float a = glowParams[2].a;
+    float glowIntensity = glowParams[3].x;
+    float glowDampenRadius = glowParams[3].y;
+#ifdef BLEND_MODE
+    int blendMode = BLEND_MODE;
+    bool toneMap = TONE_MAP != 0;
+#else
+    int blendMode = int(glowParams[3].z);
+    bool toneMap = glowParams[3].w > 0.5;
+#endif
+
     float d = sdSegment(vec3(texCoordVarying * screenDimensions, 0.0), from, to);
     d = max(0.000001, d); // Don't allow zero distance
     
@@ -3,26 +3,33 @@ precision highp float;
 #pragma include "../shaders/glow.glsl"
 #pragma include "../shaders/sdf.glsl"
 #pragma include "../shaders/blend_mux.glsl"
+#pragma include "../shaders/glow_params.glsl"
 
 uniform sampler2D tex0;
 
 uniform vec2 screenDimensions; // Not used for GL2, only necessary for ES2 where we need pct coords.
-uniform vec3 rectA;
-uniform vec3 rectB;
-uniform float theta;
-uniform float r;
-uniform float g;
-uniform float b;
-uniform float a;
-uniform float glowIntensity;
-uniform float glowDampenRadius;
-uniform int blendMode;
-uniform bool toneMap;
 varying vec2 texCoordVarying;
 
 
 void main()
 {
+    vec3 rectA = glowParams[0].xyz;
+    float theta = glowParams[0].w;
+    vec3 rectB = glowParams[1].xyz;
+    float r = glowParams[2].r;
+    float g = glowParams[2].g;
+    float b = glowParams[2].b;
+    float a = glowParams[2].a;
+    float glowIntensity = glowParams[3].x;
+    float glowDampenRadius = glowParams[3].y;
+#ifdef BLEND_MODE
+    int blendMode = BLEND_MODE;
+    bool toneMap = TONE_MAP != 0;
+#else
+    int blendMode = int(glowParams[3].z);
+    bool toneMap = glowParams[3].w > 0.5;
+#endif
+
     float d = sdOrientedBox(texCoordVarying * screenDimensions, rectA.xy, rectB.xy, theta);
     d = max(0.000001, d); // Don't allow zero distance
     
@@ -0,0 +1,21 @@
+
+uniform mat4 modelViewProjectionMatrix;
+
+attribute vec4 position;
+attribute vec4 color;
+attribute vec3 normal;
+attribute vec2 texcoord;
+
+// One quad per sprite, all sprites in a single draw. Per-sprite values ride in the standard mesh channels:
+// texcoord = pixel offset from the sprite center, normal.xy = (center z, radius), color = sprite color.
+varying vec2 offsetVarying;
+varying vec2 depthRadiusVarying;
+varying vec4 colorVarying;
+
+void main()
+{
+    offsetVarying = texcoord;
+    depthRadiusVarying = normal.xy;
+    colorVarying = color;
+    gl_Position = modelViewProjectionMatrix * position;
+}
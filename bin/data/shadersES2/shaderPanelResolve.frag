@@ -0,0 +1,24 @@
+precision highp float;
+
+uniform sampler2D tex0;
+uniform sampler2D lut;         // 256x1, one curve per channel
+uniform vec2 sourceDimensions;
+uniform vec2 footprint;        // Source pixels covered by one panel pixel, along each source axis
+varying vec2 texCoordVarying;
+
+// Resolve the composed frame to one panel pixel: four bilinear taps, each averaging up to a 2x2 block, cover up to a
+// 4x4 box, enough for downscales up to 4x without skipping source pixels. At 1:1 the taps meet at the pixel center,
+// so nothing blurs. Then map each channel through the LUT.
+void main()
+{
+    vec2 o = mix(max(footprint - 1.0, 0.0) * 0.5, footprint * 0.25, step(2.0, footprint)) / sourceDimensions;
+    vec4 color = texture2D(tex0, texCoordVarying + vec2(-o.x, -o.y));
+    color += texture2D(tex0, texCoordVarying + vec2(o.x, -o.y));
+    color += texture2D(tex0, texCoordVarying + vec2(-o.x, o.y));
+    color += texture2D(tex0, texCoordVarying + vec2(o.x, o.y));
+    vec3 index = (clamp(color.rgb / 4.0, 0.0, 1.0) * 255.0 + 0.5) / 256.0;
+    gl_FragColor = vec4(texture2D(lut, vec2(index.r, 0.5)).r,
+                        texture2D(lut, vec2(index.g, 0.5)).g,
+                        texture2D(lut, vec2(index.b, 0.5)).b,
+                        1.0);
+}
@@ -0,0 +1,13 @@
+
+uniform mat4 modelViewProjectionMatrix;
+
+attribute vec4 position;
+attribute vec2 texcoord;
+
+varying vec2 texCoordVarying;
+
+void main()
+{
+    texCoordVarying = texcoord;
+	gl_Position = modelViewProjectionMatrix * position;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#version 120
+
+// Template for a run of pixel-local effects fused into one pass. ShaderPipeline replaces the marker lines with an
+// include and a call per stage, in pipeline order.
+
+uniform sampler2DRect tex0;
+uniform vec2 resolution;
+uniform float time;
+
+// FUSED_STAGE_INCLUDES
+
+void main() {
+    vec2 uv = gl_TexCoord[0].xy;
+    vec4 color = texture2DRect(tex0, uv);
+
+    // FUSED_STAGE_CALLS
+
+    gl_FragColor = color;
+}
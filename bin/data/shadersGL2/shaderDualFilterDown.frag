@@ -0,0 +1,19 @@
+#version 120
+
+uniform sampler2DRect tex0;
+uniform vec2 sourceDimensions; // Not used for GL2, only necessary for ES2 where we need pct coords.
+uniform float offset;          // In source pixels
+varying vec2 texCoordVarying;
+
+// Dual filter (Marius Bjørge, SIGGRAPH 2015) downsample: the target is half the size of the source, so each
+// bilinear tap already averages a 2x2 block. Center plus four diagonal taps.
+void main()
+{
+    vec2 o = vec2(offset, offset);
+    vec4 color = texture2DRect(tex0, texCoordVarying) * 4.0;
+    color += texture2DRect(tex0, texCoordVarying - o);
+    color += texture2DRect(tex0, texCoordVarying + o);
+    color += texture2DRect(tex0, texCoordVarying + vec2(o.x, -o.y));
+    color += texture2DRect(tex0, texCoordVarying - vec2(o.x, -o.y));
+    gl_FragColor = color / 8.0;
+}
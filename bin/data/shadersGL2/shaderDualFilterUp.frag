@@ -0,0 +1,22 @@
+#version 120
+
+uniform sampler2DRect tex0;
+uniform vec2 sourceDimensions; // Not used for GL2, only necessary for ES2 where we need pct coords.
+uniform float offset;          // In source pixels
+uniform float gain;            // 1 except on the final pass to full resolution
+varying vec2 texCoordVarying;
+
+// Dual filter upsample: tent of four edge and four diagonal taps around a target pixel twice the source size.
+void main()
+{
+    vec2 o = vec2(offset, offset);
+    vec4 color = texture2DRect(tex0, texCoordVarying + vec2(-o.x * 2.0, 0.0));
+    color += texture2DRect(tex0, texCoordVarying + vec2(-o.x, o.y)) * 2.0;
+    color += texture2DRect(tex0, texCoordVarying + vec2(0.0, o.y * 2.0));
+    color += texture2DRect(tex0, texCoordVarying + vec2(o.x, o.y)) * 2.0;
+    color += texture2DRect(tex0, texCoordVarying + vec2(o.x * 2.0, 0.0));
+    color += texture2DRect(tex0, texCoordVarying + vec2(o.x, -o.y)) * 2.0;
+    color += texture2DRect(tex0, texCoordVarying + vec2(0.0, -o.y * 2.0));
+    color += texture2DRect(tex0, texCoordVarying + vec2(-o.x, -o.y)) * 2.0;
+    gl_FragColor = color / 12.0 * gain;
+}
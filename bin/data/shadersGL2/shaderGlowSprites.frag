@@ -0,0 +1,27 @@
+#version 120
+
+#pragma include "../shaders/glow.glsl"
+#pragma include "../shaders/sdf.glsl"
+
+uniform float glowIntensity;
+uniform float glowDampenRadius;
+uniform int blendMode;
+uniform bool toneMap;
+varying vec2 offsetVarying;
+varying vec2 depthRadiusVarying;
+varying vec4 colorVarying;
+
+// Same falloff as shaderGlowCircle. Compositing onto the background is left to the blend unit (screen for
+// blendMode 0 and 1, add for 2), so the sprite is written premultiplied by its alpha.
+void main()
+{
+    float d = sdCircle(vec3(offsetVarying, -depthRadiusVarying.x), depthRadiusVarying.y);
+    d = max(0.000001, d); // Don't allow zero distance
+
+    float glow = getGlow(d, glowIntensity, glowDampenRadius);
+    vec3 color = glow * colorVarying.rgb;
+    color = toneMap ? toneMapColor(color) : color;
+    color = blendMode == 0 ? correctGamma(color, 0.4545) : color;
+
+    gl_FragColor = vec4(clamp(color, 0.0, 1.0) * colorVarying.a, 1.0);
+}
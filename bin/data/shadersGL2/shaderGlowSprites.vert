@@ -0,0 +1,15 @@
+#version 120
+
+// One quad per sprite, all sprites in a single draw. Per-sprite values ride in the standard mesh channels:
+// texcoord = pixel offset from the sprite center, normal.xy = (center z, radius), color = sprite color.
+varying vec2 offsetVarying;
+varying vec2 depthRadiusVarying;
+varying vec4 colorVarying;
+
+void main(void)
+{
+    offsetVarying = gl_MultiTexCoord0.xy;
+    depthRadiusVarying = gl_Normal.xy;
+    colorVarying = gl_Color;
+    gl_Position = ftransform();
+}
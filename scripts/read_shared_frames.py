@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+Minimal reader for the shared-memory frame ring published with SHARED_FRAME_OUTPUT (see src/SharedFrameRing.hpp)
+
+Prints frame rate, skipped frames and publish-to-read latency once a second, or saves the newest frame.
+
+Usage: python3 scripts/read_shared_frames.py [--name /orgb-frames] [--save frame.ppm]
+"""
+
+import argparse
+import struct
+import sys
+import time
+from multiprocessing import resource_tracker, shared_memory
+
+MAGIC = b"ORGBFRM1"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQQI")  # magic, version, slotCount, slotStride, latest, closed
+SLOT = struct.Struct("<QQIIII")  # sequence, timestampUs, format, width, height, rowBytes
+HEADER_BYTES = 64
+SLOT_BYTES = 64
+
+
+class FrameRing:
+    def __init__(self, name):
+        self.shm = shared_memory.SharedMemory(name=name.lstrip("/"))
+        # Attaching registers the segment for cleanup as if we had created it; the writer owns it
+        resource_tracker.unregister(self.shm._name, "shared_memory")
+        magic, version, self.slot_count, self.slot_stride, _, _ = HEADER.unpack_from(self.shm.buf, 0)
+        if magic != MAGIC or version != VERSION:
+            raise RuntimeError(f"{name} is not a version {VERSION} frame ring")
+
+    def close(self):
+        self.shm.close()
+
+    def closed(self):
+        return HEADER.unpack_from(self.shm.buf, 0)[5] != 0
+
+    def latest(self):
+        """Return (sequence, timestampUs, width, height, rowBytes, pixels) or None, copying the pixels"""
+        sequence = HEADER.unpack_from(self.shm.buf, 0)[4]
+        if sequence == 0:
+            return None
+        offset = HEADER_BYTES + self.slot_stride * (sequence % self.slot_count)
+        slot_sequence, timestamp_us, _, width, height, row_bytes = SLOT.unpack_from(self.shm.buf, offset)
+        if slot_sequence != sequence:
+            return None
+        start = offset + SLOT_BYTES
+        pixels = bytes(self.shm.buf[start:start + row_bytes * height])
+        # Same seqlock check as SharedFrameReader::stillValid: the writer may have lapped the copy
+        if SLOT.unpack_from(self.shm.buf, offset)[0] != sequence:
+            return None
+        return sequence, timestamp_us, width, height, row_bytes, pixels
+
+
+def save_ppm(path, width, height, row_bytes, pixels):
+    channels = row_bytes // width
+    rgb = bytearray()
+    for i in range(0, width * height * channels, channels):
+        rgb += pixels[i:i + 3] if channels >= 3 else pixels[i:i + 1] * 3
+    with open(path, "wb") as f:
+        f.write(b"P6\n%d %d\n255\n" % (width, height))
+        f.write(rgb)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--name", default="/orgb-frames")
+    parser.add_argument("--save", help="write the newest frame to this PPM file and exit")
+    args = parser.parse_args()
+
+    try:
+        ring = FrameRing(args.name)
+    except FileNotFoundError:
+        sys.exit(f"No frame ring named {args.name}; is orgb running with SHARED_FRAME_OUTPUT={args.name}?")
+
+    if args.save:
+        frame = None
+        while frame is None:
+            frame = ring.latest()
+        sequence, _, width, height, row_bytes, pixels = frame
+        save_ppm(args.save, width, height, row_bytes, pixels)
+        print(f"Saved frame {sequence} ({width}x{height}) to {args.save}")
+        return
+
+    last_sequence, frames, skipped, latency_ms = 0, 0, 0, 0.0
+    report_at = time.time() + 1
+    while True:
+        if ring.closed():
+            ring.close()
+            time.sleep(0.1)
+            try:
+                ring = FrameRing(args.name)
+            except FileNotFoundError:
+                continue
+            last_sequence = 0
+        frame = ring.latest()
+        if frame is not None and frame[0] != last_sequence:
+            if last_sequence:
+                skipped += frame[0] - last_sequence - 1
+            last_sequence = frame[0]
+            frames += 1
+            latency_ms += time.time() * 1000 - frame[1] / 1000
+        if time.time() >= report_at:
+            average = latency_ms / frames if frames else 0
+            print(f"frame {last_sequence}: {frames} fps, {skipped} skipped, {average:.2f} ms latency")
+            frames, skipped, latency_ms = 0, 0, 0.0
+            report_at += 1
+        time.sleep(0.001)
+
+
+if __name__ == "__main__":
+    main()
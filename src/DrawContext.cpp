@@ -10,10 +10,10 @@
 // TODO This is defined
 #define MULTISAMPLE_COUNT 0
 
-ofFbo getConfiguredFrameBuffer(int width, int height) {
+ofFbo getConfiguredFrameBuffer(int width, int height, bool useDepth) {
     ofFbo::Settings settings;
     settings.numSamples = MULTISAMPLE_COUNT;  // also try 8, if your GPU supports it
-    settings.useDepth = true;
+    settings.useDepth = useDepth;
     settings.width = width;
     settings.height = height;
     ofFbo fbo;
@@ -21,26 +21,53 @@ ofFbo getConfiguredFrameBuffer(int width, int height) {
     return fbo;
 }
 
-ofShader createShader(std::string shaderName) {
-    ofShader shader;
-    bool result = false;
+ProgramBinaryCache & getProgramBinaryCache() {
+    static ProgramBinaryCache cache(getEnv("SHADER_BINARY_CACHE_DIR", ofToDataPath("shadercache", true)),
+                                    getEnv("SHADER_BINARY_CACHE", "true") == "true");
+    return cache;
+}
+
+std::string getShaderDirectory() {
 #ifdef TARGET_OPENGLES
     ofLogVerbose("createShader") << "Using OpenGL ES Shader.";
-    shader.load("shadersES2/" + shaderName);
+    return "shadersES2/";
 #else
     if (ofIsGLProgrammableRenderer()) {
         ofLogVerbose("createShader") << "Using OpenGL3 Shader.";
-        shader.load("shadersGL3/" + shaderName);
-    } else {
-        ofLogVerbose("createShader") << "Using OpenGL2 Shader.";
-        shader.load("shadersGL2/" + shaderName);
+        return "shadersGL3/";
     }
+    ofLogVerbose("createShader") << "Using OpenGL2 Shader.";
+    return "shadersGL2/";
 #endif
-    // TODO This is useless. Doesn't indicate an error.
-    //    if (!result) {
-    //        ofLogError("createShader") << "Failed to load " << shaderName;
-    //        throw std::invalid_argument("Failed to load " + shaderName);
-    //    }
+}
+
+ofShader createShader(std::string shaderName) { return createShader(shaderName, {}); }
+
+ofShader createShader(const std::string & shaderName, const std::map<std::string, int> & intDefines) {
+    std::string directory = getShaderDirectory();
+    ProgramBinaryCache & cache = getProgramBinaryCache();
+    uint64_t key = cache.isSupported() ? cache.keyFor(directory, shaderName, intDefines) : 0;
+    ofShader shader;
+    if (cache.isSupported() && cache.load(shader, shaderName, key)) {
+        return shader;
+    }
+
+    if (intDefines.empty()) {
+        if (!shader.load(directory + shaderName)) {
+            ofLogError("createShader") << "Failed to compile " << shaderName;
+        }
+    } else {
+        ofShaderSettings settings;
+        settings.shaderFiles[GL_VERTEX_SHADER] = directory + shaderName + ".vert";
+        settings.shaderFiles[GL_FRAGMENT_SHADER] = directory + shaderName + ".frag";
+        settings.intDefines = intDefines;  // OF inserts these after any #version line
+        if (!shader.setup(settings)) {
+            ofLogError("createShader") << "Failed to compile variant of " << shaderName;
+        }
+    }
+    if (cache.isSupported()) {
+        cache.save(shader, shaderName, key);
+    }
     return shader;
 }
 
@@ -66,3 +93,13 @@ void drawFboAtZeroZero(ofFbo & sourceFrameBuffer) {
     }
     ofPopStyle();
 }
+
+void drawFboAtZeroZero(ofFbo & sourceFrameBuffer, float width, float height) {
+    ofPushStyle();
+    {
+        ofSetColor(255, 255, 255, 255);
+        kkDisableAlphaBlending();
+        sourceFrameBuffer.draw(0, 0, width, height);
+    }
+    ofPopStyle();
+}
@@ -8,13 +8,20 @@
 #ifndef DrawContext_hpp
 #define DrawContext_hpp
 
+#include "ProgramBinaryCache.hpp"
 #include "Utilities.hpp"
 #include "ofMain.h"
 
-ofFbo getConfiguredFrameBuffer(int width, int height);
+ofFbo getConfiguredFrameBuffer(int width, int height, bool useDepth = true);
+std::string getShaderDirectory();  // e.g. "shadersGL2/" for the running renderer
 ofShader createShader(std::string shaderName);
+// Same, with each define inserted as #define NAME value ahead of the source to compile a specialized variant
+ofShader createShader(const std::string & shaderName, const std::map<std::string, int> & intDefines);
+// Linked programs saved by createShader. SHADER_BINARY_CACHE=false disables it; SHADER_BINARY_CACHE_DIR moves it.
+ProgramBinaryCache & getProgramBinaryCache();
 void applyShaderToCurrentFbo(ofFbo & sourceFrameBuffer, ofShader & shader,
                              std::function<void(ofShader &)> & configureShader);  // Write to active frame buffer
 void drawFboAtZeroZero(ofFbo & sourceFrameBuffer);
+void drawFboAtZeroZero(ofFbo & sourceFrameBuffer, float width, float height);  // Stretched to width x height
 
 #endif /* DrawContext_hpp */
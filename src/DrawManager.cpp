@@ -8,132 +8,287 @@
 #include "DrawManager.hpp"
 
 #include "DrawContext.hpp"
+#include "FrameProfiler.hpp"
 
 // TODO This is defined elsewhere, search for it
 #define MULTISAMPLE_COUNT 0
+// Below this the separable 9-tap passes are cheap and a half resolution chain would visibly soften the image.
+#define DUAL_FILTER_MIN_DELTA_PIXELS 2.0
+#define DUAL_FILTER_MAX_LEVELS 5
+
+// Uniform handles, in the order each ShaderPackage declares its uniforms
+enum BlurUniform : size_t { BLUR_OFFSET_STEP_PIXELS, BLUR_GAIN, BLUR_SCREEN_DIMENSIONS };
+enum DualFilterUniform : size_t { DUAL_FILTER_OFFSET, DUAL_FILTER_SOURCE_DIMENSIONS, DUAL_FILTER_GAIN };
+enum GlowUniform : size_t { GLOW_PARAMS, GLOW_SCREEN_DIMENSIONS };
+enum GlowSpritesUniform : size_t {
+    GLOW_SPRITES_INTENSITY,
+    GLOW_SPRITES_DAMPEN_RADIUS,
+    GLOW_SPRITES_BLEND_MODE,
+    GLOW_SPRITES_TONE_MAP
+};
 
 DrawManager::DrawManager()
-    : fboFront(getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight())),
-      fboBack(getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight())),
-      activeCanvas(std::nullopt),
-
-      shaderPackageBlurX("shaderBlurX"),
-      shaderPackageBlurY("shaderBlurY"),
-      shaderPackageGlowLine("shaderGlowLine"),
-      shaderPackageGlowCircle("shaderGlowCircle"),
-      shaderPackageGlowRectangularPrism("shaderGlowRectangularPrism") {
+    // No form depth-tests its canvas (NoiseGrid, MeshGrid and Field turn it off), so the canvases get no depth buffer
+    : fboFront(getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight(), false)),
+      fboBack(getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight(), false)),
+      activeCanvas(nullptr),
+      graph(std::make_shared<RenderGraph>()),
+
+      shaderPackageBlurX("shaderBlurX", {"blurOffsetStepPixels", "gain", "screenDimensions"}),
+      shaderPackageBlurY("shaderBlurY", {"blurOffsetStepPixels", "gain", "screenDimensions"}),
+      shaderPackageDualFilterDown("shaderDualFilterDown", {"offset", "sourceDimensions"}),
+      shaderPackageDualFilterUp("shaderDualFilterUp", {"offset", "sourceDimensions", "gain"}),
+      shaderVariantsGlowLine("shaderGlowLine", {"glowParams", "screenDimensions"}),
+      shaderVariantsGlowCircle("shaderGlowCircle", {"glowParams", "screenDimensions"}),
+      shaderVariantsGlowRectangularPrism("shaderGlowRectangularPrism", {"glowParams", "screenDimensions"}),
+      shaderPackageGlowSprites("shaderGlowSprites", {"glowIntensity", "glowDampenRadius", "blendMode", "toneMap"}) {
+    glowSpriteMesh.setMode(OF_PRIMITIVE_TRIANGLES);
+    glowSpriteMesh.setUsage(GL_STREAM_DRAW);
     //    shaderPackageVHS("shaderVhs") {
     //    initializeFrameBuffers(ofGetWidth(), ofGetHeight());
 }
 
+DrawManager::DrawManager(DrawManager && other) noexcept
+    : activeCanvas(other.activeCanvas != nullptr ? &fboFront : nullptr),
+      fboFront(std::move(other.fboFront)),
+      fboBack(std::move(other.fboBack)),
+      graph(std::move(other.graph)),
+      shaderPackageBlurX(std::move(other.shaderPackageBlurX)),
+      shaderPackageBlurY(std::move(other.shaderPackageBlurY)),
+      shaderPackageDualFilterDown(std::move(other.shaderPackageDualFilterDown)),
+      shaderPackageDualFilterUp(std::move(other.shaderPackageDualFilterUp)),
+      shaderVariantsGlowLine(std::move(other.shaderVariantsGlowLine)),
+      shaderVariantsGlowCircle(std::move(other.shaderVariantsGlowCircle)),
+      shaderVariantsGlowRectangularPrism(std::move(other.shaderVariantsGlowRectangularPrism)),
+      shaderPackageGlowSprites(std::move(other.shaderPackageGlowSprites)),
+      shaders(std::move(other.shaders)),
+      shaderInitializations(std::move(other.shaderInitializations)),
+      fbos(std::move(other.fbos)),
+      glowSpriteMesh(std::move(other.glowSpriteMesh)) {
+    other.activeCanvas = nullptr;
+}
+
+DrawManager & DrawManager::operator=(DrawManager && other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    // The raw pointer would otherwise still point into other
+    activeCanvas = other.activeCanvas != nullptr ? &fboFront : nullptr;
+    other.activeCanvas = nullptr;
+    fboFront = std::move(other.fboFront);
+    fboBack = std::move(other.fboBack);
+    graph = std::move(other.graph);
+    shaderPackageBlurX = std::move(other.shaderPackageBlurX);
+    shaderPackageBlurY = std::move(other.shaderPackageBlurY);
+    shaderPackageDualFilterDown = std::move(other.shaderPackageDualFilterDown);
+    shaderPackageDualFilterUp = std::move(other.shaderPackageDualFilterUp);
+    shaderVariantsGlowLine = std::move(other.shaderVariantsGlowLine);
+    shaderVariantsGlowCircle = std::move(other.shaderVariantsGlowCircle);
+    shaderVariantsGlowRectangularPrism = std::move(other.shaderVariantsGlowRectangularPrism);
+    shaderPackageGlowSprites = std::move(other.shaderPackageGlowSprites);
+    shaders = std::move(other.shaders);
+    shaderInitializations = std::move(other.shaderInitializations);
+    fbos = std::move(other.fbos);
+    glowSpriteMesh = std::move(other.glowSpriteMesh);
+    return *this;
+}
+
+DrawManager::ShaderPackage & DrawManager::ShaderVariants::get(int blendMode, bool toneMap) {
+    auto key = std::make_pair(blendMode, toneMap);
+    auto it = variants.find(key);
+    if (it == variants.end()) {
+        std::string variantName =
+            name + "[blendMode=" + ofToString(blendMode) + ",toneMap=" + ofToString(toneMap) + "]";
+        ofLogNotice("DrawManager::ShaderVariants") << "Compiling " << variantName;
+        auto package = std::make_unique<ShaderPackage>(
+            name, uniformNames, std::map<std::string, int>{{"BLEND_MODE", blendMode}, {"TONE_MAP", toneMap ? 1 : 0}});
+        package->name = variantName;
+        it = variants.emplace(key, std::move(package)).first;
+    }
+    return *it->second;
+}
+
 void DrawManager::beginDraw() {
     // Extremely stateful, see existing examples
-    if (activeCanvas.has_value()) {
+    if (activeCanvas != nullptr) {
         throw std::runtime_error("Can't begin draw with an already active canvas");
     }
     fboFront.begin();
-    activeCanvas = std::optional<ofFbo>(fboFront);
+    activeCanvas = &fboFront;
 }
 
 void DrawManager::endDraw() {
     // End drawing without drawing to screen (for post-processing pipeline)
-    if (activeCanvas.value().getId() != fboFront.getId()) {
-        throw std::runtime_error("Canvas must be front canvas.");
-    }
-    if (!activeCanvas.has_value()) {
+    if (activeCanvas == nullptr) {
         throw std::runtime_error("Can't end draw without an active canvas");
     }
-    activeCanvas.value().end();
-    activeCanvas = std::nullopt;
+    if (activeCanvas != &fboFront) {
+        throw std::runtime_error("Canvas must be front canvas.");
+    }
+    activeCanvas->end();
+    activeCanvas = nullptr;
 }
 
 void DrawManager::endAndDrawFbo() {
     // Extremely stateful, see existing examples
-    if (activeCanvas.value().getId() != fboFront.getId()) {
-        throw std::runtime_error("Canvas must be front canvas.");
-    }
-    if (!activeCanvas.has_value()) {
+    if (activeCanvas == nullptr) {
         throw std::runtime_error("Can't end draw without an active canvas");
     }
-    activeCanvas.value().end();
-    drawFboAtZeroZero(activeCanvas.value());
-    activeCanvas = std::nullopt;
+    if (activeCanvas != &fboFront) {
+        throw std::runtime_error("Canvas must be front canvas.");
+    }
+    activeCanvas->end();
+    drawFboAtZeroZero(*activeCanvas);
+    activeCanvas = nullptr;
 }
 
 void DrawManager::shaderEpilogue(ShaderPackage & sp) {
     // Extremely stateful, see existing examples
-    if (activeCanvas.value().getId() != fboFront.getId()) {
-        throw std::runtime_error("Canvas must be front canvas.");
-    }
-    if (!activeCanvas.has_value()) {
+    if (activeCanvas == nullptr) {
         throw std::runtime_error("Can't end shader without an active canvas");
     }
+    if (activeCanvas != &fboFront) {
+        throw std::runtime_error("Canvas must be front canvas.");
+    }
 
     // Now the fboBack is rendered, we want to draw it to the foreground.
 
     // Assuming a shader is active and its uniforms are set at this point here
     fboFront.end();
-    fboBack.begin();
-    drawFboAtZeroZero(fboFront);  // Draw back to
-    sp.shader.end();
+    {
+        PROFILE_ZONE_NAMED(sp.name);
+        graph->getTimer().begin(sp.name);
+        fboBack.begin();
+        drawFboAtZeroZero(fboFront);  // Draw back to
+        graph->getTimer().end();
+        sp.shader.end();
+    }
 
     std::swap(fboFront, fboBack);
-    activeCanvas = std::optional<ofFbo>(fboFront);
+    // The swap moves the other buffer into fboFront, so activeCanvas already points at the new front
+    graph->recordPass(sp.name, {"canvas"}, "canvas", fboFront.getWidth(), fboFront.getHeight());
 }
 
 void DrawManager::shadeBlurX(float delta, float gain) {
     shaderPackageBlurX.shader.begin();
-    shaderPackageBlurX.shader.setUniform1f("blurOffsetStepPixels", delta);
-    shaderPackageBlurX.shader.setUniform1f("gain", gain);
-    shaderPackageBlurX.shader.setUniform2f("screenDimensions", ofGetWidth(), ofGetHeight());
+    shaderPackageBlurX.uniforms.set1f(BLUR_OFFSET_STEP_PIXELS, delta);
+    shaderPackageBlurX.uniforms.set1f(BLUR_GAIN, gain);
+    shaderPackageBlurX.uniforms.set2f(BLUR_SCREEN_DIMENSIONS, ofGetWidth(), ofGetHeight());
     shaderEpilogue(shaderPackageBlurX);
 }
 
 void DrawManager::shadeBlurY(float delta, float gain) {
     shaderPackageBlurY.shader.begin();
-    shaderPackageBlurY.shader.setUniform1f("blurOffsetStepPixels", delta);
-    shaderPackageBlurY.shader.setUniform1f("gain", gain);
-    shaderPackageBlurY.shader.setUniform2f("screenDimensions", ofGetWidth(), ofGetHeight());
+    shaderPackageBlurY.uniforms.set1f(BLUR_OFFSET_STEP_PIXELS, delta);
+    shaderPackageBlurY.uniforms.set1f(BLUR_GAIN, gain);
+    shaderPackageBlurY.uniforms.set2f(BLUR_SCREEN_DIMENSIONS, ofGetWidth(), ofGetHeight());
     shaderEpilogue(shaderPackageBlurY);
 }
 
+void DrawManager::shadeBlur(float delta, float gain) {
+    if (delta < DUAL_FILTER_MIN_DELTA_PIXELS) {
+        shadeBlurX(delta, gain);
+        shadeBlurY(delta, gain);
+        return;
+    }
+    if (activeCanvas != &fboFront) {
+        throw std::runtime_error("Canvas must be front canvas.");
+    }
+
+    // Level i is 1 / 2^(i + 1) of the canvas size, stopping once it reaches a single pixel
+    std::vector<RenderTargetDesc> levelDescs;
+    int width = fboFront.getWidth();
+    int height = fboFront.getHeight();
+    while (levelDescs.size() < DUAL_FILTER_MAX_LEVELS && (width > 1 || height > 1)) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        levelDescs.push_back({width, height, GL_RGBA, false});
+    }
+
+    // The separable pair is a Gaussian with sigma of about delta pixels. Each dual filter level roughly doubles
+    // the radius, so pick the level count from log2(delta) and use the tap offset to cover the remainder.
+    int levels = std::min(static_cast<int>(std::floor(std::log2(delta))), static_cast<int>(levelDescs.size()));
+    levels = std::max(levels, 1);
+    float offset = std::max(delta / static_cast<float>(1 << levels), 0.5f);
+
+    // Draw the input into the output through one filter pass. The final pass leaves its target bound so it can
+    // be handed over as the active canvas.
+    auto filter = [this, offset](ShaderPackage & sp, float passGain, bool keepBound) -> RenderGraph::PassFunction {
+        return [this, &sp, offset, passGain, keepBound](const std::vector<ofFbo *> & inputs, ofFbo & output) {
+            ofFbo & source = *inputs[0];
+            output.begin();
+            sp.shader.begin();
+            sp.uniforms.set1f(DUAL_FILTER_OFFSET, offset);
+            sp.uniforms.set2f(DUAL_FILTER_SOURCE_DIMENSIONS, source.getWidth(), source.getHeight());
+            if (&sp == &shaderPackageDualFilterUp) {
+                sp.uniforms.set1f(DUAL_FILTER_GAIN, passGain);
+            }
+            drawFboAtZeroZero(source, output.getWidth(), output.getHeight());
+            sp.shader.end();
+            if (!keepBound) {
+                output.end();
+            }
+        };
+    };
+
+    // Every level is written once, so the up chain gets its own targets. The pool hands them the FBOs the down
+    // chain has finished reading, so this costs no more memory than filtering in place.
+    fboFront.end();
+    RenderGraph::ResourceId previous = graph->importTarget("canvas", fboFront);
+    for (int i = 0; i < levels; i++) {
+        RenderGraph::ResourceId down = graph->createTarget("blurDown" + ofToString(i), levelDescs[i]);
+        graph->addPass(shaderPackageDualFilterDown.name, {previous}, down,
+                       filter(shaderPackageDualFilterDown, 1.0, false));
+        previous = down;
+    }
+    for (int i = levels - 2; i >= 0; i--) {
+        RenderGraph::ResourceId up = graph->createTarget("blurUp" + ofToString(i), levelDescs[i]);
+        graph->addPass(shaderPackageDualFilterUp.name, {previous}, up, filter(shaderPackageDualFilterUp, 1.0, false));
+        previous = up;
+    }
+    // The final upsample lands in the back canvas, which becomes the front like in shaderEpilogue. gain is
+    // squared because the separable path applies it once per axis.
+    RenderGraph::ResourceId back = graph->importTarget("canvasBack", fboBack);
+    graph->addPass(shaderPackageDualFilterUp.name, {previous}, back,
+                   filter(shaderPackageDualFilterUp, gain * gain, true));
+    graph->execute();
+
+    std::swap(fboFront, fboBack);
+}
+
+void DrawManager::shadeGlow(ShaderPackage & sp, const glm::vec4 & shapeA, const glm::vec4 & shapeB, ofColor c,
+                            float glowIntensity, float glowDampenRadius, int blendMode, bool toneMap) {
+    // Layout matches glowParams in the glow shaders
+    const glm::vec4 params[4] = {
+        shapeA,
+        shapeB,
+        glm::vec4(c.r / 255.0, c.g / 255.0, c.b / 255.0, c.a / 255.0),
+        glm::vec4(glowIntensity, glowDampenRadius, blendMode, toneMap ? 1.0 : 0.0),
+    };
+    sp.shader.begin();
+    sp.uniforms.set4fv(GLOW_PARAMS, &params[0].x, 4);
+    sp.uniforms.set2f(GLOW_SCREEN_DIMENSIONS, ofGetWidth(), ofGetHeight());
+    shaderEpilogue(sp);
+}
+
 void DrawManager::shadeGlowLine(ofVec3f from, ofVec3f to, ofColor c, float glowIntensity, float glowDampenRadius,
                                 int blendMode, bool toneMap) {
     // NOTE: Because this changes FBO, this resets the OF_MATRIX_MODELVIEW matrix.
     ofVec3f fromGlobal = applyGlobalTransformation(from);
     ofVec3f toGlobal = applyGlobalTransformation(to);
-    shaderPackageGlowLine.shader.begin();
-    shaderPackageGlowLine.shader.setUniform3f("from", fromGlobal);
-    shaderPackageGlowLine.shader.setUniform3f("to", toGlobal);
-    shaderPackageGlowLine.shader.setUniform1f("r", c.r / 255.0);
-    shaderPackageGlowLine.shader.setUniform1f("g", c.g / 255.0);
-    shaderPackageGlowLine.shader.setUniform1f("b", c.b / 255.0);
-    shaderPackageGlowLine.shader.setUniform1f("a", c.a / 255.0);
-    shaderPackageGlowLine.shader.setUniform1f("glowIntensity", glowIntensity);
-    shaderPackageGlowLine.shader.setUniform1f("glowDampenRadius", glowDampenRadius);
-    shaderPackageGlowLine.shader.setUniform1i("blendMode", blendMode);
-    shaderPackageGlowLine.shader.setUniform1i("toneMap", toneMap);
-    shaderPackageGlowLine.shader.setUniform2f("screenDimensions", ofGetWidth(), ofGetHeight());
-    shaderEpilogue(shaderPackageGlowLine);
+    ShaderPackage & sp = shaderVariantsGlowLine.get(blendMode, toneMap);
+    shadeGlow(sp, glm::vec4(fromGlobal, 0), glm::vec4(toGlobal, 0), c, glowIntensity, glowDampenRadius, blendMode,
+              toneMap);
 }
 
 void DrawManager::shadeGlowCircle(ofVec3f center, float radius, ofColor c, float glowIntensity, float glowDampenRadius,
                                   int blendMode, bool toneMap) {
     // NOTE: Because this changes FBO, this resets the OF_MATRIX_MODELVIEW matrix.
     ofVec3f centerGlobal = applyGlobalTransformation(center);
-    shaderPackageGlowCircle.shader.begin();
-    shaderPackageGlowCircle.shader.setUniform3f("center", centerGlobal);
-    shaderPackageGlowCircle.shader.setUniform1f("radius", radius);  // Size-invariant w.r.t short edge (st)
-    shaderPackageGlowCircle.shader.setUniform1f("r", c.r / 255.0);
-    shaderPackageGlowCircle.shader.setUniform1f("g", c.g / 255.0);
-    shaderPackageGlowCircle.shader.setUniform1f("b", c.b / 255.0);
-    shaderPackageGlowCircle.shader.setUniform1f("a", c.a / 255.0);
-    shaderPackageGlowCircle.shader.setUniform1f("glowIntensity", glowIntensity);
-    shaderPackageGlowCircle.shader.setUniform1f("glowDampenRadius", glowDampenRadius);
-    shaderPackageGlowCircle.shader.setUniform1i("blendMode", blendMode);
-    shaderPackageGlowCircle.shader.setUniform1i("toneMap", toneMap);
-    shaderPackageGlowCircle.shader.setUniform2f("screenDimensions", ofGetWidth(), ofGetHeight());
-    shaderEpilogue(shaderPackageGlowCircle);
+    // Radius is size-invariant w.r.t short edge (st)
+    ShaderPackage & sp = shaderVariantsGlowCircle.get(blendMode, toneMap);
+    shadeGlow(sp, glm::vec4(centerGlobal, radius), glm::vec4(0), c, glowIntensity, glowDampenRadius, blendMode,
+              toneMap);
 }
 
 void DrawManager::shadeGlowRectangularPrism(ofVec3f a, ofVec3f b, float theta, ofColor c, float glowIntensity,
@@ -141,20 +296,81 @@ void DrawManager::shadeGlowRectangularPrism(ofVec3f a, ofVec3f b, float theta, o
     // NOTE: Because this changes FBO, this resets the OF_MATRIX_MODELVIEW matrix.
     ofVec3f aGlobal = applyGlobalTransformation(a);
     ofVec3f bGlobal = applyGlobalTransformation(b);
-    shaderPackageGlowRectangularPrism.shader.begin();
-    shaderPackageGlowRectangularPrism.shader.setUniform3f("rectA", aGlobal);
-    shaderPackageGlowRectangularPrism.shader.setUniform3f("rectB", bGlobal);
-    shaderPackageGlowRectangularPrism.shader.setUniform1f("theta", theta);
-    shaderPackageGlowRectangularPrism.shader.setUniform1f("r", c.r / 255.0);
-    shaderPackageGlowRectangularPrism.shader.setUniform1f("g", c.g / 255.0);
-    shaderPackageGlowRectangularPrism.shader.setUniform1f("b", c.b / 255.0);
-    shaderPackageGlowRectangularPrism.shader.setUniform1f("a", c.a / 255.0);
-    shaderPackageGlowRectangularPrism.shader.setUniform1f("glowIntensity", glowIntensity);
-    shaderPackageGlowRectangularPrism.shader.setUniform1f("glowDampenRadius", glowDampenRadius);
-    shaderPackageGlowRectangularPrism.shader.setUniform1i("blendMode", blendMode);
-    shaderPackageGlowRectangularPrism.shader.setUniform1i("toneMap", toneMap);
-    shaderPackageGlowRectangularPrism.shader.setUniform2f("screenDimensions", ofGetWidth(), ofGetHeight());
-    shaderEpilogue(shaderPackageGlowRectangularPrism);
+    ShaderPackage & sp = shaderVariantsGlowRectangularPrism.get(blendMode, toneMap);
+    shadeGlow(sp, glm::vec4(aGlobal, theta), glm::vec4(bGlobal, 0), c, glowIntensity, glowDampenRadius, blendMode,
+              toneMap);
+}
+
+void DrawManager::drawGlowSprites(const std::vector<GlowSprite> & sprites, float glowIntensity,
+                                  float glowDampenRadius, int blendMode, bool toneMap) {
+    if (sprites.empty()) {
+        return;
+    }
+    ofBlendMode spriteBlendMode;
+    if (!getGlowSpriteBlendMode(blendMode, spriteBlendMode)) {
+        // Each glow gets its own full-screen pass, which resets the model matrix, so it is restored every time
+        glm::mat4 modelViewMatrix = ofGetCurrentMatrix(OF_MATRIX_MODELVIEW);
+        for (const auto & sprite : sprites) {
+            ofPushMatrix();
+            ofLoadMatrix(modelViewMatrix);
+            shadeGlowCircle(sprite.center, sprite.radius, ofColor(sprite.color), glowIntensity, glowDampenRadius,
+                            blendMode, toneMap);
+            ofPopMatrix();
+        }
+        return;
+    }
+    // Same model-to-screen transform as applyGlobalTransformation, computed once for the batch.
+    glm::mat4 modelMatrix = glm::inverse(ofGetCurrentViewMatrix()) * ofGetCurrentMatrix(OF_MATRIX_MODELVIEW);
+    // getGlow() is (dampen / d)^intensity, which drops below 1/255 at d = dampen * 255^(1 / intensity). Beyond
+    // the screen diagonal the quad would only be clipped anyway.
+    float screenDiagonal = glm::length(glm::vec2(ofGetWidth(), ofGetHeight()));
+    float fadeDistance = glowIntensity > 0 ? glowDampenRadius * pow(255.0f, 1.0f / glowIntensity) : screenDiagonal;
+
+    glowSpriteMesh.clear();
+    const glm::vec2 corners[6] = {{-1, -1}, {1, -1}, {1, 1}, {-1, -1}, {1, 1}, {-1, 1}};
+    for (const auto & sprite : sprites) {
+        glm::vec4 center = modelMatrix * glm::vec4(sprite.center, 1);
+        float extent = std::min(sprite.radius + fadeDistance, screenDiagonal);
+        for (const auto & corner : corners) {
+            glm::vec2 offset = corner * extent;
+            glowSpriteMesh.addVertex(glm::vec3(center.x + offset.x, center.y + offset.y, 0));
+            glowSpriteMesh.addTexCoord(offset);
+            glowSpriteMesh.addNormal(glm::vec3(center.z, sprite.radius, 0));
+            glowSpriteMesh.addColor(sprite.color);
+        }
+    }
+
+    ofPushStyle();
+    ofPushMatrix();
+    // Vertices are already in screen space
+    ofLoadMatrix(ofGetCurrentViewMatrix());
+    // Screen and add are order independent, so one blended draw matches compositing the glows one by one.
+    ofEnableBlendMode(spriteBlendMode);
+    shaderPackageGlowSprites.shader.begin();
+    shaderPackageGlowSprites.uniforms.set1f(GLOW_SPRITES_INTENSITY, glowIntensity);
+    shaderPackageGlowSprites.uniforms.set1f(GLOW_SPRITES_DAMPEN_RADIUS, glowDampenRadius);
+    shaderPackageGlowSprites.uniforms.set1i(GLOW_SPRITES_BLEND_MODE, blendMode);
+    shaderPackageGlowSprites.uniforms.set1i(GLOW_SPRITES_TONE_MAP, toneMap);
+    glowSpriteMesh.draw();
+    shaderPackageGlowSprites.shader.end();
+    ofPopMatrix();
+    ofPopStyle();
+}
+
+// The blend unit's equivalent of blendMux in blend_mux.glsl. Mode 0 is screen too: its gamma correction is
+// applied to the sprite color in the shader.
+bool DrawManager::getGlowSpriteBlendMode(int blendMode, ofBlendMode & mode) {
+    switch (blendMode) {
+        case 0:
+        case 1:
+            mode = OF_BLENDMODE_SCREEN;
+            return true;
+        case 2:
+            mode = OF_BLENDMODE_ADD;
+            return true;
+        default:
+            return false;
+    }
 }
 
 // void DrawManager::shadeVHS(ofVec2f aberration, float aberrationOpacity) {
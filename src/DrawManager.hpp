@@ -8,9 +8,12 @@
 #ifndef DrawManager_hpp
 #define DrawManager_hpp
 
-#include <optional>
+#include <map>
+#include <memory>
 
 #include "DrawContext.hpp"
+#include "RenderGraph.hpp"
+#include "UniformCache.hpp"
 #include "ofMain.h"
 
 #define GAUSSIAN_CENTER_PIXEL 0.382928
@@ -22,15 +25,48 @@ class DrawManager {
    public:
     class ShaderPackage {
        public:
-        explicit ShaderPackage(const std::string & shaderName) : shader(createShader(shaderName)) {}
+        // Uniform handles are the positions of their names in uniformNames
+        ShaderPackage(const std::string & shaderName, const std::vector<std::string> & uniformNames,
+                      const std::map<std::string, int> & intDefines = {})
+            : name(shaderName), shader(createShader(shaderName, intDefines)) {
+            for (const auto & uniformName : uniformNames) {
+                uniforms.declare(shader, uniformName);
+            }
+        }
+        std::string name;
         ofShader shader;
+        UniformCache uniforms;
     };
-    std::optional<ofFbo> activeCanvas;
+
+    // The glow shaders specialized per blend mode and tone map setting. Each variant is compiled with
+    // BLEND_MODE and TONE_MAP defined, which turns blendMux and the tone map choice into straight-line code
+    // instead of a branch per fragment. Variants are compiled on first use and kept.
+    class ShaderVariants {
+       public:
+        ShaderVariants(const std::string & shaderName, const std::vector<std::string> & uniformNames)
+            : name(shaderName), uniformNames(uniformNames) {}
+        ShaderPackage & get(int blendMode, bool toneMap);
+        [[nodiscard]] size_t getCompiledCount() const { return variants.size(); }
+
+       private:
+        std::string name;
+        std::vector<std::string> uniformNames;
+        std::map<std::pair<int, bool>, std::unique_ptr<ShaderPackage>> variants;
+    };
+    ofFbo * activeCanvas;  // Points at fboFront while drawing, nullptr otherwise
     ofFbo fboFront;
     ofFbo fboBack;
 
+    // Shared with the post-processing pipeline so both draw transient targets from one pool. Forms that need
+    // scratch targets should take them from here rather than keeping their own FBOs.
+    std::shared_ptr<RenderGraph> graph;
+
     DrawManager();
-    ~DrawManager() = default;
+    // Move-only, since the shader variants are. A move made mid-draw leaves activeCanvas on the new fboFront.
+    DrawManager(DrawManager && other) noexcept;
+    DrawManager & operator=(DrawManager && other) noexcept;
+    DrawManager(const DrawManager &) = delete;
+    DrawManager & operator=(const DrawManager &) = delete;
 
     void beginDraw();
     void endDraw();  // End drawing without drawing to screen
@@ -44,16 +80,36 @@ class DrawManager {
     void shadeBlurX(float delta, float gain = 1.0);
     ShaderPackage shaderPackageBlurY;
     void shadeBlurY(float delta, float gain = 1.0);
-    ShaderPackage shaderPackageGlowLine;
+    // Same look as shadeBlurX followed by shadeBlurY, including gain applied once per axis. Large radii go
+    // through a downsampled dual filter chain instead of two full-resolution passes.
+    ShaderPackage shaderPackageDualFilterDown;
+    ShaderPackage shaderPackageDualFilterUp;
+    void shadeBlur(float delta, float gain = 1.0);
+    ShaderVariants shaderVariantsGlowLine;
     void shadeGlowLine(ofVec3f from, ofVec3f to, ofColor c, float intensity, float glowDampenRadius, int blendMode,
                        bool toneMap);
-    ShaderPackage shaderPackageGlowCircle;
+    ShaderVariants shaderVariantsGlowCircle;
     void shadeGlowCircle(ofVec3f center, float radius, ofColor c, float intensity, float glowDampenRadius,
                          int blendMode, bool toneMap);
-    ShaderPackage shaderPackageGlowRectangularPrism;
+    ShaderVariants shaderVariantsGlowRectangularPrism;
     void shadeGlowRectangularPrism(ofVec3f a, ofVec3f b, float theta, ofColor c, float intensity,
                                    float glowDampenRadius, int blendMode, bool toneMap);
 
+    // Many shadeGlowCircle()s in one draw call. Each sprite is a screen-space quad sized to where its glow
+    // fades below one 8-bit step, blended straight onto the active canvas instead of a full-screen FBO swap.
+    // Centers are in the current model coordinates, like shadeGlowCircle. Blend modes the blend unit can't
+    // express fall back to one shadeGlowCircle per sprite.
+    struct GlowSprite {
+        glm::vec3 center;
+        float radius;
+        ofFloatColor color;
+    };
+    ShaderPackage shaderPackageGlowSprites;
+    void drawGlowSprites(const std::vector<GlowSprite> & sprites, float intensity, float glowDampenRadius,
+                         int blendMode, bool toneMap);
+    // The fixed-function blend for a glow blendMode, or false if it needs the shader path
+    static bool getGlowSpriteBlendMode(int blendMode, ofBlendMode & mode);
+
     //    ShaderPackage shaderPackageVHS;
     //    void shadeVHS(ofVec2f aberration, float aberrationOpacity);
 
@@ -67,10 +123,15 @@ class DrawManager {
 
    private:
     void shaderEpilogue(ShaderPackage & sp);
+    // Shape parameters are packed with the color and glow settings into one vec4 array, one upload per draw
+    void shadeGlow(ShaderPackage & sp, const glm::vec4 & shapeA, const glm::vec4 & shapeB, ofColor c,
+                   float glowIntensity, float glowDampenRadius, int blendMode, bool toneMap);
 
     std::vector<ofShader> shaders;
     std::vector<std::function<void(ofShader &)>> shaderInitializations;
     std::vector<ofFbo> fbos;
+
+    ofVboMesh glowSpriteMesh;
 };
 
 #endif /* DrawManager_hpp */
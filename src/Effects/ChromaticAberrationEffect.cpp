@@ -12,10 +12,11 @@ ChromaticAberrationEffect::ChromaticAberrationEffect()
       radialAmount(0.3f),
       noiseAmount(0.2f) {
     // Add parameters for GUI control
-    addParameter(ShaderParameter::Float("Intensity", "intensity", intensity, 0.0f, 50.0f));
-    addParameter(ShaderParameter::Float("Direction", "direction", direction, 0.0f, 360.0f));
-    addParameter(ShaderParameter::Float("Radial Amount", "radialAmount", radialAmount, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("Noise Amount", "noiseAmount", noiseAmount, 0.0f, 1.0f));
+    intensityUniform = addParameter(ShaderParameter::Float("Intensity", "intensity", intensity, 0.0f, 50.0f));
+    directionUniform = addParameter(ShaderParameter::Float("Direction", "direction", direction, 0.0f, 360.0f));
+    radialAmountUniform =
+        addParameter(ShaderParameter::Float("Radial Amount", "radialAmount", radialAmount, 0.0f, 1.0f));
+    noiseAmountUniform = addParameter(ShaderParameter::Float("Noise Amount", "noiseAmount", noiseAmount, 0.0f, 1.0f));
 
     // Setup ofParameter integration
     parameterGroup.setName("Chromatic Aberration");
@@ -75,10 +76,10 @@ void ChromaticAberrationEffect::setNoiseAmount(float value) {
 }
 
 void ChromaticAberrationEffect::configureShaderUniforms(ofShader & shader, const glm::vec2 & resolution) {
-    shader.setUniform1f("intensity", intensity);
-    shader.setUniform1f("direction", direction);
-    shader.setUniform1f("radialAmount", radialAmount);
-    shader.setUniform1f("noiseAmount", noiseAmount);
+    setUniform1f(intensityUniform, intensity);
+    setUniform1f(directionUniform, direction);
+    setUniform1f(radialAmountUniform, radialAmount);
+    setUniform1f(noiseAmountUniform, noiseAmount);
 }
 
 void ChromaticAberrationEffect::onEnableChanged(bool & value) { setEnabled(value); }
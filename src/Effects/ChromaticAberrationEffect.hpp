@@ -37,6 +37,12 @@ class ChromaticAberrationEffect : public ShaderEffect {
     float radialAmount;   // 0.0 - 1.0
     float noiseAmount;    // 0.0 - 1.0
 
+    // Declared uniforms, set each frame
+    size_t intensityUniform;
+    size_t directionUniform;
+    size_t radialAmountUniform;
+    size_t noiseAmountUniform;
+
     // ofParameter integration for GUI
     ofParameterGroup parameterGroup;
     ofParameter<bool> enableParam;
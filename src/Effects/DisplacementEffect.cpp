@@ -13,11 +13,11 @@ DisplacementEffect::DisplacementEffect()
       warpAmount(0.5f),
       turbulence(0.5f) {
     // Add parameters for GUI control
-    addParameter(ShaderParameter::Float("Intensity", "intensity", intensity, 0.0f, 100.0f));
-    addParameter(ShaderParameter::Float("Noise Scale", "noiseScale", noiseScale, 0.001f, 0.1f));
-    addParameter(ShaderParameter::Float("Speed", "noiseSpeed", noiseSpeed, 0.0f, 5.0f));
-    addParameter(ShaderParameter::Float("Warp", "warpAmount", warpAmount, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("Turbulence", "turbulence", turbulence, 0.0f, 1.0f));
+    intensityUniform = addParameter(ShaderParameter::Float("Intensity", "intensity", intensity, 0.0f, 100.0f));
+    noiseScaleUniform = addParameter(ShaderParameter::Float("Noise Scale", "noiseScale", noiseScale, 0.001f, 0.1f));
+    noiseSpeedUniform = addParameter(ShaderParameter::Float("Speed", "noiseSpeed", noiseSpeed, 0.0f, 5.0f));
+    warpAmountUniform = addParameter(ShaderParameter::Float("Warp", "warpAmount", warpAmount, 0.0f, 1.0f));
+    turbulenceUniform = addParameter(ShaderParameter::Float("Turbulence", "turbulence", turbulence, 0.0f, 1.0f));
 
     // Setup ofParameter integration
     parameterGroup.setName("Displacement");
@@ -88,11 +88,11 @@ void DisplacementEffect::setTurbulence(float value) {
 }
 
 void DisplacementEffect::configureShaderUniforms(ofShader & shader, const glm::vec2 & resolution) {
-    shader.setUniform1f("intensity", intensity);
-    shader.setUniform1f("noiseScale", noiseScale);
-    shader.setUniform1f("noiseSpeed", noiseSpeed);
-    shader.setUniform1f("warpAmount", warpAmount);
-    shader.setUniform1f("turbulence", turbulence);
+    setUniform1f(intensityUniform, intensity);
+    setUniform1f(noiseScaleUniform, noiseScale);
+    setUniform1f(noiseSpeedUniform, noiseSpeed);
+    setUniform1f(warpAmountUniform, warpAmount);
+    setUniform1f(turbulenceUniform, turbulence);
 }
 
 void DisplacementEffect::onEnableChanged(bool & value) { setEnabled(value); }
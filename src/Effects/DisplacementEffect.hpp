@@ -40,6 +40,13 @@ class DisplacementEffect : public ShaderEffect {
     float warpAmount;     // 0.0 - 1.0
     float turbulence;     // 0.0 - 1.0
 
+    // Declared uniforms, set each frame
+    size_t intensityUniform;
+    size_t noiseScaleUniform;
+    size_t noiseSpeedUniform;
+    size_t warpAmountUniform;
+    size_t turbulenceUniform;
+
     // ofParameter integration for GUI
     ofParameterGroup parameterGroup;
     ofParameter<bool> enableParam;
@@ -14,12 +14,15 @@ FeedbackEffect::FeedbackEffect()
       rotation(0.0f),
       feedbackColor(0.0f) {
     // Add parameters for GUI control
-    addParameter(ShaderParameter::Float("Intensity", "intensity", intensity, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("Displacement X", "displacementX", displacementX, -10.0f, 10.0f));
-    addParameter(ShaderParameter::Float("Displacement Y", "displacementY", displacementY, -10.0f, 10.0f));
-    addParameter(ShaderParameter::Float("Scale", "scale", scale, 0.95f, 1.05f));
-    addParameter(ShaderParameter::Float("Rotation", "rotation", rotation, -5.0f, 5.0f));
-    addParameter(ShaderParameter::Float("Color Shift", "feedbackColor", feedbackColor, 0.0f, 1.0f));
+    intensityUniform = addParameter(ShaderParameter::Float("Intensity", "intensity", intensity, 0.0f, 1.0f));
+    displacementXUniform =
+        addParameter(ShaderParameter::Float("Displacement X", "displacementX", displacementX, -10.0f, 10.0f));
+    displacementYUniform =
+        addParameter(ShaderParameter::Float("Displacement Y", "displacementY", displacementY, -10.0f, 10.0f));
+    scaleUniform = addParameter(ShaderParameter::Float("Scale", "scale", scale, 0.95f, 1.05f));
+    rotationUniform = addParameter(ShaderParameter::Float("Rotation", "rotation", rotation, -5.0f, 5.0f));
+    feedbackColorUniform =
+        addParameter(ShaderParameter::Float("Color Shift", "feedbackColor", feedbackColor, 0.0f, 1.0f));
 
     // Setup ofParameter integration
     parameterGroup.setName("Feedback");
@@ -102,12 +105,12 @@ void FeedbackEffect::setFeedbackColor(float value) {
 }
 
 void FeedbackEffect::configureShaderUniforms(ofShader & shader, const glm::vec2 & resolution) {
-    shader.setUniform1f("intensity", intensity);
-    shader.setUniform1f("displacementX", displacementX);
-    shader.setUniform1f("displacementY", displacementY);
-    shader.setUniform1f("scale", scale);
-    shader.setUniform1f("rotation", rotation);
-    shader.setUniform1f("feedbackColor", feedbackColor);
+    setUniform1f(intensityUniform, intensity);
+    setUniform1f(displacementXUniform, displacementX);
+    setUniform1f(displacementYUniform, displacementY);
+    setUniform1f(scaleUniform, scale);
+    setUniform1f(rotationUniform, rotation);
+    setUniform1f(feedbackColorUniform, feedbackColor);
 }
 
 void FeedbackEffect::onEnableChanged(bool & value) { setEnabled(value); }
@@ -43,6 +43,14 @@ class FeedbackEffect : public ShaderEffect {
     float rotation;          // -5.0 - 5.0 degrees
     float feedbackColor;     // 0.0 - 1.0
 
+    // Declared uniforms, set each frame
+    size_t intensityUniform;
+    size_t displacementXUniform;
+    size_t displacementYUniform;
+    size_t scaleUniform;
+    size_t rotationUniform;
+    size_t feedbackColorUniform;
+
     // ofParameter integration for GUI
     ofParameterGroup parameterGroup;
     ofParameter<bool> enableParam;
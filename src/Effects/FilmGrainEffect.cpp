@@ -8,8 +8,8 @@
 FilmGrainEffect::FilmGrainEffect()
     : ShaderEffect("Film Grain", "post/shaderFilmGrain"), intensity(0.05f), grainSize(1.5f) {
     // Add parameters for GUI control
-    addParameter(ShaderParameter::Float("Intensity", "grainIntensity", intensity, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("Grain Size", "grainSize", grainSize, 1.0f, 4.0f));
+    intensityUniform = addParameter(ShaderParameter::Float("Intensity", "grainIntensity", intensity, 0.0f, 1.0f));
+    grainSizeUniform = addParameter(ShaderParameter::Float("Grain Size", "grainSize", grainSize, 1.0f, 4.0f));
 
     // Setup ofParameter integration
     parameterGroup.setName("Film Grain");
@@ -46,8 +46,8 @@ void FilmGrainEffect::setGrainSize(float value) {
 }
 
 void FilmGrainEffect::configureShaderUniforms(ofShader & shader, const glm::vec2 & resolution) {
-    shader.setUniform1f("grainIntensity", intensity);
-    shader.setUniform1f("grainSize", grainSize);
+    setUniform1f(intensityUniform, intensity);
+    setUniform1f(grainSizeUniform, grainSize);
 }
 
 void FilmGrainEffect::onEnableChanged(bool & value) { setEnabled(value); }
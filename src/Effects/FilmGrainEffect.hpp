@@ -24,6 +24,8 @@ class FilmGrainEffect : public ShaderEffect {
     // GUI integration
     ofParameterGroup & getParameterGroup() { return parameterGroup; }
 
+    [[nodiscard]] std::string getFusedStage() const override { return "filmGrain"; }
+
    protected:
     void configureShaderUniforms(ofShader & shader, const glm::vec2 & resolution) override;
 
@@ -31,6 +33,10 @@ class FilmGrainEffect : public ShaderEffect {
     float intensity;  // 0.0 - 1.0
     float grainSize;  // 1.0 - 4.0
 
+    // Declared uniforms, set each frame
+    size_t intensityUniform;
+    size_t grainSizeUniform;
+
     // ofParameter integration for GUI
     ofParameterGroup parameterGroup;
     ofParameter<bool> enableParam;
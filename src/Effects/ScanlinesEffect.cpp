@@ -13,11 +13,12 @@ ScanlinesEffect::ScanlinesEffect()
       vignette(0.3f),
       rgbShift(0.5f) {
     // Add parameters for GUI control
-    addParameter(ShaderParameter::Float("Intensity", "scanlineIntensity", intensity, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("Line Count", "scanlineCount", scanlineCount, 50.0f, 500.0f));
-    addParameter(ShaderParameter::Float("Speed", "scanlineSpeed", speed, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("Vignette", "vignette", vignette, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("RGB Shift", "rgbShift", rgbShift, 0.0f, 5.0f));
+    intensityUniform = addParameter(ShaderParameter::Float("Intensity", "scanlineIntensity", intensity, 0.0f, 1.0f));
+    scanlineCountUniform =
+        addParameter(ShaderParameter::Float("Line Count", "scanlineCount", scanlineCount, 50.0f, 500.0f));
+    speedUniform = addParameter(ShaderParameter::Float("Speed", "scanlineSpeed", speed, 0.0f, 1.0f));
+    vignetteUniform = addParameter(ShaderParameter::Float("Vignette", "vignette", vignette, 0.0f, 1.0f));
+    rgbShiftUniform = addParameter(ShaderParameter::Float("RGB Shift", "rgbShift", rgbShift, 0.0f, 5.0f));
 
     // Setup ofParameter integration
     parameterGroup.setName("Scanlines");
@@ -88,11 +89,11 @@ void ScanlinesEffect::setRGBShift(float value) {
 }
 
 void ScanlinesEffect::configureShaderUniforms(ofShader & shader, const glm::vec2 & resolution) {
-    shader.setUniform1f("scanlineIntensity", intensity);
-    shader.setUniform1f("scanlineCount", scanlineCount);
-    shader.setUniform1f("scanlineSpeed", speed);
-    shader.setUniform1f("vignette", vignette);
-    shader.setUniform1f("rgbShift", rgbShift);
+    setUniform1f(intensityUniform, intensity);
+    setUniform1f(scanlineCountUniform, scanlineCount);
+    setUniform1f(speedUniform, speed);
+    setUniform1f(vignetteUniform, vignette);
+    setUniform1f(rgbShiftUniform, rgbShift);
 }
 
 void ScanlinesEffect::onEnableChanged(bool & value) { setEnabled(value); }
@@ -30,6 +30,9 @@ class ScanlinesEffect : public ShaderEffect {
     // GUI integration
     ofParameterGroup & getParameterGroup() { return parameterGroup; }
 
+    // RGB shift samples neighbouring pixels, so only the unshifted form fuses
+    [[nodiscard]] std::string getFusedStage() const override { return rgbShift > 0.0f ? "" : "scanlines"; }
+
    protected:
     void configureShaderUniforms(ofShader & shader, const glm::vec2 & resolution) override;
 
@@ -40,6 +43,13 @@ class ScanlinesEffect : public ShaderEffect {
     float vignette;       // Edge darkening
     float rgbShift;       // Chromatic aberration
 
+    // Declared uniforms, set each frame
+    size_t intensityUniform;
+    size_t scanlineCountUniform;
+    size_t speedUniform;
+    size_t vignetteUniform;
+    size_t rgbShiftUniform;
+
     // ofParameter integration for GUI
     ofParameterGroup parameterGroup;
     ofParameter<bool> enableParam;
@@ -13,11 +13,13 @@ VHSGlitchEffect::VHSGlitchEffect()
       signalNoise(0.3f),
       trackingError(0.2f) {
     // Add parameters for GUI control
-    addParameter(ShaderParameter::Float("Intensity", "intensity", intensity, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("Line Displacement", "lineDisplacement", lineDisplacement, 0.0f, 100.0f));
-    addParameter(ShaderParameter::Float("Color Bleed", "colorBleed", colorBleed, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("Signal Noise", "signalNoise", signalNoise, 0.0f, 1.0f));
-    addParameter(ShaderParameter::Float("Tracking Error", "trackingError", trackingError, 0.0f, 1.0f));
+    intensityUniform = addParameter(ShaderParameter::Float("Intensity", "intensity", intensity, 0.0f, 1.0f));
+    lineDisplacementUniform =
+        addParameter(ShaderParameter::Float("Line Displacement", "lineDisplacement", lineDisplacement, 0.0f, 100.0f));
+    colorBleedUniform = addParameter(ShaderParameter::Float("Color Bleed", "colorBleed", colorBleed, 0.0f, 1.0f));
+    signalNoiseUniform = addParameter(ShaderParameter::Float("Signal Noise", "signalNoise", signalNoise, 0.0f, 1.0f));
+    trackingErrorUniform =
+        addParameter(ShaderParameter::Float("Tracking Error", "trackingError", trackingError, 0.0f, 1.0f));
 
     // Setup ofParameter integration
     parameterGroup.setName("VHS Glitch");
@@ -88,11 +90,11 @@ void VHSGlitchEffect::setTrackingError(float value) {
 }
 
 void VHSGlitchEffect::configureShaderUniforms(ofShader & shader, const glm::vec2 & resolution) {
-    shader.setUniform1f("intensity", intensity);
-    shader.setUniform1f("lineDisplacement", lineDisplacement);
-    shader.setUniform1f("colorBleed", colorBleed);
-    shader.setUniform1f("signalNoise", signalNoise);
-    shader.setUniform1f("trackingError", trackingError);
+    setUniform1f(intensityUniform, intensity);
+    setUniform1f(lineDisplacementUniform, lineDisplacement);
+    setUniform1f(colorBleedUniform, colorBleed);
+    setUniform1f(signalNoiseUniform, signalNoise);
+    setUniform1f(trackingErrorUniform, trackingError);
 }
 
 void VHSGlitchEffect::onEnableChanged(bool & value) { setEnabled(value); }
@@ -40,6 +40,13 @@ class VHSGlitchEffect : public ShaderEffect {
     float signalNoise;        // 0.0 - 1.0
     float trackingError;      // 0.0 - 1.0
 
+    // Declared uniforms, set each frame
+    size_t intensityUniform;
+    size_t lineDisplacementUniform;
+    size_t colorBleedUniform;
+    size_t signalNoiseUniform;
+    size_t trackingErrorUniform;
+
     // ofParameter integration for GUI
     ofParameterGroup parameterGroup;
     ofParameter<bool> enableParam;
@@ -9,10 +9,11 @@
 
 #include <math.h>
 
-Field::Field(const std::string & name) : VisualForm(name) {
+Field::Field(const std::string & name) : VisualForm(name), populationKnob(quality.addKnob("population", 0.25)) {
     width = 32;
     height = 160;
     depth = std::min(width, height);
+    flock.threads = stoi(getEnv("FLOCK_THREADS", "0"));
 }
 
 void Field::spriteColorChanged(ofColor & c) {
@@ -44,7 +45,7 @@ void Field::spriteVariationChanged(float & v) {
 void Field::setup() {
     parameters.add(drawStyle.set("drawStyle", 0, 0, 2));
 
-    int maxPopulation = 512;
+    int maxPopulation = 4096;
 
     parameters.add(population.set("population", 256, 10, maxPopulation));
     parameters.add(fastForward.set("fastForward", 1.0, 0.1, 4.0));
@@ -164,8 +165,8 @@ void Field::draw(KeyState & ks, ColorProvider & clr, DrawManager & dm) {
         return;
     }
 
-    float computedDampenRadius = NAN;
     float scale = std::min(ofGetWidth() / width, ofGetHeight() / height);
+    glowSprites.clear();
     for (auto it = flock.l.begin(); it != flock.l.end(); ++it) {
         float colinearityWithOpticalAxis = abs(glm::dot(glm::normalize(it->velocity), glm::vec3(0, 0, 1)));
         // float colinearityWithXAxis = abs(glm::dot(glm::normalize(it->velocity), glm::vec3(1,0,0)));
@@ -173,20 +174,9 @@ void Field::draw(KeyState & ks, ColorProvider & clr, DrawManager & dm) {
 
         switch (drawStyle) {
             case 1:
-                // TODO Get
-                // drawWave(it->position.x, 0, it->size, 1.0, it->color);
-                // dm.shadeGlowCircle resets the translation/rotation to origin because of fbo swap.
-                //
-                ofPushMatrix();
-                ofTranslate(0.5 * ofGetWidth() - 0.5 * width, 0.5 * ofGetHeight() - 0.5 * height, 0);
-                ofScale(scale);
-                // colinearityWithOpticalAxis = abs(it->velocity.getNormalized().dot(ofVec3f(0,0,1)));
-                computedDampenRadius = getGlowDampenRatio(glowIntensity, intensityAtEighthWidth,
-                                                          std::min(ofGetWidth(), ofGetHeight()) / 8.0);
-                dm.shadeGlowCircle(it->position, it->size * (1 - colinearityWithOpticalAxis), it->color, glowIntensity,
-                                   computedDampenRadius, blendMode, toneMap);
-                ofPopMatrix();
-
+                // Collected here, drawn below in a single batch
+                glowSprites.push_back(
+                    {it->position, it->size * (1 - colinearityWithOpticalAxis), ofFloatColor(it->color)});
                 break;
             default:
                 ofPushMatrix();
@@ -199,8 +189,16 @@ void Field::draw(KeyState & ks, ColorProvider & clr, DrawManager & dm) {
                 break;
         }
     }
-    dm.shadeBlurX(2 * scale, INVERSE_OF_GAUSSIAN_CENTER_PIXEL);
-    dm.shadeBlurY(2 * scale, INVERSE_OF_GAUSSIAN_CENTER_PIXEL);
+    if (!glowSprites.empty()) {
+        ofPushMatrix();
+        ofTranslate(0.5 * ofGetWidth() - 0.5 * width, 0.5 * ofGetHeight() - 0.5 * height, 0);
+        ofScale(scale);
+        float computedDampenRadius =
+            getGlowDampenRatio(glowIntensity, intensityAtEighthWidth, std::min(ofGetWidth(), ofGetHeight()) / 8.0);
+        dm.drawGlowSprites(glowSprites, glowIntensity, computedDampenRadius, blendMode, toneMap);
+        ofPopMatrix();
+    }
+    dm.shadeBlur(2 * scale, INVERSE_OF_GAUSSIAN_CENTER_PIXEL);
 
     ofPopMatrix();
     ofPopStyle();
@@ -222,7 +220,8 @@ void Field::seedSingleSprite(float salt) {
 }
 
 void Field::adjustFlockPopulation() {
-    int numToCreate = population - static_cast<int>(flock.l.size());
+    int target = std::max(1, static_cast<int>(std::round(population * quality.scale(populationKnob))));
+    int numToCreate = target - static_cast<int>(flock.l.size());
     if (numToCreate < 0) {
         for (int i = -numToCreate; i > 0; i--) {
             flock.l.pop_back();
@@ -85,6 +85,10 @@ class Field : public VisualForm {
 
    protected:
     void translateField() const;
+
+    size_t populationKnob;
+    // Reused every frame by drawStyle 1
+    std::vector<DrawManager::GlowSprite> glowSprites;
 };
 
 #endif /* Field_hpp */
@@ -9,78 +9,116 @@
 
 #include <math.h>
 
-Flock::Flock() {}
+#include <algorithm>
+
+// Below this the threads cost more to wake than the steering work they'd share.
+#define FLOCK_PARALLEL_MIN_BOIDS 256
+#define FLOCK_PARALLEL_GRAIN 64
+
+Flock::Flock() : threads(0) {}
 
 void Flock::update(float dt, float elapsedTimeF) {
     float granularity = 60.0;
     float stepScale = granularity * dt * fastForward;  // This normalizes calculations at 60Hz, balancing them for FFW.
 
-    const float squareVisualRange = pow(visualRange, 2);
-    const float squareMinDistance = pow(minDistance, 2);
-
-    for (auto it = l.begin(); it != l.end(); ++it) {
-        glm::vec3 withinRangeCentroid = glm::vec3(0.0, 0.0, 0.0);
-        glm::vec3 withinRangeAverageVelocity = glm::vec3(0.0, 0.0, 0.0);
-        int numWithinRange = 0;
-
-        for (auto other = l.begin(); other != l.end(); ++other) {
-            if (it == other) {
-                continue;
-            }
-            glm::vec3 diff = other->position - it->position;
-            float squareDistance = glm::dot(diff, diff);
-            if (squareDistance <= squareVisualRange) {
-                withinRangeCentroid += other->position;
-                withinRangeAverageVelocity += other->velocity;
-                ++numWithinRange;
-            }
-            if (squareDistance <= squareMinDistance) {
-                glm::vec3 vectorToOther = other->position - it->position;
-                it->velocity += avoidFactor * stepScale * (-vectorToOther);
-            }
-        }
-
-        if (numWithinRange) {
-            // Alignment
-            withinRangeAverageVelocity /= numWithinRange;
-            it->velocity += withinRangeAverageVelocity * alignmentFactor * stepScale;
+    size_t n = l.size();
+    previousPositions.resize(n);
+    previousVelocities.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        previousPositions[i] = l[i].position;
+        previousVelocities[i] = l[i].velocity;
+    }
+    grid.build(previousPositions, std::max(visualRange, minDistance));
 
-            // Centering
-            withinRangeCentroid /= static_cast<float>(numWithinRange);
-            glm::vec3 vectorToCentroid = withinRangeCentroid - it->position;
-            it->velocity += vectorToCentroid * centeringFactor * stepScale;
+    // Each index reads only the snapshot and writes only its own boid, so chunks can run on any thread.
+    auto updateRange = [this, dt, stepScale](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            l[i].velocity = steer(static_cast<uint32_t>(i), stepScale);
+            l[i].update(dt * fastForward);
         }
+    };
 
-        //
-        if (it->position.x < xMin + margin) {
-            it->velocity += glm::vec3(turnFactor * stepScale, 0.0, 0.0);
-        } else if (it->position.x > xMax - margin) {
-            it->velocity -= glm::vec3(turnFactor * stepScale, 0.0, 0.0);
+#ifndef __EMSCRIPTEN__
+    size_t threadCount = threads > 0 ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+    if (n >= FLOCK_PARALLEL_MIN_BOIDS && threadCount > 1) {
+        if (!workers || workers->getThreadCount() != threadCount) {
+            workers = std::make_unique<WorkerPool>(threadCount);
         }
+        workers->parallelFor(n, FLOCK_PARALLEL_GRAIN, updateRange);
+        return;
+    }
+#endif
+    updateRange(0, n);
+}
 
-        if (it->position.y < yMin + margin) {
-            it->velocity += glm::vec3(0.0, turnFactor * stepScale, 0.0);
-        } else if (it->position.y > yMax - margin) {
-            it->velocity -= glm::vec3(0.0, turnFactor * stepScale, 0.0);
-        }
+glm::vec3 Flock::steer(uint32_t self, float stepScale) const {
+    const float squareVisualRange = visualRange * visualRange;
+    const float squareMinDistance = minDistance * minDistance;
+    const glm::vec3 position = previousPositions[self];
+    glm::vec3 velocity = previousVelocities[self];
 
-        if (it->position.z < zMin + margin) {
-            it->velocity += glm::vec3(0.0, 0.0, turnFactor * stepScale);
-        } else if (it->position.z > zMax - margin) {
-            it->velocity -= glm::vec3(0.0, 0.0, turnFactor * stepScale);
+    glm::vec3 withinRangeCentroid = glm::vec3(0.0, 0.0, 0.0);
+    glm::vec3 withinRangeAverageVelocity = glm::vec3(0.0, 0.0, 0.0);
+    glm::vec3 separation = glm::vec3(0.0, 0.0, 0.0);
+    int numWithinRange = 0;
+
+    grid.forEachCandidate(position, [&](uint32_t other) {
+        if (other == self) {
+            return;
+        }
+        glm::vec3 diff = previousPositions[other] - position;
+        float squareDistance = glm::dot(diff, diff);
+        if (squareDistance <= squareVisualRange) {
+            withinRangeCentroid += previousPositions[other];
+            withinRangeAverageVelocity += previousVelocities[other];
+            ++numWithinRange;
         }
+        if (squareDistance <= squareMinDistance) {
+            separation -= diff;
+        }
+    });
+    velocity += avoidFactor * stepScale * separation;
+
+    if (numWithinRange) {
+        // Alignment
+        withinRangeAverageVelocity /= numWithinRange;
+        velocity += withinRangeAverageVelocity * alignmentFactor * stepScale;
+
+        // Centering
+        withinRangeCentroid /= static_cast<float>(numWithinRange);
+        glm::vec3 vectorToCentroid = withinRangeCentroid - position;
+        velocity += vectorToCentroid * centeringFactor * stepScale;
+    }
 
-        // it->velocity += steer;
+    //
+    if (position.x < xMin + margin) {
+        velocity += glm::vec3(turnFactor * stepScale, 0.0, 0.0);
+    } else if (position.x > xMax - margin) {
+        velocity -= glm::vec3(turnFactor * stepScale, 0.0, 0.0);
+    }
 
-        float v = glm::length(it->velocity);
+    if (position.y < yMin + margin) {
+        velocity += glm::vec3(0.0, turnFactor * stepScale, 0.0);
+    } else if (position.y > yMax - margin) {
+        velocity -= glm::vec3(0.0, turnFactor * stepScale, 0.0);
+    }
 
-        if (v > maxVelocity) {
-            // Strive for target velocity
-            it->velocity *= maxVelocity / v;
-        } else if (v < minVelocity) {
-            it->velocity *= minVelocity / v;
-        }
+    if (position.z < zMin + margin) {
+        velocity += glm::vec3(0.0, 0.0, turnFactor * stepScale);
+    } else if (position.z > zMax - margin) {
+        velocity -= glm::vec3(0.0, 0.0, turnFactor * stepScale);
+    }
+
+    // it->velocity += steer;
 
-        it->update(dt * fastForward);
+    float v = glm::length(velocity);
+
+    if (v > maxVelocity) {
+        // Strive for target velocity
+        velocity *= maxVelocity / v;
+    } else if (v < minVelocity) {
+        velocity *= minVelocity / v;
     }
+
+    return velocity;
 }
@@ -9,20 +9,30 @@
 #define Flock_hpp
 
 #include <glm/glm.hpp>
+#include <memory>
 
 #include "SizedSprite.hpp"
+#include "SpatialGrid.hpp"
 #include "Utilities.hpp"
+#include "WorkerPool.hpp"
 #include "ofMain.h"
 
 class Flock {
    public:
     Flock();
     ~Flock() = default;
+    Flock(Flock &&) = default;
+    Flock & operator=(Flock &&) = default;
 
+    // Every boid steers from the state all boids had at the start of the call, so the result does not depend
+    // on iteration order or thread count.
     void update(float dt, float elapsedTimeF);
 
     std::vector<SizedSprite> l;
 
+    // Threads used for large flocks, including the caller. 0 = one per hardware thread.
+    unsigned int threads;
+
     float fastForward;
     float visualRange;
     float minDistance;
@@ -39,6 +49,17 @@ class Flock {
     float yMax;
     float zMin;
     float zMax;
+
+   private:
+    [[nodiscard]] glm::vec3 steer(uint32_t self, float stepScale) const;
+
+    // Start-of-update snapshot that steer() reads from. Boids in l are only written.
+    std::vector<glm::vec3> previousPositions;
+    std::vector<glm::vec3> previousVelocities;
+    // Rebuilt every update so neighbour queries only touch adjacent cells instead of the whole flock.
+    SpatialGrid grid;
+    // Created on the first update big enough to be worth splitting.
+    std::unique_ptr<WorkerPool> workers;
 };
 
 #endif /* Flock_hpp */
@@ -27,9 +27,6 @@ ImageSprocket::ImageSprocket() : VisualForm("ImageSprocket") {
 void ImageSprocket::setup() {
     shaderRGBMixer = createShader("shaderRGBMixer");
 
-    ofFbo rgbMixFbo = getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight());
-    ofFbo drawFbo = getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight());
-
     parameters.add(maxPhotos.set("maxPhotos", 2, 0, 100));
     parameters.add(index0.set("index0", 0, 0, static_cast<int>(images.size())));
     parameters.add(index1.set("index1", 0, 0, static_cast<int>(images.size())));
@@ -62,9 +59,6 @@ void ImageSprocket::setup() {
     scaleBackground.addListener(this, &ImageSprocket::scaleBackgroundChanged);
 
     loadPhotos(maxPhotos.get());
-
-    rgbMixFbo = getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight());
-    drawFbo = getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight());
 }
 
 void ImageSprocket::offsetXForegroundChanged(float & offsetX) { images[index0].offset[0] = offsetX; }
@@ -112,14 +106,14 @@ void ImageSprocket::draw(KeyState & ks, ColorProvider & clr, DrawManager & dm) {
     // Instead, splash with white by a certain amount to wash out the the photo before blending.
     //    ofBackground(255,255,255);
     ofSetColor(ofColor::white);
-    drawCenteredAndScaled(images[index0], fillScreen,
+    drawCenteredAndScaled(dm, images[index0], fillScreen,
                           ofVec4f(rgbMixBackgroundRed, rgbMixBackgroundGreen, rgbMixBackgroundBlue, 1.0),
                           backgroundAlphaBlendPct);
 
     ofPushStyle();
     {
         ofEnableBlendMode(OF_BLENDMODE_SCREEN);
-        drawCenteredAndScaled(images[index1], fillScreen,
+        drawCenteredAndScaled(dm, images[index1], fillScreen,
                               ofVec4f(rgbMixForegroundRed, rgbMixForegroundGreen, rgbMixForegroundBlue, 1.0),
                               foregroundAlphaBlendPct);
     }
@@ -171,8 +165,8 @@ void ImageSprocket::newPressHandler(ColorProvider & clr, Press & p) {
     updateUi();
 }
 
-void ImageSprocket::drawCenteredAndScaled(ImageWrapper & imageWrapper, bool fillScreen, ofVec4f mixFactors,
-                                          float alphaPct) {
+void ImageSprocket::drawCenteredAndScaled(DrawManager & dm, ImageWrapper & imageWrapper, bool fillScreen,
+                                          ofVec4f mixFactors, float alphaPct) {
     ofImage image = imageWrapper.image;
 
     float horizontalScaleToFit = static_cast<float>(ofGetWidth()) / image.getWidth();
@@ -196,32 +190,39 @@ void ImageSprocket::drawCenteredAndScaled(ImageWrapper & imageWrapper, bool fill
     int topLeftX = ofGetWidth() / 2.0 - drawWidth / 2.0;
     int topLeftY = ofGetHeight() / 2.0 - drawHeight / 2.0;
 
-    drawFbo = getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight());
-    rgbMixFbo = getConfiguredFrameBuffer(ofGetWidth(), ofGetHeight());
-
-    rgbMixFbo.begin();
-    ofClear(0);
-    image.draw(topLeftX + imageWrapper.offset.x, topLeftY + imageWrapper.offset.y, drawWidth * imageWrapper.scale,
-               drawHeight * imageWrapper.scale);
-
-    // Because we use screen blend for double expose, blacken photos by a factor of 1-alphaPct
-    ofPushStyle();
-    {
-        ofSetColor(0, 0, 0, ofMap(1.0 - alphaPct, 0, 1, 0, 255));
-        ofDrawRectangle(0, 0, rgbMixFbo.getWidth(), rgbMixFbo.getHeight());
-    }
-    ofPopStyle();
+    // The mix target is pooled scratch. The shaded result goes straight onto the canvas: drawing it through an
+    // intermediate FBO with blending disabled gave the same pixels for an extra full-screen copy.
+    RenderGraph & graph = *dm.graph;
+    RenderTargetDesc desc = {static_cast<int>(ofGetWidth()), static_cast<int>(ofGetHeight()), GL_RGBA, false};
+    RenderGraph::ResourceId rgbMix = graph.createTarget("rgbMix", desc);
+    RenderGraph::ResourceId canvas = graph.importTarget("canvas", *dm.activeCanvas);
+
+    graph.addPass("image", {}, rgbMix, [&](const std::vector<ofFbo *> & inputs, ofFbo & output) {
+        output.begin();
+        ofClear(0);
+        image.draw(topLeftX + imageWrapper.offset.x, topLeftY + imageWrapper.offset.y, drawWidth * imageWrapper.scale,
+                   drawHeight * imageWrapper.scale);
+
+        // Because we use screen blend for double expose, blacken photos by a factor of 1-alphaPct
+        ofPushStyle();
+        {
+            ofSetColor(0, 0, 0, ofMap(1.0 - alphaPct, 0, 1, 0, 255));
+            ofDrawRectangle(0, 0, output.getWidth(), output.getHeight());
+        }
+        ofPopStyle();
 
-    rgbMixFbo.end();
+        output.end();
+    });
 
     std::function<void(ofShader &)> configureShader = [mixFactors](ofShader & shader) {
         shader.setUniform4f("mixFactors", mixFactors);
     };
 
-    drawFbo.begin();
-    applyShaderToCurrentFbo(rgbMixFbo, shaderRGBMixer, configureShader);
-    drawFbo.end();
-    drawFboAtZeroZero(drawFbo);
+    // The canvas is already bound
+    graph.addPass("shaderRGBMixer", {rgbMix}, canvas, [&](const std::vector<ofFbo *> & inputs, ofFbo & output) {
+        applyShaderToCurrentFbo(*inputs[0], shaderRGBMixer, configureShader);
+    });
+    graph.execute();
 }
 namespace ImageUtilities {
 
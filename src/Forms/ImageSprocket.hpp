@@ -33,7 +33,7 @@ class ImageSprocket : public VisualForm {
     void updateUi();
     void loadPhotos(int count);
 
-    void drawCenteredAndScaled(ImageWrapper & imageWrapper, bool fillScreen,
+    void drawCenteredAndScaled(DrawManager & dm, ImageWrapper & imageWrapper, bool fillScreen,
                                ofVec4f mixFactors = ofVec4f(1.0, 1.0, 1.0, 1.0), float alphaPct = 1.0);
 
     void maxPhotosChanged(int & count);
@@ -48,9 +48,6 @@ class ImageSprocket : public VisualForm {
 
     ofShader shaderRGBMixer;
 
-    ofFbo rgbMixFbo;
-    ofFbo drawFbo;
-
     ofParameter<int> maxPhotos;
     ofParameter<int> index0;
     ofParameter<int> index1;
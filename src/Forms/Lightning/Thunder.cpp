@@ -13,7 +13,8 @@
 #define MAX_BRANCHES_PER_UNIT_LENGTH 1.0 / 32.0
 #define THUNDER_DECAY_TIME_S 0.25
 
-Thunder::Thunder(const std::string & name) : VisualForm(name) {
+Thunder::Thunder(const std::string & name)
+    : VisualForm(name), recursionDepthKnob(quality.addKnob("recursionDepth", 0.6)) {
     int maxSide = std::max(ofGetWidth(), ofGetHeight());
     int defaultRecursionDepth = int(floor(std::log2(maxSide)));
     parameters.add(recursionDepth.set("recursionDepth", defaultRecursionDepth, 0, defaultRecursionDepth * 1.5));
@@ -61,10 +62,8 @@ void Thunder::draw(KeyState & ks, ColorProvider & clr, DrawManager & dm) {
         lightningBolt.draw(color);
     };
     ofPopStyle();
-    dm.shadeBlurX(3.5 * ks.valenceGain(),
-                  INVERSE_OF_GAUSSIAN_CENTER_PIXEL);  // Blurrier at low arousal, sharper at high
-    dm.shadeBlurY(3.5 * ks.valenceGain(),
-                  INVERSE_OF_GAUSSIAN_CENTER_PIXEL);  // Blurrier at low arousal, sharper at high
+    dm.shadeBlur(3.5 * ks.valenceGain(),
+                 INVERSE_OF_GAUSSIAN_CENTER_PIXEL);  // Blurrier at low arousal, sharper at high
 }
 
 LightningBolt Thunder::createBolt(const Press & p, float arousalGain, unsigned int seed) {
@@ -72,8 +71,10 @@ LightningBolt Thunder::createBolt(const Press & p, float arousalGain, unsigned i
     ofVec3f from = lineSegment.first;
     ofVec3f to = lineSegment.second;
 
+    // Only newly created bolts pick up a reduced depth; cached bolts keep the detail they were built with.
+    int depth = static_cast<int>(std::round(recursionDepth * quality.scale(recursionDepthKnob)));
     LightningBolt computedBolt =
-        LightningBolt(from, to, recursionDepth, jitterUnit * arousalGain, branchingFactor, seed % THUNDER_SEED_PRIME);
+        LightningBolt(from, to, depth, jitterUnit * arousalGain, branchingFactor, seed % THUNDER_SEED_PRIME);
     return computedBolt;
 }
 
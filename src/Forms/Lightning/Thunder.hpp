@@ -30,6 +30,8 @@ class Thunder : public VisualForm {
     ofParameter<float> jitterUnit;
     ofParameter<bool> lineSegmentDeterministic;
 
+    size_t recursionDepthKnob;
+
    public:
     explicit Thunder(const std::string & name);
     ~Thunder() override;
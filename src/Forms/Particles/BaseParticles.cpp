@@ -11,8 +11,17 @@
 
 // If someone's pressing more than 4, then start relaxing the number of particles coming out
 #define CONCURRENT_PRESS_PARTICLE_BRAKE 4
-
-BaseParticles::BaseParticles(const std::string & name) : VisualForm(name) {
+// Upper bound on live particles. maxParticles only throttles emission, so leave headroom above its slider max.
+#define PARTICLE_POOL_CAPACITY 16384
+#define PRESS_PALETTE_SLOTS 512
+
+BaseParticles::BaseParticles(const std::string & name)
+    : VisualForm(name),
+      particles(PARTICLE_POOL_CAPACITY),
+      palette(PRESS_PALETTE_SLOTS),
+      particleMultiplier(stof(getEnv("PARTICLE_MULTIPLIER", "1.0"))),
+      particleRateKnob(quality.addKnob("Particle Rate", 0.25)),
+      maxParticlesKnob(quality.addKnob("Max Particles", 0.25)) {
     canvas.allocate(ofGetWidth(), ofGetHeight(), OF_IMAGE_COLOR_ALPHA);
 
     parameters.add(particleRate.set("Particle Rate", 1000, 10, 8000));
@@ -32,31 +41,32 @@ BaseParticles::BaseParticles(const std::string & name) : VisualForm(name) {
 void BaseParticles::update(KeyState & ks, ColorProvider & clr) {
     float arousalPct = ks.arousalPct();
     float timeS = ofGetElapsedTimef();
-    float particleMultiplier = stof(getEnv("PARTICLE_MULTIPLIER", "1.0"));
+    float rate = particleRate * quality.scale(particleRateKnob);
+    float particleLimit = maxParticles * quality.scale(maxParticlesKnob);
+    // KeyState's presses are visited in place; copying them out each frame allocated a list node per press
     int generatingPressCount = 0;
-    for (auto press : ks.activePresses()) {
+    ks.forEachActivePress([&](const Press & press) {
         if (ofIsFloatEqual(
                 press.audibleAmplitudePct(ks.attackTimeS, ks.decayTimeS, ks.sustainLevelPct, ks.releaseTimeS), 0.0)) {
             generatingPressCount++;
         }
-    }
+    });
 
-    for (auto press : ks.activePresses()) {
+    ks.forEachActivePress([&](const Press & press) {
         double audibleAmplitude =
             press.audibleAmplitudePct(ks.attackTimeS, ks.decayTimeS, ks.sustainLevelPct, ks.releaseTimeS);
         // Use squareRoot so we favor new presses over decaying ones. Particles should fall off more rapidly than, say,
         // shapes.
         double squareRootOfAudibleAmplitude = exponentialMap(audibleAmplitude, 0, 1, 0, 1, true, 0.5);
         int numberOfParticlesToCreate =
-            particleRate * ofGetLastFrameTime() * squareRootOfAudibleAmplitude * particleMultiplier +
+            rate * ofGetLastFrameTime() * squareRootOfAudibleAmplitude * particleMultiplier +
             ofRandom(-0.5, 0.5);
         if (generatingPressCount > CONCURRENT_PRESS_PARTICLE_BRAKE) {
             numberOfParticlesToCreate = numberOfParticlesToCreate *
                                         (CONCURRENT_PRESS_PARTICLE_BRAKE / generatingPressCount) * particleMultiplier;
         }
-        if (particles.size() > maxParticles) {
-            numberOfParticlesToCreate =
-                numberOfParticlesToCreate / (particles.size() / static_cast<float>(maxParticles));
+        if (particles.size() > particleLimit) {
+            numberOfParticlesToCreate = numberOfParticlesToCreate / (particles.size() / particleLimit);
         }
         // ofColor color = clr.color(press);
         ofColor color = ofColor(255, 255, 255);
@@ -65,33 +75,31 @@ void BaseParticles::update(KeyState & ks, ColorProvider & clr) {
         float value;
         color.getHsb(hue, saturation, value);
         createParticlesForPress(press, numberOfParticlesToCreate, color, arousalPct);
-    }
-    for (auto press : ks.allEphemeralPresses()) {
+    });
+    ks.forEachEphemeralPress([&](const Press & press) {
         int numberOfParticlesToCreate =
-            particleRate * ofGetLastFrameTime() * pow(press.velocityPct, 0.2) * particleMultiplier +
-            ofRandom(-0.5, 0.5);
-        if (particles.size() > maxParticles) {
-            numberOfParticlesToCreate =
-                numberOfParticlesToCreate / (particles.size() / static_cast<float>(maxParticles));
+            rate * ofGetLastFrameTime() * pow(press.velocityPct, 0.2) * particleMultiplier + ofRandom(-0.5, 0.5);
+        if (particles.size() > particleLimit) {
+            numberOfParticlesToCreate = numberOfParticlesToCreate / (particles.size() / particleLimit);
         }
         createParticlesForPress(press, numberOfParticlesToCreate, clr.color(press, 1.0), arousalPct);
-    }
+    });
     pruneParticles();
 
-    for (auto it = particles.begin(); it != particles.end(); ++it) {
+    for (auto & pp : particles) {
         ofVec3f noiseGradientAtCoordinate = noiseGradientForCoordinates(
-            it->second.position.x, it->second.position.y, noiseSpatialFrequency * (1 - ks.arousalGain()),
+            pp.particle.position.x, pp.particle.position.y, noiseSpatialFrequency * (1 - ks.arousalGain()),
             noiseTemporalRate, noiseScale * (1 + ks.valenceGain()) / 2, timeS);
         ofVec3f acceleration =
             noiseScale > 0 ? ofVec3f(noiseGradientAtCoordinate.x, noiseGradientAtCoordinate.y, 0) : ofVec3f(0, 0, 0);
-        it->second.update(ofGetLastFrameTime(), acceleration);  // Add some noise to each frame to avoid banding
+        pp.particle.update(ofGetLastFrameTime(), acceleration);  // Add some noise to each frame to avoid banding
     }
 
+    // One palette write per press. Particles pick the color up through their slot when drawn.
     for (const auto & press : ks.allPresses()) {
-        float alpha = opacityForPress(ks, press);
-        ofColor color = clr.color(press, alpha);
-        for (auto er = particles.equal_range(press.id); er.first != er.second; er.first++) {
-            er.first->second.setColor(color);
+        uint16_t slot = palette.find(press.id);
+        if (slot != PressPalette::NO_SLOT) {
+            palette.setColor(slot, clr.color(press, opacityForPress(ks, press)));
         }
     }
     //    for (const auto & press: ks.allEphemeralPresses()) {
@@ -135,11 +143,11 @@ void BaseParticles::draw(KeyState & ks, ColorProvider & clr, DrawManager & dm) {
     // see, for example, the invocation of a t_released. This is why shapes' release ADSR worked but particles' did not.
     int w = canvas.getWidth();
     int h = canvas.getHeight();
-    for (const auto & kv : particles) {
-        int x = floor(kv.second.position.x);
-        int y = floor(kv.second.position.y);
+    for (const auto & pp : particles) {
+        int x = floor(pp.particle.position.x);
+        int y = floor(pp.particle.position.y);
         if (0 <= x && x < w && 0 <= y && y < h) {
-            canvas.getPixels().setColor(x, y, kv.second.color);  // place your pixels
+            canvas.getPixels().setColor(x, y, palette.color(pp.slot));  // place your pixels
         }
     }
 
@@ -154,21 +162,30 @@ void BaseParticles::draw(KeyState & ks, ColorProvider & clr, DrawManager & dm) {
     float blurFactorScaledByParams = ofMap(blurFactorPct, 0, 1, blurLowerLimit, blurUpperLimit);
     // Blurrier at low arousal, sharper at high
     // Gain means an isolated sprite (blackground) will be full brightness, not 0.382928 brightness
-    dm.shadeBlurX(blurFactorScaledByParams, blurGain);
-    dm.shadeBlurY(blurFactorScaledByParams, blurGain);  // Blurrier at low arousal, sharper at high
+    dm.shadeBlur(blurFactorScaledByParams, blurGain);  // Blurrier at low arousal, sharper at high
 }
 
 void BaseParticles::pruneParticles() {
-    // https://stackoverflow.com/a/800984
-
-    for (auto iter = particles.begin(); iter != particles.end();) {
-        if (iter->second.position.x > ofGetWidth() || iter->second.position.x < 0 ||
-            iter->second.position.y > ofGetHeight() || iter->second.position.y < 0 || iter->second.color.a < 0.0001) {
-            iter = particles.erase(iter);
-        } else {
-            ++iter;
-        }
+    float w = ofGetWidth();
+    float h = ofGetHeight();
+    removeParticlesIf([w, h](const PooledParticle & pp, const ofColor & c) {
+        const Particle & p = pp.particle;
+        return p.position.x > w || p.position.x < 0 || p.position.y > h || p.position.y < 0 || c.a < 0.0001;
+    });
+}
+
+ParticleBatch BaseParticles::emitParticles(const Press & press, int n, const ofColor & c) {
+    if (n <= 0) {
+        return ParticleBatch{nullptr, 0};
+    }
+    uint16_t slot = palette.acquire(press.id, n);
+    if (slot == PressPalette::NO_SLOT) {
+        return ParticleBatch{nullptr, 0};
     }
+    palette.setColor(slot, c);
+    ParticleBatch batch = particles.emit(slot, n);
+    palette.release(slot, n - batch.size());  // Pool was full; give back references for particles not emitted.
+    return batch;
 }
 
 ofVec3f BaseParticles::startPositionForPress(const Press & p) {
@@ -11,7 +11,9 @@
 #include "ColorProvider.hpp"
 #include "KeyState.hpp"
 #include "Particle.h"
+#include "ParticlePool.hpp"
 #include "Press.hpp"
+#include "PressPalette.hpp"
 #include "Utilities.hpp"
 #include "VisualForm.hpp"
 
@@ -42,11 +44,32 @@ class BaseParticles : public VisualForm {
     // WARNING: Do not treat particles' keys as up to date. They're saved at the moment they're inserted, so they never
     // see, for example, the invocation of a t_released. This is why shapes' release ADSR worked but particles' did not.
     // New: Use press id.
-    std::unordered_multimap<unsigned int, Particle> particles{};
+    ParticlePool particles;
+    // Per-press colors, indexed by PooledParticle::slot and resolved at draw time.
+    PressPalette palette;
+    float particleMultiplier;
+    size_t particleRateKnob;
+    size_t maxParticlesKnob;
+
+    // Emit n particles for a press, tagging them with its palette slot and setting the slot color to c.
+    ParticleBatch emitParticles(const Press & press, int n, const ofColor & c);
+
+    // Remove particles matching pred(const PooledParticle &, const ofColor &), releasing their palette slots.
+    template <typename Predicate>
+    void removeParticlesIf(Predicate pred) {
+        particles.removeIf([this, &pred](const PooledParticle & pp) {
+            if (pred(pp, palette.color(pp.slot))) {
+                palette.release(pp.slot);
+                return true;
+            }
+            return false;
+        });
+    }
 
     void renderPixelsForPress(ColorProvider & clr, KeyState & ks, const Press & p);
 
-    virtual void createParticlesForPress(Press & press, int numberOfParticlesToCreate, ofColor c, float arousalPct) = 0;
+    virtual void createParticlesForPress(const Press & press, int numberOfParticlesToCreate, ofColor c,
+                                         float arousalPct) = 0;
     virtual ofVec3f startPositionForPress(const Press & p);
     virtual float opacityForEphemeralPress(KeyState & ks, const Press & p) const;
     virtual float opacityForPress(KeyState & ks, const Press & p) const;
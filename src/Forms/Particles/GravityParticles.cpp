@@ -48,20 +48,20 @@ static void wallBounce(Particle & particle) {
 }
 
 void GravityParticles::update(KeyState & ks, ColorProvider & clr) {
-    for (auto it = particles.begin(); it != particles.end(); ++it) {
-        it->second.updateVelocity(it->second.velocity + ofVec3f(0, baseGravity, 0) * ofGetLastFrameTime());
-        it->second.update(ofGetLastFrameTime());
+    for (auto & pp : particles) {
+        pp.particle.updateVelocity(pp.particle.velocity + ofVec3f(0, baseGravity, 0) * ofGetLastFrameTime());
+        pp.particle.update(ofGetLastFrameTime());
         // Correct for beyond borders
-        wallBounce(it->second);
+        wallBounce(pp.particle);
     }
     BaseParticles::update(ks, clr);
 }
 
-void GravityParticles::createParticlesForPress(Press & press, int numberOfParticlesToCreate, ofColor c,
+void GravityParticles::createParticlesForPress(const Press & press, int numberOfParticlesToCreate, ofColor c,
                                                float arousalPct) {
     // int xPos = ofMap(kv.second.note % NUM_NOTES, 0, NUM_NOTES, 0, ofGetWidth());
     float arousalModifier = ofMap(arousalPct, 0, 1, 0.5, 2.0);
-    for (int i = 0; i < numberOfParticlesToCreate; i++) {
+    for (auto & pp : emitParticles(press, numberOfParticlesToCreate, c)) {
         // Perturb +/- 0.5 to accommodate for the more keys than particles in a frame, situation
         float angle = ofMap(ofRandomf(), -1, 1, -angularVariance, angularVariance) +
                       PI / 2;  // + PI/2 because it's centered about PI/2 (down)
@@ -75,20 +75,13 @@ void GravityParticles::createParticlesForPress(Press & press, int numberOfPartic
         // Subtly perturb to avoid streaks
 
         float vy = sin(angle) * velocity * ofRandom(0.05, 20);
-        ofVec3f startPosition = startPositionForPress(press);
-        Particle myParticle(startPosition, ofVec3f(vx, vy, 0), c);
-        particles.emplace(press.id, myParticle);
+        pp.particle.position = startPositionForPress(press);
+        pp.particle.velocity = ofVec3f(vx, vy, 0);
     }
 }
 
 void GravityParticles::pruneParticles() {
-    // https://stackoverflow.com/a/800984
-
-    for (auto iter = particles.begin(); iter != particles.end();) {
-        if (iter->second.position.y > ofGetHeight() || iter->second.color.a < 0.0001) {
-            iter = particles.erase(iter);
-        } else {
-            ++iter;
-        }
-    }
+    float h = ofGetHeight();
+    removeParticlesIf(
+        [h](const PooledParticle & pp, const ofColor & c) { return pp.particle.position.y > h || c.a < 0.0001; });
 }
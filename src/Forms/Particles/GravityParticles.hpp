@@ -23,7 +23,8 @@ class GravityParticles : public BaseParticles {
     ofParameter<float> angularVariance;
 
    protected:
-    void createParticlesForPress(Press & press, int numberOfParticlesToCreate, ofColor c, float arousalPct) override;
+    void createParticlesForPress(const Press & press, int numberOfParticlesToCreate, ofColor c,
+                                 float arousalPct) override;
     ofVec3f startPositionForPress(const Press & p) override;
 
     void pruneParticles() override;
@@ -0,0 +1,24 @@
+//
+//  ParticlePool.cpp
+//  orgb
+//
+
+#include "ParticlePool.hpp"
+
+#include <algorithm>
+
+ParticlePool::ParticlePool(size_t capacity) : maxSize(capacity), dropped(0) { particles.reserve(capacity); }
+
+ParticleBatch ParticlePool::emit(uint16_t slot, size_t n) {
+    size_t available = maxSize - particles.size();
+    size_t count = std::min(n, available);
+    dropped += n - count;
+
+    size_t firstIndex = particles.size();
+    const Particle blank(glm::vec3(0, 0, 0), glm::vec3(0, 0, 0), ofColor(0, 0, 0, 0));
+    for (size_t i = 0; i < count; i++) {
+        // Capacity was reserved in the constructor, so this never reallocates.
+        particles.emplace_back(slot, blank);
+    }
+    return ParticleBatch{particles.data() + firstIndex, count};
+}
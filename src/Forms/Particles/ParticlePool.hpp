@@ -0,0 +1,82 @@
+//
+//  ParticlePool.hpp
+//  orgb
+//
+//  Fixed-capacity, contiguous particle storage. All memory is reserved up front so emitting and
+//  pruning particles never touches the heap once the pool is constructed.
+//
+
+#ifndef ParticlePool_hpp
+#define ParticlePool_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Particle.h"
+
+// A particle tagged with the PressPalette slot of the press that emitted it. Pooled particles take their color
+// from the palette at draw time; particle.color is unused.
+struct PooledParticle {
+    PooledParticle(uint16_t slot, const Particle & particle) : slot(slot), particle(particle) {}
+
+    uint16_t slot;
+    Particle particle;
+};
+
+// Contiguous run of freshly emitted particles, to be filled in place by the caller.
+struct ParticleBatch {
+    PooledParticle * first;
+    size_t count;
+
+    [[nodiscard]] PooledParticle * begin() const { return first; }
+    [[nodiscard]] PooledParticle * end() const { return first + count; }
+    [[nodiscard]] size_t size() const { return count; }
+};
+
+class ParticlePool {
+   public:
+    explicit ParticlePool(size_t capacity);
+    ~ParticlePool() = default;
+
+    // Append up to n particles for a palette slot and return them for in-place initialization. Positions and
+    // velocities are zeroed. If the pool is full the batch is truncated and the shortfall is added to
+    // droppedCount().
+    ParticleBatch emit(uint16_t slot, size_t n);
+
+    // Remove every particle for which pred(const PooledParticle &) returns true. Removal swaps the last
+    // particle into the vacated position, so iteration order is not preserved.
+    template <typename Predicate>
+    void removeIf(Predicate pred) {
+        size_t i = 0;
+        while (i < particles.size()) {
+            if (pred(particles[i])) {
+                if (i != particles.size() - 1) {
+                    particles[i] = particles.back();
+                }
+                particles.pop_back();
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    void clear() { particles.clear(); }
+
+    [[nodiscard]] size_t size() const { return particles.size(); }
+    [[nodiscard]] size_t capacity() const { return maxSize; }
+    [[nodiscard]] bool empty() const { return particles.empty(); }
+    [[nodiscard]] size_t droppedCount() const { return dropped; }
+
+    std::vector<PooledParticle>::iterator begin() { return particles.begin(); }
+    std::vector<PooledParticle>::iterator end() { return particles.end(); }
+    [[nodiscard]] std::vector<PooledParticle>::const_iterator begin() const { return particles.begin(); }
+    [[nodiscard]] std::vector<PooledParticle>::const_iterator end() const { return particles.end(); }
+
+   private:
+    std::vector<PooledParticle> particles;
+    size_t maxSize;
+    size_t dropped;
+};
+
+#endif /* ParticlePool_hpp */
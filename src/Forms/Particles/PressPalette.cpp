@@ -0,0 +1,133 @@
+//
+//  PressPalette.cpp
+//  orgb
+//
+
+#include "PressPalette.hpp"
+
+#include <algorithm>
+
+PressPalette::PressPalette(size_t slotCount)
+    : pressIds(std::clamp<size_t>(slotCount, 1, NO_SLOT), 0),
+      referenceCounts(pressIds.size(), 0),
+      colors(pressIds.size(), ofColor(0, 0, 0, 0)) {
+    freeSlots.reserve(pressIds.size());
+    clear();
+}
+
+uint16_t PressPalette::acquire(unsigned int pressId, size_t references) {
+    uint16_t slot = find(pressId);
+    if (slot == NO_SLOT) {
+        if (freeSlots.empty() && !grow()) {
+            return NO_SLOT;
+        }
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        pressIds[slot] = pressId;
+        index(slot);
+    }
+    referenceCounts[slot] += references;
+    return slot;
+}
+
+void PressPalette::release(uint16_t slot, size_t references) {
+    if (slot == NO_SLOT || referenceCounts[slot] == 0) {
+        return;
+    }
+    referenceCounts[slot] -= std::min(references, referenceCounts[slot]);
+    if (referenceCounts[slot] == 0) {
+        unindex(slot);
+        freeSlots.push_back(slot);
+    }
+}
+
+uint16_t PressPalette::find(unsigned int pressId) const {
+    size_t mask = buckets.size() - 1;
+    for (size_t b = bucketFor(pressId); buckets[b] != NO_SLOT; b = (b + 1) & mask) {
+        if (pressIds[buckets[b]] == pressId) {
+            return buckets[b];
+        }
+    }
+    return NO_SLOT;
+}
+
+void PressPalette::clear() {
+    std::fill(referenceCounts.begin(), referenceCounts.end(), 0);
+    freeSlots.clear();
+    // Hand out low slots first so the live part of the table stays compact.
+    for (size_t i = pressIds.size(); i > 0; i--) {
+        freeSlots.push_back(static_cast<uint16_t>(i - 1));
+    }
+    size_t bucketCount = 1;
+    while (bucketCount < 2 * pressIds.size()) {
+        bucketCount *= 2;
+    }
+    buckets.assign(bucketCount, NO_SLOT);
+}
+
+// ============================================================================
+// Growth and index
+// ============================================================================
+
+bool PressPalette::grow() {
+    size_t oldCount = pressIds.size();
+    size_t newCount = std::min<size_t>(2 * oldCount, NO_SLOT);  // NO_SLOT itself is never a slot
+    if (newCount == oldCount) {
+        ofLogWarning("PressPalette") << "All " << oldCount << " slots are in use";
+        return false;
+    }
+    pressIds.resize(newCount, 0);
+    referenceCounts.resize(newCount, 0);
+    colors.resize(newCount, ofColor(0, 0, 0, 0));
+    for (size_t i = newCount; i > oldCount; i--) {
+        freeSlots.push_back(static_cast<uint16_t>(i - 1));
+    }
+
+    size_t bucketCount = buckets.size();
+    while (bucketCount < 2 * newCount) {
+        bucketCount *= 2;
+    }
+    if (bucketCount != buckets.size()) {
+        buckets.assign(bucketCount, NO_SLOT);
+        for (size_t slot = 0; slot < oldCount; slot++) {
+            if (referenceCounts[slot] > 0) {
+                index(static_cast<uint16_t>(slot));
+            }
+        }
+    }
+    return true;
+}
+
+size_t PressPalette::bucketFor(unsigned int pressId) const {
+    // Press ids are often sequential or timestamps, so mix the high bits into the low ones the mask keeps.
+    uint32_t h = static_cast<uint32_t>(pressId) * 0x9E3779B1u;
+    h ^= h >> 16;
+    return h & (buckets.size() - 1);
+}
+
+void PressPalette::index(uint16_t slot) {
+    size_t mask = buckets.size() - 1;
+    size_t b = bucketFor(pressIds[slot]);
+    while (buckets[b] != NO_SLOT) {
+        b = (b + 1) & mask;
+    }
+    buckets[b] = slot;
+}
+
+void PressPalette::unindex(uint16_t slot) {
+    size_t mask = buckets.size() - 1;
+    size_t hole = bucketFor(pressIds[slot]);
+    while (buckets[hole] != slot) {
+        hole = (hole + 1) & mask;
+    }
+    // Backward shift: pull later entries of the probe run into the hole unless that would move them before
+    // their home bucket, so find() never needs tombstones.
+    for (size_t next = (hole + 1) & mask; buckets[next] != NO_SLOT; next = (next + 1) & mask) {
+        size_t home = bucketFor(pressIds[buckets[next]]);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            buckets[hole] = buckets[next];
+            hole = next;
+        }
+    }
+    buckets[hole] = NO_SLOT;
+}
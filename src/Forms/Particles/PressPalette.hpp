@@ -0,0 +1,60 @@
+//
+//  PressPalette.hpp
+//  orgb
+//
+//  Compact press -> RGBA table. Particles store a slot index into this table instead of their own color,
+//  so propagating a press's color each frame is one write per press rather than one per particle. The
+//  draw pass resolves the slot back to a color.
+//
+//  Presses are found through an open-addressed index of the live slots, so lookups cost the same however
+//  large the table is. When every slot is in use the table doubles, up to NO_SLOT slots; only growth
+//  allocates.
+//
+
+#ifndef PressPalette_hpp
+#define PressPalette_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ofMain.h"
+
+class PressPalette {
+   public:
+    static constexpr uint16_t NO_SLOT = 0xFFFF;
+
+    explicit PressPalette(size_t slotCount);
+    ~PressPalette() = default;
+
+    // Return the slot for pressId (allocating one if needed) and add references to it. Grows the table when
+    // every slot is in use; returns NO_SLOT only once it cannot grow further.
+    uint16_t acquire(unsigned int pressId, size_t references);
+    // Drop references from a slot. A slot with no references left is returned to the free list.
+    void release(uint16_t slot, size_t references = 1);
+    // Slot currently assigned to pressId, or NO_SLOT.
+    [[nodiscard]] uint16_t find(unsigned int pressId) const;
+
+    void setColor(uint16_t slot, const ofColor & c) { colors[slot] = c; }
+    [[nodiscard]] const ofColor & color(uint16_t slot) const { return colors[slot]; }
+
+    [[nodiscard]] size_t activeSlotCount() const { return referenceCounts.size() - freeSlots.size(); }
+    [[nodiscard]] size_t slotCount() const { return referenceCounts.size(); }
+    void clear();
+
+   private:
+    bool grow();
+    [[nodiscard]] size_t bucketFor(unsigned int pressId) const;
+    void index(uint16_t slot);
+    void unindex(uint16_t slot);
+
+    std::vector<unsigned int> pressIds;
+    std::vector<size_t> referenceCounts;
+    std::vector<ofColor> colors;
+    std::vector<uint16_t> freeSlots;
+    // Live slots by pressId, linear probing. At least twice the slot count and a power of two, so probes stay
+    // short and a bucket is masked rather than divided.
+    std::vector<uint16_t> buckets;
+};
+
+#endif /* PressPalette_hpp */
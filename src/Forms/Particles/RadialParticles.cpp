@@ -24,20 +24,21 @@ ofVec3f RadialParticles::startPositionForPress(const Press & p) {
     return ofVec3f(ofGetWidth() / 2.0, ofGetHeight() / 2.0, 0);
 }
 
-void RadialParticles::createParticlesForPress(Press & press, int numberOfParticlesToCreate, ofColor c,
+void RadialParticles::createParticlesForPress(const Press & press, int numberOfParticlesToCreate, ofColor c,
                                               float arousalPct) {
     // int xPos = ofMap(kv.second.note % NUM_NOTES, 0, NUM_NOTES, 0, ofGetWidth());
     float arousalModifier = ofMap(arousalPct, 0, 1, 0.5, 2.0);
-    for (int i = 0; i < numberOfParticlesToCreate; i++) {
+    float baseVelocity = ofMap(press.note, GUITAR_MIDI_MIN, GUITAR_MIDI_MAX, initialVelocityLowerBound,
+                               initialVelocityLowerBound * topToBottomInitialVelocityRatio, true) *
+                         arousalModifier;
+    ofVec3f startPosition = startPositionForPress(press);
+    for (auto & pp : emitParticles(press, numberOfParticlesToCreate, c)) {
         // Perturb +/- 0.5 to accommodate for the more keys than particles in a frame, situation
         // Subtly perturb to avoid streaking (ofRandom multiply)
-        float velocity = ofMap(press.note, GUITAR_MIDI_MIN, GUITAR_MIDI_MAX, initialVelocityLowerBound,
-                               initialVelocityLowerBound * topToBottomInitialVelocityRatio, true) *
-                         ofRandom(0.8, 1.2) * arousalModifier;
-        ofVec3f initialVelocity = randomUnitVector2D() * velocity;
+        float velocity = baseVelocity * ofRandom(0.8, 1.2);
         // ofVec3f scoot = (1.0 / TARGET_FRAME_RATE * ofRandom(0, 0.001)) * initialVelocity; // In order to avoid
         // banding at the start point, scoot a bit into the framerate
-        Particle myParticle(startPositionForPress(press), initialVelocity, c);
-        particles.emplace(press.id, myParticle);
+        pp.particle.position = startPosition;
+        pp.particle.velocity = randomUnitVector2D() * velocity;
     }
 }
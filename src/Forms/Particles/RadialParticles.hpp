@@ -17,7 +17,8 @@ class RadialParticles : public BaseParticles {
     ~RadialParticles() override = default;
 
    protected:
-    void createParticlesForPress(Press & press, int numberOfParticlesToCreate, ofColor c, float arousalPct) override;
+    void createParticlesForPress(const Press & press, int numberOfParticlesToCreate, ofColor c,
+                                 float arousalPct) override;
     ofVec3f startPositionForPress(const Press & p) override;
 };
 
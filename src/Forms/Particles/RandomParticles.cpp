@@ -24,11 +24,11 @@ ofVec3f RandomParticles::startPositionForPress(const Press & p) {
     return ofVec3f(xPos, yPos, 0);
 }
 
-void RandomParticles::createParticlesForPress(Press & press, int numberOfParticlesToCreate, ofColor c,
+void RandomParticles::createParticlesForPress(const Press & press, int numberOfParticlesToCreate, ofColor c,
                                               float arousalPct) {
     // int xPos = ofMap(kv.second.note % NUM_NOTES, 0, NUM_NOTES, 0, ofGetWidth());
     float arousalModifier = ofMap(arousalPct, 0, 1, 0.5, 2.0);
-    for (int i = 0; i < numberOfParticlesToCreate; i++) {
+    for (auto & pp : emitParticles(press, numberOfParticlesToCreate, c)) {
         // Perturb +/- 0.5 to accommodate for the more keys than particles in a frame, situation
         float angle = ofMap(ofRandomf(), -1, 1, 0, TWO_PI);  // + PI/2 because it's centered about PI/2 (down)
         float velocity = ofMap(press.note, GUITAR_MIDI_MIN, GUITAR_MIDI_MAX, initialVelocityLowerBound,
@@ -37,8 +37,8 @@ void RandomParticles::createParticlesForPress(Press & press, int numberOfParticl
         float vx = cos(angle) * velocity;
         float vy = sin(angle) * velocity;
 
-        Particle myParticle(startPositionForPress(press), ofVec3f(vx, vy, 0), c);
-        particles.emplace(press.id, myParticle);
+        pp.particle.position = startPositionForPress(press);
+        pp.particle.velocity = ofVec3f(vx, vy, 0);
     }
 }
 
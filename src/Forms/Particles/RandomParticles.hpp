@@ -19,7 +19,8 @@ class RandomParticles : public BaseParticles {
     ofParameter<float> baseRandom;
 
    protected:
-    void createParticlesForPress(Press & press, int numberOfParticlesToCreate, ofColor c, float arousalPct) override;
+    void createParticlesForPress(const Press & press, int numberOfParticlesToCreate, ofColor c,
+                                 float arousalPct) override;
     ofVec3f startPositionForPress(const Press & p) override;
     float opacityForEphemeralPress(KeyState & ks, const Press & p) const override;
     float opacityForPress(KeyState & ks, const Press & p) const override;
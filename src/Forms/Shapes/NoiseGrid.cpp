@@ -12,7 +12,7 @@
 #define PERIOD_S 1.0
 #define NOISE_GRID_PRESS_OFFSET_PRIME 7919
 
-NoiseGrid::NoiseGrid(const std::string & name) : Shape(name) {
+NoiseGrid::NoiseGrid(const std::string & name) : Shape(name), resolutionKnob(quality.addKnob("resolution", 0.5)) {
     canvas.allocate(ofGetWidth(), ofGetHeight(), OF_IMAGE_COLOR_ALPHA);
 
     glowIntensity.set(2.59);
@@ -76,16 +76,21 @@ void NoiseGrid::drawUnit(const ofColor & color, KeyState & ks, DrawManager & dm,
     int h = canvas.getHeight();
     float z = dt * zVelocityPerSecond;
     float pressOffset = press.id % NOISE_GRID_PRESS_OFFSET_PRIME;
-    for (int i = 0; i < w; i += resolution) {
-        for (int j = 0; j < h; j += resolution) {
+    // resolution is the block size in pixels, so lower quality means bigger blocks
+    int step = std::max(1, static_cast<int>(std::round(resolution / quality.scale(resolutionKnob))));
+    for (int i = 0; i < w; i += step) {
+        for (int j = 0; j < h; j += step) {
             // Translate Z by p.note * 100 to collect different noise per note, you would never see the pattern
             // Scale by less-than-one noise amplitude to make space more black than colorful.
             float noise =
                 ofNoise(i / shortSide * frequency + pressOffset, j / shortSide * frequency, z + press.note * 100.0) *
                 noiseAmplitude;
             ofColor c = ofColor(color.r, color.g, color.b, color.a * noise);
-            for (int k = 0; k < resolution; k++) {
-                for (int l = 0; l < resolution; l++) {
+            // The step need not divide the canvas, and setColor doesn't check bounds, so the last blocks are clipped
+            int blockW = std::min(step, w - i);
+            int blockH = std::min(step, h - j);
+            for (int k = 0; k < blockW; k++) {
+                for (int l = 0; l < blockH; l++) {
                     canvas.getPixels().setColor(i + k, j + l, c);  // place your pixels
                 }
             }
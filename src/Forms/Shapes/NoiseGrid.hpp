@@ -26,6 +26,8 @@ class NoiseGrid : public Shape {
     ofParameter<float> noiseAmplitude;
     // ofParameter<float> topToBottomWaveLengthRatio;
 
+    size_t resolutionKnob;
+
     ofImage canvas;
 };
 
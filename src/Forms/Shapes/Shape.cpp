@@ -66,8 +66,7 @@ void Shape::draw(KeyState & ks, ColorProvider & clr, DrawManager & dm) {
     }
     if (drawMode == 0) {
         // Only blur non-glow
-        dm.shadeBlurX(blurOffset, blurGain);  // Blurrier at low arousal, sharper at high
-        dm.shadeBlurY(blurOffset, blurGain);  // Blurrier at low arousal, sharper at high
+        dm.shadeBlur(blurOffset, blurGain);  // Blurrier at low arousal, sharper at high
     }
 }
 
@@ -0,0 +1,71 @@
+//
+//  SpatialGrid.cpp
+//  orgb
+//
+
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#define SPATIAL_GRID_MIN_CELL_SIZE 0.001f
+
+SpatialGrid::SpatialGrid()
+    : origin(0, 0, 0), cellSize(1.0f), inverseCellSize(1.0f), dimX(1), dimY(1), dimZ(1), cellStart(2, 0) {}
+
+void SpatialGrid::build(const std::vector<glm::vec3> & positions, float newCellSize, size_t maxCells) {
+    sortedIndices.resize(positions.size());
+    cellOfPoint.resize(positions.size());
+    if (positions.empty()) {
+        return;
+    }
+
+    glm::vec3 lo = positions[0];
+    glm::vec3 hi = positions[0];
+    for (const auto & p : positions) {
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+    glm::vec3 extent = hi - lo;
+    if (!std::isfinite(extent.x) || !std::isfinite(extent.y) || !std::isfinite(extent.z)) {
+        // A runaway point (NaN or infinite velocity) would blow up the grid. Fall back to a single cell.
+        lo = glm::vec3(0, 0, 0);
+        extent = glm::vec3(0, 0, 0);
+    }
+
+    // Also catches a NaN cell size
+    cellSize = newCellSize >= SPATIAL_GRID_MIN_CELL_SIZE ? newCellSize : SPATIAL_GRID_MIN_CELL_SIZE;
+    auto cellsFor = [&extent](float size) {
+        return (static_cast<double>(std::floor(extent.x / size)) + 1) *
+               (static_cast<double>(std::floor(extent.y / size)) + 1) *
+               (static_cast<double>(std::floor(extent.z / size)) + 1);
+    };
+    // Points scattered far apart relative to the cell size would need a huge, mostly empty grid. Coarser cells
+    // are still correct, just less selective.
+    while (cellsFor(cellSize) > static_cast<double>(std::max<size_t>(maxCells, 1))) {
+        cellSize *= 2.0f;
+    }
+    inverseCellSize = 1.0f / cellSize;
+    origin = lo;
+    dimX = static_cast<int>(std::floor(extent.x * inverseCellSize)) + 1;
+    dimY = static_cast<int>(std::floor(extent.y * inverseCellSize)) + 1;
+    dimZ = static_cast<int>(std::floor(extent.z * inverseCellSize)) + 1;
+
+    // Counting sort: histogram, inclusive prefix sum, then scatter backwards using each cell's end as a cursor.
+    // Walking backwards keeps the sort stable, so indices stay ascending within a cell, and leaves cellStart[c]
+    // pointing at the first index of cell c.
+    cellStart.assign(getCellCount() + 1, 0);
+    for (size_t i = 0; i < positions.size(); i++) {
+        const glm::vec3 & p = positions[i];
+        size_t c = cellIndex(cellCoordinate(p.x, origin.x, dimX), cellCoordinate(p.y, origin.y, dimY),
+                             cellCoordinate(p.z, origin.z, dimZ));
+        cellOfPoint[i] = static_cast<uint32_t>(c);
+        cellStart[c]++;
+    }
+    for (size_t c = 1; c < cellStart.size(); c++) {
+        cellStart[c] += cellStart[c - 1];
+    }
+    for (size_t i = positions.size(); i-- > 0;) {
+        sortedIndices[--cellStart[cellOfPoint[i]]] = static_cast<uint32_t>(i);
+    }
+}
@@ -0,0 +1,81 @@
+//
+//  SpatialGrid.hpp
+//  orgb
+//
+//  Uniform grid over a set of points for fixed-radius neighbour queries. The grid is rebuilt from scratch each
+//  frame with a counting sort, so there is no incremental bookkeeping and, once the buffers have grown to the
+//  population size, no allocation.
+//
+
+#ifndef SpatialGrid_hpp
+#define SpatialGrid_hpp
+
+#include <algorithm>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class SpatialGrid {
+   public:
+    SpatialGrid();
+    ~SpatialGrid() = default;
+
+    // Bin positions into cells of at least cellSize on a side. Queries then find every point within cellSize of
+    // the query point by scanning the 3x3x3 block of cells around it. If the bounds of the points would need
+    // more than maxCells cells, the cell size is increased until they fit.
+    void build(const std::vector<glm::vec3> & positions, float cellSize, size_t maxCells = 1 << 16);
+
+    // Call visit(uint32_t index) for every point in the cells adjacent to p. This is a superset of the points
+    // within cellSize of p; callers still do their own distance test. Indices within a cell are visited in
+    // ascending order.
+    template <typename Visitor>
+    void forEachCandidate(const glm::vec3 & p, Visitor visit) const {
+        if (sortedIndices.empty()) {
+            return;
+        }
+        int cx = cellCoordinate(p.x, origin.x, dimX);
+        int cy = cellCoordinate(p.y, origin.y, dimY);
+        int cz = cellCoordinate(p.z, origin.z, dimZ);
+        for (int z = std::max(cz - 1, 0); z <= std::min(cz + 1, dimZ - 1); z++) {
+            for (int y = std::max(cy - 1, 0); y <= std::min(cy + 1, dimY - 1); y++) {
+                // Cells adjacent in x are adjacent in memory, so scan the whole x run at once.
+                size_t rowCell = cellIndex(0, y, z);
+                uint32_t first = cellStart[rowCell + std::max(cx - 1, 0)];
+                uint32_t last = cellStart[rowCell + std::min(cx + 1, dimX - 1) + 1];
+                for (uint32_t i = first; i < last; i++) {
+                    visit(sortedIndices[i]);
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] float getCellSize() const { return cellSize; }
+    [[nodiscard]] size_t getCellCount() const { return static_cast<size_t>(dimX) * dimY * dimZ; }
+
+   private:
+    [[nodiscard]] int cellCoordinate(float v, float min, int dim) const {
+        // Clamp so points that wandered outside the built bounds still land in the nearest edge cell. Written so
+        // that NaN also lands in cell 0.
+        float c = (v - min) * inverseCellSize;
+        if (!(c >= 0.0f)) {
+            return 0;
+        }
+        return c >= static_cast<float>(dim) ? dim - 1 : static_cast<int>(c);
+    }
+    [[nodiscard]] size_t cellIndex(int x, int y, int z) const {
+        return (static_cast<size_t>(z) * dimY + y) * dimX + x;
+    }
+
+    glm::vec3 origin;
+    float cellSize;
+    float inverseCellSize;
+    int dimX;
+    int dimY;
+    int dimZ;
+
+    std::vector<uint32_t> cellStart;      // Prefix sums, cellStart[c]..cellStart[c + 1] indexes sortedIndices
+    std::vector<uint32_t> sortedIndices;  // Point indices ordered by cell
+    std::vector<uint32_t> cellOfPoint;
+};
+
+#endif /* SpatialGrid_hpp */
@@ -11,6 +11,7 @@
 #include "ColorProvider.hpp"
 #include "DrawManager.hpp"
 #include "KeyState.hpp"
+#include "QualityGovernor.hpp"
 #include "ofCamera.h"
 #include "ofxGui.h"
 
@@ -26,6 +27,8 @@ class VisualForm {
 
     ofParameterGroup parameters;
     std::string name;
+    // Forms register their expensive parameters as knobs; ofApp feeds frame times while the form is current.
+    QualityGovernor quality;
 };
 
 #endif /* VisualForm_hpp */
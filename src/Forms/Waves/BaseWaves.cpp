@@ -50,7 +50,6 @@ void BaseWaves::draw(KeyState & ks, ColorProvider & clr, DrawManager & dm) {
         }
         drawUnit(clr, ks, dm, press, pow(press.velocityPct, 0.2));
     }
-    dm.shadeBlurX(ks.arousalGain());
-    dm.shadeBlurY(ks.arousalGain());
+    dm.shadeBlur(ks.arousalGain());
     ofPopStyle();
 }
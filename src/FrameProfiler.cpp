@@ -0,0 +1,297 @@
+//
+//  FrameProfiler.cpp
+//  orgb
+//
+
+#include "FrameProfiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "ofMain.h"
+
+// Zones a thread can close between drains; a power of two. A frame opens a few hundred at most.
+#define PROFILER_RING_SIZE 8192
+// Durations kept per zone for percentiles, about 17 seconds of a once-a-frame zone at 60 fps
+#define PROFILER_WINDOW_SIZE 1024
+// Zones kept for the trace, all threads together
+#define PROFILER_TRACE_SIZE 262144
+#define PROFILER_MAX_ZONES 4096
+#define PROFILER_SUMMARY_MAX_LINES 16
+
+struct ProfileRecord {
+    uint64_t startNs;
+    uint64_t endNs;
+    uint16_t zone;
+};
+
+// Single producer (its thread), single consumer (collect())
+struct ThreadRing {
+    std::vector<ProfileRecord> records = std::vector<ProfileRecord>(PROFILER_RING_SIZE);
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+    uint16_t index = 0;
+    std::string name;
+};
+
+struct TraceEvent {
+    uint64_t startNs;
+    uint64_t endNs;
+    uint16_t zone;
+    uint16_t thread;
+};
+
+struct DurationWindow {
+    std::vector<double> durationsMs;
+    size_t next = 0;
+};
+
+struct ProfilerState {
+    std::mutex registryMutex;  // Zone names and rings
+    std::unordered_map<std::string, uint16_t> zoneIds;
+    std::vector<std::string> zoneNames;
+    std::vector<std::unique_ptr<ThreadRing>> rings;  // Never freed, so a ring outlives its thread's last zone
+
+    std::mutex collectMutex;  // Everything below, and the consuming end of every ring
+    std::deque<TraceEvent> trace;
+    std::vector<DurationWindow> windows;  // By zone id
+};
+
+// Never destroyed: threads still closing zones during static destruction would otherwise write into freed memory
+static ProfilerState & state() {
+    static ProfilerState * s = new ProfilerState();
+    return *s;
+}
+
+static thread_local ThreadRing * threadRing = nullptr;
+
+static ThreadRing & ringForThread() {
+    if (threadRing == nullptr) {
+        ProfilerState & s = state();
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        auto ring = std::make_unique<ThreadRing>();
+        ring->index = static_cast<uint16_t>(s.rings.size());
+        ring->name = "Thread " + std::to_string(ring->index);
+        threadRing = ring.get();
+        s.rings.push_back(std::move(ring));
+    }
+    return *threadRing;
+}
+
+static std::vector<ThreadRing *> allRings() {
+    ProfilerState & s = state();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    std::vector<ThreadRing *> rings;
+    for (const auto & ring : s.rings) {
+        rings.push_back(ring.get());
+    }
+    return rings;
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+uint16_t FrameProfiler::zoneId(const std::string & name) {
+    ProfilerState & s = state();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    auto found = s.zoneIds.find(name);
+    if (found != s.zoneIds.end()) {
+        return found->second;
+    }
+    if (s.zoneNames.size() >= PROFILER_MAX_ZONES) {
+        return PROFILE_NO_ZONE;
+    }
+    uint16_t id = static_cast<uint16_t>(s.zoneNames.size());
+    s.zoneNames.push_back(name);
+    s.zoneIds[name] = id;
+    return id;
+}
+
+void FrameProfiler::setThreadName(const std::string & name) {
+    ThreadRing & ring = ringForThread();
+    std::lock_guard<std::mutex> lock(state().registryMutex);
+    ring.name = name;
+}
+
+void FrameProfiler::record(uint16_t zone, uint64_t startNs, uint64_t endNs) {
+    ThreadRing & ring = ringForThread();
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= PROFILER_RING_SIZE) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring.records[head & (PROFILER_RING_SIZE - 1)] = {startNs, endNs, zone};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+// ============================================================================
+// Collection
+// ============================================================================
+
+void FrameProfiler::collect() {
+    ProfilerState & s = state();
+    std::lock_guard<std::mutex> lock(s.collectMutex);
+    for (ThreadRing * ring : allRings()) {
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail != head; tail++) {
+            const ProfileRecord & r = ring->records[tail & (PROFILER_RING_SIZE - 1)];
+            s.trace.push_back({r.startNs, r.endNs, r.zone, ring->index});
+
+            if (r.zone >= s.windows.size()) {
+                s.windows.resize(r.zone + 1);
+            }
+            DurationWindow & window = s.windows[r.zone];
+            double ms = (r.endNs - r.startNs) / 1e6;
+            if (window.durationsMs.size() < PROFILER_WINDOW_SIZE) {
+                window.durationsMs.push_back(ms);
+            } else {
+                window.durationsMs[window.next] = ms;
+            }
+            window.next = (window.next + 1) % PROFILER_WINDOW_SIZE;
+        }
+        ring->tail.store(head, std::memory_order_release);
+    }
+    while (s.trace.size() > PROFILER_TRACE_SIZE) {
+        s.trace.pop_front();
+    }
+}
+
+void FrameProfiler::reset() {
+    ProfilerState & s = state();
+    std::lock_guard<std::mutex> lock(s.collectMutex);
+    for (ThreadRing * ring : allRings()) {
+        ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+        ring->dropped.store(0, std::memory_order_relaxed);
+    }
+    s.trace.clear();
+    s.windows.clear();
+}
+
+// ============================================================================
+// Results
+// ============================================================================
+
+// Nearest rank, so every percentile is a duration that was measured
+static double percentile(const std::vector<double> & sorted, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+std::vector<FrameProfiler::Stat> FrameProfiler::getStats() {
+    ProfilerState & s = state();
+    std::vector<DurationWindow> windows;
+    {
+        std::lock_guard<std::mutex> lock(s.collectMutex);
+        windows = s.windows;
+    }
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        names = s.zoneNames;
+    }
+
+    std::vector<Stat> stats;
+    for (size_t zone = 0; zone < windows.size(); zone++) {
+        std::vector<double> & durations = windows[zone].durationsMs;
+        if (durations.empty()) {
+            continue;
+        }
+        std::sort(durations.begin(), durations.end());
+        stats.push_back({names[zone], durations.size(), percentile(durations, 0.50), percentile(durations, 0.95),
+                         percentile(durations, 0.99), durations.back()});
+    }
+    std::sort(stats.begin(), stats.end(), [](const Stat & a, const Stat & b) { return a.p50Ms > b.p50Ms; });
+    return stats;
+}
+
+std::string FrameProfiler::getSummary() {
+    std::stringstream ss;
+    if (!isEnabled()) {
+        ss << "Profiler: off";
+        return ss.str();
+    }
+    ss << std::fixed << std::setprecision(2);
+    ss << "Profiler: p50 / p95 / p99 ms";
+    uint64_t dropped = getDropped();
+    if (dropped > 0) {
+        ss << " (" << dropped << " dropped)";
+    }
+    std::vector<Stat> stats = getStats();
+    for (size_t i = 0; i < stats.size(); i++) {
+        if (i == PROFILER_SUMMARY_MAX_LINES) {
+            ss << "\n  ...";
+            break;
+        }
+        ss << "\n  " << stats[i].name << ": " << stats[i].p50Ms << " / " << stats[i].p95Ms << " / "
+           << stats[i].p99Ms;
+    }
+    return ss.str();
+}
+
+uint64_t FrameProfiler::getDropped() {
+    uint64_t dropped = 0;
+    for (ThreadRing * ring : allRings()) {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+// Trace Event Format: complete ("X") events in microseconds, one tid per ring, named by metadata events
+bool FrameProfiler::writeChromeTrace(const std::string & path) {
+    collect();
+    ProfilerState & s = state();
+    std::vector<std::string> zoneNames;
+    std::vector<std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        zoneNames = s.zoneNames;
+        for (const auto & ring : s.rings) {
+            threadNames.push_back(ring->name);
+        }
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        ofLogError("FrameProfiler") << "Cannot write trace to " << path;
+        return false;
+    }
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (size_t thread = 0; thread < threadNames.size(); thread++) {
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+             << ",\"args\":{\"name\":" << ofJson(threadNames[thread]).dump() << "}},\n";
+    }
+    std::vector<std::string> quotedNames;
+    for (const auto & name : zoneNames) {
+        quotedNames.push_back(ofJson(name).dump());
+    }
+
+    size_t written = 0;
+    {
+        std::lock_guard<std::mutex> lock(s.collectMutex);
+        for (const auto & event : s.trace) {
+            file << "{\"name\":" << quotedNames[event.zone] << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+                 << ",\"ts\":" << event.startNs / 1e3 << ",\"dur\":" << (event.endNs - event.startNs) / 1e3 << "},\n";
+        }
+        written = s.trace.size();
+    }
+    // Trailing commas are not allowed, so the list ends on a metadata event
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"orgb\"}}\n]}\n";
+    file.close();
+    if (!file) {
+        ofLogError("FrameProfiler") << "Failed writing trace to " << path;
+        return false;
+    }
+    ofLogNotice("FrameProfiler") << "Wrote " << written << " zones to " << path;
+    return true;
+}
@@ -0,0 +1,107 @@
+//
+//  FrameProfiler.hpp
+//  orgb
+//
+//  Scoped CPU zones across threads. PROFILE_ZONE("Name") times the rest of the enclosing scope; zones nest, and
+//  any thread can open them. Each thread writes finished zones into a ring of its own without locking, and the main
+//  thread drains every ring once a frame with collect(), keeping the last few seconds of zones for a Chrome trace
+//  (chrome://tracing or ui.perfetto.dev) and a window of durations per zone for percentiles.
+//
+//  Off by default and switchable at any time. While off, a zone costs one relaxed atomic load, and
+//  PROFILE_ZONE_NAMED does not build its name. A ring that fills before it is drained drops zones, counted per
+//  thread, rather than making the thread wait.
+//
+//  Percentiles are over individual zones, not per-frame sums: a zone entered three times a frame contributes three
+//  samples.
+//
+
+#ifndef FrameProfiler_hpp
+#define FrameProfiler_hpp
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define PROFILE_NO_ZONE UINT16_MAX
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Time the rest of the scope. The name must be the same every time the line runs.
+#define PROFILE_ZONE(name)                                                                        \
+    static const uint16_t PROFILE_CONCAT(profileZoneId, __LINE__) = FrameProfiler::zoneId(name); \
+    ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(PROFILE_CONCAT(profileZoneId, __LINE__))
+
+// Time the rest of the scope under a name computed at run time, only evaluated while profiling
+#define PROFILE_ZONE_NAMED(name)                        \
+    ProfileZone PROFILE_CONCAT(profileZone, __LINE__)( \
+        FrameProfiler::isEnabled() ? FrameProfiler::zoneId(name) : PROFILE_NO_ZONE)
+
+class FrameProfiler {
+   public:
+    struct Stat {
+        std::string name;
+        size_t count;  // Zones in the window
+        double p50Ms;
+        double p95Ms;
+        double p99Ms;
+        double maxMs;
+    };
+
+    static void setEnabled(bool state) { enabled.store(state, std::memory_order_relaxed); }
+    [[nodiscard]] static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    // The id for a zone name, registering it the first time. PROFILE_NO_ZONE once too many names are registered.
+    static uint16_t zoneId(const std::string & name);
+    // Names the calling thread in traces and summaries. Threads are otherwise "Thread <n>".
+    static void setThreadName(const std::string & name);
+
+    // Called by zones as they close
+    static void record(uint16_t zone, uint64_t startNs, uint64_t endNs);
+    [[nodiscard]] static uint64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch)
+            .count();
+    }
+
+    // Drain every thread's ring into the trace and the percentile windows. Once a frame, from one thread.
+    static void collect();
+    // Forget collected zones; registered names and threads stay
+    static void reset();
+
+    // Collects first. Returns false if the file could not be written.
+    static bool writeChromeTrace(const std::string & path);
+
+    [[nodiscard]] static std::vector<Stat> getStats();  // Slowest median first
+    [[nodiscard]] static std::string getSummary();
+    [[nodiscard]] static uint64_t getDropped();  // Zones lost to full rings, all threads
+
+   private:
+    static inline std::atomic<bool> enabled{false};
+    static inline const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+class ProfileZone {
+   public:
+    explicit ProfileZone(uint16_t zone) : zone(zone), active(zone != PROFILE_NO_ZONE && FrameProfiler::isEnabled()) {
+        if (active) {
+            startNs = FrameProfiler::nowNs();
+        }
+    }
+    ~ProfileZone() {
+        if (active) {
+            FrameProfiler::record(zone, startNs, FrameProfiler::nowNs());
+        }
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone & operator=(const ProfileZone &) = delete;
+
+   private:
+    uint16_t zone;
+    bool active;
+    uint64_t startNs = 0;
+};
+
+#endif /* FrameProfiler_hpp */
@@ -0,0 +1,167 @@
+//
+//  FrameSequenceWriter.cpp
+//  orgb
+//
+
+#include "FrameSequenceWriter.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+static bool endsWith(const std::string & text, const std::string & suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// frames/out.png, 7 -> frames/out_000007.png
+static std::string numberedPath(const std::string & path, uint64_t index) {
+    size_t slash = path.find_last_of('/');
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        dot = path.size();
+    }
+    char number[24];
+    snprintf(number, sizeof(number), "_%06llu", static_cast<unsigned long long>(index));
+    return path.substr(0, dot) + number + path.substr(dot);
+}
+
+FrameSequenceWriter::~FrameSequenceWriter() { close(); }
+
+bool FrameSequenceWriter::open(const std::string & newPath, int newFps, size_t newMaxQueued) {
+    close();
+    path = newPath;
+    fps = std::max(newFps, 1);
+    maxQueued = std::max<size_t>(newMaxQueued, 1);
+    headerWritten = false;
+    closing = false;
+    framesWritten = 0;
+    framesFailed = 0;
+
+    if (path == "-") {
+        stream = stdout;
+    } else if (endsWith(path, ".y4m")) {
+        stream = fopen(path.c_str(), "wb");
+        if (stream == nullptr) {
+            ofLogError("FrameSequenceWriter") << "Could not open " << path << ": " << strerror(errno);
+            return false;
+        }
+    }
+    writerThread = std::thread(&FrameSequenceWriter::writerThreadFunction, this);
+    ofLogNotice("FrameSequenceWriter") << "Writing " << (stream != nullptr ? "a y4m stream" : "images") << " to "
+                                       << path << " at " << fps << " fps";
+    return true;
+}
+
+void FrameSequenceWriter::close() {
+    if (!writerThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    changed.notify_all();
+    writerThread.join();
+
+    if (stream != nullptr) {
+        fflush(stream);
+        if (stream != stdout) {
+            fclose(stream);
+        }
+        stream = nullptr;
+    }
+    queued.clear();
+    spare.clear();
+    ofLogNotice("FrameSequenceWriter") << "Wrote " << framesWritten << " frames to " << path
+                                       << (framesFailed > 0 ? ", " + ofToString(framesFailed) + " failed" : "");
+}
+
+void FrameSequenceWriter::write(const ofPixels & pixels) {
+    if (!isOpen() || !pixels.isAllocated()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return queued.size() < maxQueued; });
+
+    ofPixels frame;
+    if (!spare.empty()) {
+        frame = std::move(spare.back());
+        spare.pop_back();
+    }
+    lock.unlock();
+    frame = pixels;  // Reuses the spare's allocation when the size matches
+    lock.lock();
+    queued.push_back(std::move(frame));
+    lock.unlock();
+    changed.notify_all();
+}
+
+void FrameSequenceWriter::writerThreadFunction() {
+    uint64_t index = 0;
+    while (true) {
+        ofPixels frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return closing || !queued.empty(); });
+            if (queued.empty()) {
+                return;  // Closing, and everything queued is written
+            }
+            frame = std::move(queued.front());
+            queued.pop_front();
+        }
+        changed.notify_all();  // Room in the queue
+
+        index++;
+        bool written = stream != nullptr ? writeY4m(frame) : writeImage(frame, index);
+        (written ? framesWritten : framesFailed)++;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        spare.push_back(std::move(frame));
+    }
+}
+
+// ============================================================================
+// y4m
+// ============================================================================
+
+void FrameSequenceWriter::rgbToYuv444(const unsigned char * rgb, int channels, size_t count, unsigned char * y,
+                                      unsigned char * u, unsigned char * v) {
+    for (size_t i = 0; i < count; i++, rgb += channels) {
+        int r = rgb[0];
+        int g = channels >= 3 ? rgb[1] : r;
+        int b = channels >= 3 ? rgb[2] : r;
+        y[i] = static_cast<unsigned char>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        u[i] = static_cast<unsigned char>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+        v[i] = static_cast<unsigned char>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+}
+
+bool FrameSequenceWriter::writeY4m(const ofPixels & pixels) {
+    size_t count = pixels.getWidth() * pixels.getHeight();
+    if (!headerWritten) {
+        // Progressive, square pixels, full chroma; alpha is dropped
+        fprintf(stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", static_cast<int>(pixels.getWidth()),
+                static_cast<int>(pixels.getHeight()), fps);
+        planes.resize(count * 3);
+        headerWritten = true;
+    } else if (planes.size() != count * 3) {
+        ofLogError("FrameSequenceWriter") << "Frame size changed mid-stream; skipping frame";
+        return false;
+    }
+    rgbToYuv444(pixels.getData(), pixels.getNumChannels(), count, planes.data(), planes.data() + count,
+                planes.data() + count * 2);
+    fputs("FRAME\n", stream);
+    return fwrite(planes.data(), 1, planes.size(), stream) == planes.size();
+}
+
+// ============================================================================
+// Images
+// ============================================================================
+
+bool FrameSequenceWriter::writeImage(const ofPixels & pixels, uint64_t index) {
+    std::string framePath = numberedPath(path, index);
+    if (!ofSaveImage(pixels, framePath)) {
+        ofLogError("FrameSequenceWriter") << "Could not save " << framePath;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,84 @@
+//
+//  FrameSequenceWriter.hpp
+//  orgb
+//
+//  Encodes and writes rendered frames on a background thread, so the render loop only pays for a copy. The output
+//  path picks the format:
+//
+//    *.y4m, or "-" for stdout   A YUV4MPEG2 stream (4:4:4, BT.601 limited range), which ffmpeg and most encoders
+//                               read directly, e.g. `ffmpeg -i out.y4m out.mp4`
+//    anything else              One image per frame through ofSaveImage, numbered after the stem:
+//                               frames/out.png -> frames/out_000001.png, frames/out_000002.png, ...
+//
+//  The queue is bounded: when the writer falls behind, write() blocks rather than dropping frames or growing
+//  without limit. Frame buffers are pooled, so a steady stream allocates nothing.
+//
+//  OF's console logger prints notices to stdout, so a stream to stdout needs StderrLoggerChannel (see
+//  StderrLoggerChannel.hpp) installed before anything logs.
+//
+
+#ifndef FrameSequenceWriter_hpp
+#define FrameSequenceWriter_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ofMain.h"
+
+#define FRAME_SEQUENCE_DEFAULT_QUEUE 8
+
+class FrameSequenceWriter {
+   public:
+    FrameSequenceWriter() = default;
+    ~FrameSequenceWriter();
+
+    FrameSequenceWriter(const FrameSequenceWriter &) = delete;
+    FrameSequenceWriter & operator=(const FrameSequenceWriter &) = delete;
+
+    // Returns false if the output could not be opened
+    bool open(const std::string & path, int fps, size_t maxQueued = FRAME_SEQUENCE_DEFAULT_QUEUE);
+    // Writes everything still queued, then closes the output
+    void close();
+
+    // Queue a copy of the frame. Every frame must have the size of the first.
+    void write(const ofPixels & pixels);
+
+    [[nodiscard]] bool isOpen() const { return writerThread.joinable(); }
+    [[nodiscard]] bool isStream() const { return stream != nullptr; }
+    [[nodiscard]] uint64_t getFramesWritten() const { return framesWritten; }
+    [[nodiscard]] uint64_t getFramesFailed() const { return framesFailed; }
+
+    // 8-bit BT.601 limited-range conversion of interleaved RGB(A) into planar Y, U and V of count samples each
+    static void rgbToYuv444(const unsigned char * rgb, int channels, size_t count, unsigned char * y,
+                            unsigned char * u, unsigned char * v);
+
+   private:
+    void writerThreadFunction();
+    bool writeY4m(const ofPixels & pixels);
+    bool writeImage(const ofPixels & pixels, uint64_t index);
+
+    std::string path;
+    int fps = 60;
+    size_t maxQueued = FRAME_SEQUENCE_DEFAULT_QUEUE;
+    FILE * stream = nullptr;  // y4m only
+    bool headerWritten = false;
+    std::vector<unsigned char> planes;
+
+    std::thread writerThread;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<ofPixels> queued;
+    std::vector<ofPixels> spare;  // Written frames, kept for reuse
+    bool closing = false;
+
+    std::atomic<uint64_t> framesWritten{0};
+    std::atomic<uint64_t> framesFailed{0};
+};
+
+#endif /* FrameSequenceWriter_hpp */
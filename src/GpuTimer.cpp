@@ -0,0 +1,290 @@
+//
+//  GpuTimer.cpp
+//  orgb
+//
+
+#include "GpuTimer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#if defined(TARGET_OPENGLES) && !defined(__EMSCRIPTEN__)
+#include <EGL/egl.h>
+#endif
+
+// Frames whose queries may be outstanding before a frame goes untimed
+#define GPU_TIMER_FRAMES_IN_FLIGHT 2
+// Weight of the newest frame in the rolling averages, about a second at 60 fps
+#define GPU_TIMER_AVERAGE_WEIGHT 0.05
+// Collected frames after which a name that stopped appearing is dropped
+#define GPU_TIMER_FORGET_FRAMES 600
+#define GPU_TIMER_SUMMARY_MAX_LINES 12
+// Same values for the core enums and the EXT_disjoint_timer_query ones
+#define TIME_ELAPSED 0x88BF
+#define QUERY_RESULT 0x8866
+#define QUERY_RESULT_AVAILABLE 0x8867
+#define GPU_DISJOINT 0x8FBB
+
+// ============================================================================
+// Entry points
+// ============================================================================
+
+#if defined(__EMSCRIPTEN__)
+// WebGL 1 exposes timer queries through a different, asynchronous API
+static bool timerFunctionsAvailable() { return false; }
+static void genQueries(GLsizei, GLuint *) {}
+static void deleteQueries(GLsizei, const GLuint *) {}
+static void beginQuery(GLuint) {}
+static void endQuery() {}
+static bool queryAvailable(GLuint) { return true; }
+static uint64_t queryResult(GLuint) { return 0; }
+static bool disjoint() { return true; }
+#elif defined(TARGET_OPENGLES)
+typedef void (*GenQueriesFunction)(GLsizei, GLuint *);
+typedef void (*DeleteQueriesFunction)(GLsizei, const GLuint *);
+typedef void (*BeginQueryFunction)(GLenum, GLuint);
+typedef void (*EndQueryFunction)(GLenum);
+typedef void (*GetQueryObjectuivFunction)(GLuint, GLenum, GLuint *);
+typedef void (*GetQueryObjectui64vFunction)(GLuint, GLenum, uint64_t *);
+struct TimerFunctions {
+    GenQueriesFunction gen = nullptr;
+    DeleteQueriesFunction del = nullptr;
+    BeginQueryFunction begin = nullptr;
+    EndQueryFunction end = nullptr;
+    GetQueryObjectuivFunction getuiv = nullptr;
+    GetQueryObjectui64vFunction getui64v = nullptr;
+};
+static const TimerFunctions & timerFunctions() {
+    static TimerFunctions functions = [] {
+        TimerFunctions f;
+        const GLubyte * extensions = glGetString(GL_EXTENSIONS);
+        if (extensions == nullptr ||
+            strstr(reinterpret_cast<const char *>(extensions), "GL_EXT_disjoint_timer_query") == nullptr) {
+            return f;
+        }
+        f.gen = reinterpret_cast<GenQueriesFunction>(eglGetProcAddress("glGenQueriesEXT"));
+        f.del = reinterpret_cast<DeleteQueriesFunction>(eglGetProcAddress("glDeleteQueriesEXT"));
+        f.begin = reinterpret_cast<BeginQueryFunction>(eglGetProcAddress("glBeginQueryEXT"));
+        f.end = reinterpret_cast<EndQueryFunction>(eglGetProcAddress("glEndQueryEXT"));
+        f.getuiv = reinterpret_cast<GetQueryObjectuivFunction>(eglGetProcAddress("glGetQueryObjectuivEXT"));
+        f.getui64v = reinterpret_cast<GetQueryObjectui64vFunction>(eglGetProcAddress("glGetQueryObjectui64vEXT"));
+        return f;
+    }();
+    return functions;
+}
+static bool timerFunctionsAvailable() {
+    const TimerFunctions & f = timerFunctions();
+    return f.gen && f.del && f.begin && f.end && f.getuiv && f.getui64v;
+}
+static void genQueries(GLsizei count, GLuint * queries) { timerFunctions().gen(count, queries); }
+static void deleteQueries(GLsizei count, const GLuint * queries) { timerFunctions().del(count, queries); }
+static void beginQuery(GLuint query) { timerFunctions().begin(TIME_ELAPSED, query); }
+static void endQuery() { timerFunctions().end(TIME_ELAPSED); }
+static bool queryAvailable(GLuint query) {
+    GLuint available = 0;
+    timerFunctions().getuiv(query, QUERY_RESULT_AVAILABLE, &available);
+    return available != 0;
+}
+static uint64_t queryResult(GLuint query) {
+    uint64_t nanoseconds = 0;
+    timerFunctions().getui64v(query, QUERY_RESULT, &nanoseconds);
+    return nanoseconds;
+}
+static bool disjoint() {
+    // A frequency change or context switch invalidates every query in flight
+    GLint value = 0;
+    glGetIntegerv(GPU_DISJOINT, &value);
+    return value != 0;
+}
+#else
+// Loaded by GLEW. A legacy 2.1 context on macOS has no timer queries.
+static bool timerFunctionsAvailable() {
+    return glGenQueries != nullptr && glBeginQuery != nullptr && glGetQueryObjectui64v != nullptr;
+}
+static void genQueries(GLsizei count, GLuint * queries) { glGenQueries(count, queries); }
+static void deleteQueries(GLsizei count, const GLuint * queries) { glDeleteQueries(count, queries); }
+static void beginQuery(GLuint query) { glBeginQuery(TIME_ELAPSED, query); }
+static void endQuery() { glEndQuery(TIME_ELAPSED); }
+static bool queryAvailable(GLuint query) {
+    GLint available = 0;
+    glGetQueryObjectiv(query, QUERY_RESULT_AVAILABLE, &available);
+    return available != 0;
+}
+static uint64_t queryResult(GLuint query) {
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(query, QUERY_RESULT, &nanoseconds);
+    return nanoseconds;
+}
+static bool disjoint() { return false; }
+#endif
+
+// ============================================================================
+// GpuTimer
+// ============================================================================
+
+GpuTimer::~GpuTimer() {
+    if (!allQueries.empty()) {
+        deleteQueries(static_cast<GLsizei>(allQueries.size()), allQueries.data());
+    }
+}
+
+bool GpuTimer::isSupported() const {
+    static bool supported = timerFunctionsAvailable();
+    return supported;
+}
+
+GLuint GpuTimer::acquireQuery() {
+    if (freeQueries.empty()) {
+        GLuint query = 0;
+        genQueries(1, &query);
+        allQueries.push_back(query);
+        return query;
+    }
+    GLuint query = freeQueries.back();
+    freeQueries.pop_back();
+    return query;
+}
+
+void GpuTimer::begin(const std::string & name) {
+    if (openDepth++ > 0 || !enabled || !isSupported()) {
+        return;
+    }
+    syncFrame();
+    openTimed = timingFrame;
+    if (openTimed) {
+        current.push_back({name, acquireQuery()});
+        beginQuery(current.back().query);
+    }
+}
+
+void GpuTimer::end() {
+    if (openDepth == 0) {
+        ofLogWarning("GpuTimer::end") << "end() without begin()";
+        return;
+    }
+    if (--openDepth == 0 && openTimed) {
+        endQuery();
+        openTimed = false;
+    }
+}
+
+void GpuTimer::syncFrame() {
+    uint64_t now = ofGetFrameNum();
+    if (now == frame) {
+        return;
+    }
+    frame = now;
+    closeFrame();
+    while (!inFlight.empty() && collectOldest(false)) {
+    }
+    timingFrame = inFlight.size() < GPU_TIMER_FRAMES_IN_FLIGHT;
+}
+
+void GpuTimer::closeFrame() {
+    if (!current.empty()) {
+        inFlight.push_back(std::move(current));
+        current.clear();
+    }
+}
+
+void GpuTimer::flush() {
+    if (openDepth > 0 || !isSupported()) {
+        return;
+    }
+    closeFrame();
+    while (!inFlight.empty()) {
+        collectOldest(true);
+    }
+    timingFrame = true;
+}
+
+bool GpuTimer::collectOldest(bool wait) {
+    std::vector<Scope> & scopes = inFlight.front();
+    // Queries complete in submission order, so the last one being ready means they all are
+    if (!wait && !queryAvailable(scopes.back().query)) {
+        return false;
+    }
+
+    std::map<std::string, std::pair<double, int>> frameTotals;
+    for (const auto & scope : scopes) {
+        auto & total = frameTotals[scope.name];
+        total.first += queryResult(scope.query) / 1.0e6;
+        total.second++;
+        freeQueries.push_back(scope.query);
+    }
+    inFlight.pop_front();
+    if (disjoint()) {
+        return true;  // Timings are meaningless, but the queries are free again
+    }
+
+    collectedFrames++;
+    for (const auto & total : frameTotals) {
+        if (accumulators.find(total.first) == accumulators.end()) {
+            accumulators[total.first] = {{total.first, total.second.first, static_cast<double>(total.second.second)},
+                                         collectedFrames};
+        }
+    }
+    for (auto it = accumulators.begin(); it != accumulators.end();) {
+        auto found = frameTotals.find(it->first);
+        double ms = found != frameTotals.end() ? found->second.first : 0.0;
+        double count = found != frameTotals.end() ? found->second.second : 0.0;
+        Stat & stat = it->second.stat;
+        stat.averageMs += (ms - stat.averageMs) * GPU_TIMER_AVERAGE_WEIGHT;
+        stat.averageCount += (count - stat.averageCount) * GPU_TIMER_AVERAGE_WEIGHT;
+        if (found != frameTotals.end()) {
+            it->second.lastSeenFrame = collectedFrames;
+        }
+        if (collectedFrames - it->second.lastSeenFrame > GPU_TIMER_FORGET_FRAMES) {
+            it = accumulators.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return true;
+}
+
+double GpuTimer::getAverageMs(const std::string & name) const {
+    auto found = accumulators.find(name);
+    return found != accumulators.end() ? found->second.stat.averageMs : -1.0;
+}
+
+double GpuTimer::getTotalMs() const {
+    double total = 0;
+    for (const auto & accumulator : accumulators) {
+        total += accumulator.second.stat.averageMs;
+    }
+    return total;
+}
+
+std::vector<GpuTimer::Stat> GpuTimer::getStats() const {
+    std::vector<Stat> stats;
+    for (const auto & accumulator : accumulators) {
+        stats.push_back(accumulator.second.stat);
+    }
+    std::sort(stats.begin(), stats.end(), [](const Stat & a, const Stat & b) { return a.averageMs > b.averageMs; });
+    return stats;
+}
+
+std::string GpuTimer::getSummary() const {
+    std::stringstream ss;
+    if (!enabled || !isSupported()) {
+        ss << "GPU timers: " << (isSupported() ? "off" : "unsupported");
+        return ss.str();
+    }
+    ss << std::fixed << std::setprecision(2);
+    ss << "GPU: " << getTotalMs() << " ms/frame";
+    std::vector<Stat> stats = getStats();
+    for (size_t i = 0; i < stats.size(); i++) {
+        if (i == GPU_TIMER_SUMMARY_MAX_LINES) {
+            ss << "\n  ...";
+            break;
+        }
+        ss << "\n  " << stats[i].name << ": " << stats[i].averageMs << " ms";
+        if (stats[i].averageCount > 1.5) {
+            ss << " x" << std::setprecision(0) << stats[i].averageCount << std::setprecision(2);
+        }
+    }
+    return ss.str();
+}
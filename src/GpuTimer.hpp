@@ -0,0 +1,88 @@
+//
+//  GpuTimer.hpp
+//  orgb
+//
+//  GL_TIME_ELAPSED queries around render passes, averaged per pass name. CPU timers around a frame measure
+//  command submission, not the GPU work, which on the Pi is most of the cost.
+//
+//  Results are read a frame or two late: a frame's queries are only read once the last of them is available, and
+//  while two frames are still in flight the next one goes untimed rather than stalling on the driver. A name timed
+//  several times in a frame (one glow pass per shape) is summed, so averages are milliseconds per frame.
+//
+//  Uses ARB_timer_query (core in GL 3.3) on desktop and EXT_disjoint_timer_query on GLES. Without either, every
+//  call is a no-op and isSupported() is false.
+//
+
+#ifndef GpuTimer_hpp
+#define GpuTimer_hpp
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ofMain.h"
+
+class GpuTimer {
+   public:
+    struct Stat {
+        std::string name;
+        double averageMs;     // Per frame, 0 in frames where the name was not timed
+        double averageCount;  // Scopes per frame
+    };
+
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer &) = delete;
+    GpuTimer & operator=(const GpuTimer &) = delete;
+
+    // Off by default; queries are cheap but not free
+    void setEnabled(bool state) { enabled = state; }
+    [[nodiscard]] bool isEnabled() const { return enabled; }
+    [[nodiscard]] bool isSupported() const;
+
+    // Time the GL commands issued until end(). Timer queries cannot nest, so a begin() while a scope is open is
+    // ignored along with its end().
+    void begin(const std::string & name);
+    void end();
+
+    // Close the current frame and block until all results are in. Stalls the GPU; for tests and benchmarks.
+    void flush();
+
+    [[nodiscard]] double getAverageMs(const std::string & name) const;  // Negative if never measured
+    [[nodiscard]] double getTotalMs() const;                            // Sum over all names
+    [[nodiscard]] std::vector<Stat> getStats() const;                   // Most expensive first
+    [[nodiscard]] std::string getSummary() const;
+
+   private:
+    struct Scope {
+        std::string name;
+        GLuint query;
+    };
+    struct Accumulator {
+        Stat stat;
+        uint64_t lastSeenFrame;
+    };
+
+    void syncFrame();
+    void closeFrame();
+    // Read and average the oldest frame in flight. Returns false, without blocking, if its results are not ready.
+    bool collectOldest(bool wait);
+    GLuint acquireQuery();
+
+    bool enabled = false;
+    uint64_t frame = UINT64_MAX;
+    uint64_t collectedFrames = 0;
+    bool timingFrame = true;  // False while too many frames are in flight
+    int openDepth = 0;        // Scopes opened, including ignored nested ones
+    bool openTimed = false;   // Whether the outermost open scope has a query running
+
+    std::vector<Scope> current;
+    std::deque<std::vector<Scope>> inFlight;  // Oldest first
+    std::vector<GLuint> freeQueries;
+    std::vector<GLuint> allQueries;
+    std::map<std::string, Accumulator> accumulators;
+};
+
+#endif /* GpuTimer_hpp */
@@ -0,0 +1,351 @@
+//
+//  InputJournal.cpp
+//  orgb
+//
+
+#include "InputJournal.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifndef __EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define INPUT_JOURNAL_HEADER_BYTES 32
+#define INPUT_JOURNAL_RECORD_HEADER_BYTES 16
+#define INPUT_JOURNAL_FLAG_EPHEMERAL 0x1
+#define INPUT_JOURNAL_WRITE_BUFFER_BYTES (64 * 1024)
+
+// Explicitly little-endian, so journals move between hosts
+static void put16(std::vector<uint8_t> & out, uint16_t value) {
+    out.push_back(value & 0xff);
+    out.push_back(value >> 8);
+}
+
+static void put32(std::vector<uint8_t> & out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back((value >> shift) & 0xff);
+    }
+}
+
+static void put64(std::vector<uint8_t> & out, uint64_t value) {
+    for (int shift = 0; shift < 64; shift += 8) {
+        out.push_back((value >> shift) & 0xff);
+    }
+}
+
+static uint64_t get(const uint8_t * bytes, int count) {
+    uint64_t value = 0;
+    for (int i = count - 1; i >= 0; i--) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+// A field that fits the fixed-size records. Anything else sends the message down the MessagePack path.
+static bool byteField(const ofJson & j, const char * key, uint8_t & out) {
+    auto it = j.find(key);
+    if (it == j.end() || !it->is_number_integer() || *it < 0 || *it > 255) {
+        return false;
+    }
+    out = it->get<uint8_t>();
+    return true;
+}
+
+// ============================================================================
+// InputJournalEvent
+// ============================================================================
+
+ofJson InputJournalEvent::json() const {
+    switch (kind) {
+        case InputJournalKind::NOTE_ON: {
+            ofJson j = {{"type", "note_on"},
+                        {"note", body[0]},
+                        {"velocity", body[1]},
+                        {"channel", body[2]},
+                        {"id", static_cast<uint32_t>(get(body + 4, 4))}};
+            if (body[3] & INPUT_JOURNAL_FLAG_EPHEMERAL) {
+                j["ephemeral"] = true;
+            }
+            return j;
+        }
+        case InputJournalKind::NOTE_OFF:
+            return {{"type", "note_off"}, {"note", body[0]}, {"velocity", body[1]}, {"channel", body[2]}};
+        case InputJournalKind::CONTROL_CHANGE:
+            return {{"type", "control_change"}, {"control", body[0]}, {"value", body[1]}, {"channel", body[2]}};
+        case InputJournalKind::EPHEMERAL:
+            return ofJson::from_msgpack(body + 4, body + bodyBytes);
+        case InputJournalKind::SETTINGS:
+            return ofJson::parse(body, body + bodyBytes);
+        default:
+            return ofJson::from_msgpack(body, body + bodyBytes);
+    }
+}
+
+uint32_t InputJournalEvent::messageId() const { return static_cast<uint32_t>(get(body, 4)); }
+
+std::string InputJournalEvent::text() const { return std::string(reinterpret_cast<const char *>(body), bodyBytes); }
+
+// ============================================================================
+// InputJournalWriter
+// ============================================================================
+
+InputJournalWriter::~InputJournalWriter() { close(); }
+
+bool InputJournalWriter::open(const std::string & path, uint64_t startUnixUs) {
+    close();
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        ofLogError("InputJournal") << "Could not open " << path << ": " << strerror(errno);
+        return false;
+    }
+    setvbuf(file, nullptr, _IOFBF, INPUT_JOURNAL_WRITE_BUFFER_BYTES);
+    opened = std::chrono::steady_clock::now();
+    if (startUnixUs == 0) {
+        startUnixUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+    }
+    records = 0;
+
+    std::vector<uint8_t> header(INPUT_JOURNAL_MAGIC, INPUT_JOURNAL_MAGIC + 8);
+    put32(header, INPUT_JOURNAL_VERSION);
+    put32(header, INPUT_JOURNAL_HEADER_BYTES);
+    put64(header, startUnixUs);
+    put64(header, 0);
+    fwrite(header.data(), 1, header.size(), file);
+    ofLogNotice("InputJournal") << "Recording input to " << path;
+    return true;
+}
+
+void InputJournalWriter::close() {
+    if (file == nullptr) {
+        return;
+    }
+    fclose(file);
+    file = nullptr;
+    ofLogNotice("InputJournal") << "Recorded " << records << " events";
+}
+
+void InputJournalWriter::flush() {
+    if (file != nullptr) {
+        fflush(file);
+    }
+}
+
+void InputJournalWriter::append(InputJournalKind kind, int64_t timeUs, const uint8_t * body, size_t bodyBytes) {
+    if (file == nullptr) {
+        return;
+    }
+    if (timeUs < 0) {
+        timeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - opened)
+                     .count();
+    }
+    std::vector<uint8_t> header;
+    header.reserve(INPUT_JOURNAL_RECORD_HEADER_BYTES);
+    put32(header, static_cast<uint32_t>(INPUT_JOURNAL_RECORD_HEADER_BYTES + bodyBytes));
+    put16(header, static_cast<uint16_t>(kind));
+    put16(header, 0);
+    put64(header, static_cast<uint64_t>(timeUs));
+    fwrite(header.data(), 1, header.size(), file);
+    fwrite(body, 1, bodyBytes, file);
+    records++;
+}
+
+void InputJournalWriter::recordMidi(const ofJson & j, int64_t timeUs) {
+    if (file == nullptr) {
+        return;  // Not recording; skip the encoding too
+    }
+    std::string type = j.is_object() ? j.value("type", "") : "";
+    uint8_t a = 0;
+    uint8_t b = 0;
+    uint8_t channel = 0;
+    packed.clear();
+
+    if (type == "note_on" && byteField(j, "note", a) && byteField(j, "velocity", b) && j.contains("id") &&
+        j["id"].is_number_integer() && j["id"] >= 0 && j["id"] <= UINT32_MAX) {
+        if (j.contains("channel")) {
+            byteField(j, "channel", channel);
+        }
+        bool ephemeral = j.value("ephemeral", false);
+        packed = {a, b, channel, static_cast<uint8_t>(ephemeral ? INPUT_JOURNAL_FLAG_EPHEMERAL : 0)};
+        put32(packed, j["id"].get<uint32_t>());
+        append(InputJournalKind::NOTE_ON, timeUs, packed.data(), packed.size());
+    } else if (type == "note_off" && byteField(j, "note", a) && byteField(j, "channel", channel)) {
+        byteField(j, "velocity", b);
+        packed = {a, b, channel, 0};
+        append(InputJournalKind::NOTE_OFF, timeUs, packed.data(), packed.size());
+    } else if (type == "control_change" && byteField(j, "control", a) && byteField(j, "value", b) &&
+               byteField(j, "channel", channel)) {
+        packed = {a, b, channel, 0};
+        append(InputJournalKind::CONTROL_CHANGE, timeUs, packed.data(), packed.size());
+    } else {
+        recordJson(InputJournalKind::MIDI, j, timeUs);
+    }
+}
+
+void InputJournalWriter::recordEphemeral(const ofJson & j, uint32_t messageId, int64_t timeUs) {
+    if (file == nullptr) {
+        return;
+    }
+    packed.clear();
+    put32(packed, messageId);
+    ofJson::to_msgpack(j, packed);
+    append(InputJournalKind::EPHEMERAL, timeUs, packed.data(), packed.size());
+}
+
+void InputJournalWriter::recordJson(InputJournalKind kind, const ofJson & j, int64_t timeUs) {
+    if (file == nullptr) {
+        return;
+    }
+    packed.clear();
+    ofJson::to_msgpack(j, packed);
+    append(kind, timeUs, packed.data(), packed.size());
+}
+
+void InputJournalWriter::recordSettings(const std::string & payload, int64_t timeUs) {
+    append(InputJournalKind::SETTINGS, timeUs, reinterpret_cast<const uint8_t *>(payload.data()), payload.size());
+}
+
+// ============================================================================
+// InputJournalReader
+// ============================================================================
+
+InputJournalReader::~InputJournalReader() { close(); }
+
+bool InputJournalReader::isJournal(const std::string & path) {
+    char magic[8] = {};
+    FILE * file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    size_t read = fread(magic, 1, sizeof(magic), file);
+    fclose(file);
+    return read == sizeof(magic) && memcmp(magic, INPUT_JOURNAL_MAGIC, sizeof(magic)) == 0;
+}
+
+bool InputJournalReader::open(const std::string & path) {
+#ifdef __EMSCRIPTEN__
+    return false;
+#else
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        ofLogError("InputJournal") << "Could not open " << path << ": " << strerror(errno);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < INPUT_JOURNAL_HEADER_BYTES) {
+        ofLogError("InputJournal") << path << " is too short to be a journal";
+        ::close(fd);
+        return false;
+    }
+    void * mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        ofLogError("InputJournal") << "Could not map " << path << ": " << strerror(errno);
+        return false;
+    }
+
+    auto * bytes = static_cast<const uint8_t *>(mapped);
+    size_t header = get(bytes + 12, 4);
+    if (memcmp(bytes, INPUT_JOURNAL_MAGIC, 8) != 0 || get(bytes + 8, 4) != INPUT_JOURNAL_VERSION ||
+        header < INPUT_JOURNAL_HEADER_BYTES || header > static_cast<size_t>(info.st_size)) {
+        ofLogError("InputJournal") << path << " is not a journal this reader understands";
+        munmap(mapped, info.st_size);
+        return false;
+    }
+    data = bytes;
+    mappedBytes = info.st_size;
+    headerBytes = header;
+    startUnixUs = get(bytes + 16, 8);
+#ifdef MADV_SEQUENTIAL
+    madvise(mapped, mappedBytes, MADV_SEQUENTIAL);
+#endif
+
+    // One pass for the totals; the pages it touches are the ones replay reads next
+    rewind();
+    InputJournalEvent event;
+    uint64_t count = 0;
+    durationUs = 0;
+    while (next(event)) {
+        durationUs = std::max(durationUs, event.timeUs);
+        count++;
+    }
+    if (cursor != mappedBytes) {
+        ofLogWarning("InputJournal") << path << " ends in a truncated record, replaying the " << count
+                                     << " before it";
+    }
+    rewind();
+    ofLogNotice("InputJournal") << "Replaying " << count << " events over " << durationUs / 1e6 << " s from "
+                                << path;
+    return true;
+#endif
+}
+
+void InputJournalReader::close() {
+#ifndef __EMSCRIPTEN__
+    if (data != nullptr) {
+        munmap(const_cast<uint8_t *>(data), mappedBytes);
+        data = nullptr;
+        mappedBytes = 0;
+    }
+#endif
+}
+
+bool InputJournalReader::peek(InputJournalEvent & event) const {
+    if (data == nullptr || cursor + INPUT_JOURNAL_RECORD_HEADER_BYTES > mappedBytes) {
+        return false;
+    }
+    const uint8_t * record = data + cursor;
+    size_t bytes = get(record, 4);
+    if (bytes < INPUT_JOURNAL_RECORD_HEADER_BYTES || bytes > mappedBytes - cursor) {
+        return false;
+    }
+    event.kind = static_cast<InputJournalKind>(get(record + 4, 2));
+    event.timeUs = get(record + 8, 8);
+    event.body = record + INPUT_JOURNAL_RECORD_HEADER_BYTES;
+    event.bodyBytes = static_cast<uint32_t>(bytes - INPUT_JOURNAL_RECORD_HEADER_BYTES);
+
+    // The fixed-size kinds are read without further checks
+    switch (event.kind) {
+        case InputJournalKind::NOTE_ON:
+            return event.bodyBytes >= 8;
+        case InputJournalKind::NOTE_OFF:
+        case InputJournalKind::CONTROL_CHANGE:
+        case InputJournalKind::EPHEMERAL:
+            return event.bodyBytes >= 4;
+        default:
+            return true;
+    }
+}
+
+bool InputJournalReader::next(InputJournalEvent & event) {
+    if (!peek(event)) {
+        return false;
+    }
+    cursor += INPUT_JOURNAL_RECORD_HEADER_BYTES + event.bodyBytes;
+    return true;
+}
+
+size_t InputJournalReader::dispatchUntil(uint64_t timeUs, const std::function<void(const InputJournalEvent &)> & fn) {
+    size_t dispatched = 0;
+    InputJournalEvent event;
+    while (peek(event) && event.timeUs <= timeUs) {
+        cursor += INPUT_JOURNAL_RECORD_HEADER_BYTES + event.bodyBytes;
+        fn(event);
+        dispatched++;
+    }
+    return dispatched;
+}
+
+void InputJournalReader::rewind() { cursor = headerBytes; }
+
+bool InputJournalReader::isFinished() const {
+    InputJournalEvent event;
+    return !peek(event);
+}
@@ -0,0 +1,127 @@
+//
+//  InputJournal.hpp
+//  orgb
+//
+//  An append-only binary journal of every decoded input event, for reproducing a performance exactly. Events are
+//  recorded where the JSON handlers receive them, so MQTT and OSC traffic land in the same journal, and are replayed
+//  through the same handlers.
+//
+//  Layout, all integers little-endian:
+//
+//    Header (32 bytes): magic "ORGBJNL1", u32 version, u32 header bytes, u64 start (us since the Unix epoch),
+//                       u64 reserved
+//    Records:           u32 record bytes (header included), u16 kind, u16 reserved, u64 time (us since start),
+//                       then the body
+//
+//  Notes and control changes, nearly all of the traffic, have fixed 4 or 8 byte bodies. Everything else keeps its
+//  JSON, packed as MessagePack. A record cut short by a crash ends the journal; everything before it replays.
+//
+//  The reader maps the file rather than reading it, so a replay allocates nothing per event that it does not
+//  decode into JSON.
+//
+
+#ifndef InputJournal_hpp
+#define InputJournal_hpp
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ofMain.h"
+
+#define INPUT_JOURNAL_MAGIC "ORGBJNL1"
+#define INPUT_JOURNAL_VERSION 1
+
+enum class InputJournalKind : uint16_t {
+    NOTE_ON = 1,         // note, velocity, channel, flags (bit 0: ephemeral), u32 id
+    NOTE_OFF = 2,        // note, velocity, channel, 0
+    CONTROL_CHANGE = 3,  // control, value, channel, 0. Sustain is control 64.
+    MIDI = 4,            // Any other MIDI handler message, as MessagePack
+    EPHEMERAL = 5,       // u32 message id, then the note to velocity map as MessagePack
+    CLASSIFICATION = 6,  // MessagePack
+    PARAM = 7,           // MessagePack
+    OFPARAM = 8,         // MessagePack
+    SETTINGS = 9,        // JSON text, exactly as received
+};
+
+struct InputJournalEvent {
+    uint64_t timeUs;  // Since the journal started
+    InputJournalKind kind;
+    const uint8_t * body;  // Into the mapped file
+    uint32_t bodyBytes;
+
+    // The handler's JSON, rebuilt for the fixed-size kinds. Throws nlohmann's exceptions on a corrupt body.
+    [[nodiscard]] ofJson json() const;
+    [[nodiscard]] uint32_t messageId() const;  // EPHEMERAL only
+    [[nodiscard]] std::string text() const;    // SETTINGS only
+};
+
+class InputJournalWriter {
+   public:
+    InputJournalWriter() = default;
+    ~InputJournalWriter();
+
+    InputJournalWriter(const InputJournalWriter &) = delete;
+    InputJournalWriter & operator=(const InputJournalWriter &) = delete;
+
+    // Truncates any existing file. startUnixUs defaults to now.
+    bool open(const std::string & path, uint64_t startUnixUs = 0);
+    void close();
+    void flush();  // Records are buffered; call once a frame so a crash loses at most that frame's events
+
+    // Each takes the event's time in microseconds since the start, or the time since open() when negative
+    void recordMidi(const ofJson & j, int64_t timeUs = -1);
+    void recordEphemeral(const ofJson & j, uint32_t messageId, int64_t timeUs = -1);
+    void recordJson(InputJournalKind kind, const ofJson & j, int64_t timeUs = -1);
+    void recordSettings(const std::string & payload, int64_t timeUs = -1);
+
+    [[nodiscard]] bool isOpen() const { return file != nullptr; }
+    [[nodiscard]] uint64_t getRecordCount() const { return records; }
+
+   private:
+    void append(InputJournalKind kind, int64_t timeUs, const uint8_t * body, size_t bodyBytes);
+
+    FILE * file = nullptr;
+    std::chrono::steady_clock::time_point opened;
+    uint64_t records = 0;
+    std::vector<uint8_t> packed;
+};
+
+class InputJournalReader {
+   public:
+    InputJournalReader() = default;
+    ~InputJournalReader();
+
+    InputJournalReader(const InputJournalReader &) = delete;
+    InputJournalReader & operator=(const InputJournalReader &) = delete;
+
+    static bool isJournal(const std::string & path);
+
+    bool open(const std::string & path);
+    void close();
+
+    // Decode the record at the cursor. Returns false at the end, or at a truncated or corrupt record.
+    bool peek(InputJournalEvent & event) const;
+    bool next(InputJournalEvent & event);
+    // Call fn for every event at or before timeUs not yet replayed, in order. Returns the number replayed.
+    size_t dispatchUntil(uint64_t timeUs, const std::function<void(const InputJournalEvent &)> & fn);
+    void rewind();
+
+    [[nodiscard]] bool isOpen() const { return data != nullptr; }
+    [[nodiscard]] bool isFinished() const;
+    [[nodiscard]] uint64_t getStartUnixUs() const { return startUnixUs; }
+    [[nodiscard]] uint64_t getDurationUs() const { return durationUs; }  // Time of the last complete record
+
+   private:
+    const uint8_t * data = nullptr;
+    size_t mappedBytes = 0;
+    size_t headerBytes = 0;
+    size_t cursor = 0;
+    uint64_t startUnixUs = 0;
+    uint64_t durationUs = 0;
+};
+
+#endif /* InputJournal_hpp */
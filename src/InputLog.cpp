@@ -0,0 +1,131 @@
+//
+//  InputLog.cpp
+//  orgb
+//
+
+#include "InputLog.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "ofMain.h"
+
+// Seconds since the Unix epoch of a UTC calendar time. timegm is not standard, so count days directly.
+static double utcSeconds(const std::tm & t) {
+    int year = t.tm_year + 1900;
+    int month = t.tm_mon + 1;
+    // Days from civil (Howard Hinnant), with March as the first month of the year
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + t.tm_mday - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    double days = era * 146097.0 + dayOfEra - 719468;
+    return days * 86400 + t.tm_hour * 3600 + t.tm_min * 60 + t.tm_sec;
+}
+
+// "2022-09-08T20:19:41-0700" or "2022-09-09 03:19:41.168939" (UTC)
+static bool parseTimestamp(const std::string & text, double & seconds) {
+    std::tm t = {};
+    std::istringstream stream(text);
+    stream >> std::get_time(&t, text.find('T') != std::string::npos ? "%Y-%m-%dT%H:%M:%S" : "%Y-%m-%d %H:%M:%S");
+    if (stream.fail()) {
+        return false;
+    }
+    seconds = utcSeconds(t);
+
+    std::string rest;
+    std::getline(stream, rest);
+    size_t i = 0;
+    if (i < rest.size() && rest[i] == '.') {
+        size_t start = ++i;
+        while (i < rest.size() && isdigit(static_cast<unsigned char>(rest[i]))) {
+            i++;
+        }
+        seconds += std::stod("0." + rest.substr(start, i - start));
+    }
+    if (i < rest.size() && (rest[i] == '+' || rest[i] == '-') && rest.size() >= i + 5) {
+        int hours = std::stoi(rest.substr(i + 1, 2));
+        int minutes = std::stoi(rest.substr(i + 3, 2));
+        int sign = rest[i] == '-' ? -1 : 1;
+        seconds -= sign * (hours * 3600 + minutes * 60);  // Local to UTC
+    }
+    return true;
+}
+
+bool InputLog::parseLine(const std::string & line, InputEvent & event) {
+    size_t firstSpace = line.find(' ');
+    size_t secondSpace = firstSpace == std::string::npos ? firstSpace : line.find(' ', firstSpace + 1);
+    if (secondSpace == std::string::npos) {
+        return false;
+    }
+    if (!parseTimestamp(line.substr(0, firstSpace), event.timeS)) {
+        return false;
+    }
+    event.topic = line.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+    event.payload = line.substr(secondSpace + 1);
+
+    ofJson payload = ofJson::parse(event.payload, nullptr, false);
+    if (payload.is_discarded()) {
+        return false;
+    }
+    if (payload.is_object() && payload.contains("midi_read_time") && payload["midi_read_time"].is_string()) {
+        double readTime = 0;
+        if (parseTimestamp(payload["midi_read_time"].get<std::string>(), readTime)) {
+            event.timeS = readTime;
+        }
+    }
+    return true;
+}
+
+bool InputLog::loadText(const std::string & path) {
+    std::ifstream file(path);
+    if (!file) {
+        ofLogError("InputLog") << "Could not read " << path;
+        return false;
+    }
+    std::vector<InputEvent> loaded;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty()) {
+            continue;
+        }
+        InputEvent event;
+        if (parseLine(line, event)) {
+            loaded.push_back(std::move(event));
+        } else {
+            ofLogWarning("InputLog") << path << ":" << lineNumber << ": skipping unparseable line";
+        }
+    }
+    setEvents(std::move(loaded));
+    ofLogNotice("InputLog") << "Loaded " << events.size() << " events over " << getDurationS() << " s from " << path;
+    return true;
+}
+
+void InputLog::setEvents(std::vector<InputEvent> newEvents) {
+    events = std::move(newEvents);
+    cursor = 0;
+    // Stable, so events logged in the same instant keep their order
+    std::stable_sort(events.begin(), events.end(),
+                     [](const InputEvent & a, const InputEvent & b) { return a.timeS < b.timeS; });
+    if (!events.empty()) {
+        double start = events.front().timeS;
+        for (auto & event : events) {
+            event.timeS -= start;
+        }
+    }
+}
+
+size_t InputLog::dispatchUntil(double timeS, const std::function<void(const InputEvent &)> & fn) {
+    size_t dispatched = 0;
+    while (cursor < events.size() && events[cursor].timeS <= timeS) {
+        fn(events[cursor++]);
+        dispatched++;
+    }
+    return dispatched;
+}
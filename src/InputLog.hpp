@@ -0,0 +1,50 @@
+//
+//  InputLog.hpp
+//  orgb
+//
+//  A recorded sequence of input messages, replayed against a clock. Text logs hold one bus message per line, as
+//  captured from MQTT (see pedal.txt):
+//
+//    2022-09-08T20:19:41-0700 midi {"type": "control_change", ..., "midi_read_time": "2022-09-09 03:19:41.168939"}
+//
+//  An event's time is its payload's midi_read_time (UTC, microseconds) when present, otherwise the line's stamp
+//  (seconds). Times are stored relative to the first event.
+//
+
+#ifndef InputLog_hpp
+#define InputLog_hpp
+
+#include <functional>
+#include <string>
+#include <vector>
+
+struct InputEvent {
+    double timeS;  // Since the first event of the log
+    std::string topic;
+    std::string payload;
+};
+
+class InputLog {
+   public:
+    // Replaces the current events. Unparseable lines are skipped with a warning. Returns false if the file could
+    // not be read.
+    bool loadText(const std::string & path);
+    void setEvents(std::vector<InputEvent> events);  // Sorts them and makes the times relative
+
+    // Parse one line, with timeS in seconds since the Unix epoch
+    static bool parseLine(const std::string & line, InputEvent & event);
+
+    // Call fn for every event at or before timeS not yet dispatched, in order. Returns the number dispatched.
+    size_t dispatchUntil(double timeS, const std::function<void(const InputEvent &)> & fn);
+    void rewind() { cursor = 0; }
+
+    [[nodiscard]] const std::vector<InputEvent> & getEvents() const { return events; }
+    [[nodiscard]] double getDurationS() const { return events.empty() ? 0 : events.back().timeS; }
+    [[nodiscard]] bool isFinished() const { return cursor >= events.size(); }
+
+   private:
+    std::vector<InputEvent> events;
+    size_t cursor = 0;
+};
+
+#endif /* InputLog_hpp */
@@ -35,11 +35,27 @@ class KeyState {
     const std::list<Press> & allPresses();
     const std::multimap<int, Press> allPressesChromaticGrouped();
     std::list<Press> activePresses();
+    // activePresses() without the copy: visit(const Press &) for each unreleased press, in place
+    template <typename Visitor>
+    void forEachActivePress(Visitor visit) const {
+        for (const auto & press : presses) {
+            if (!press.getReleaseTime().has_value()) {
+                visit(press);
+            }
+        }
+    }
 
     std::unordered_map<int, Press> ephemeralPresses;
     void decayEphemeralKeypressAmplitudes(double deltaTime);
 
     const std::list<Press> allEphemeralPresses();
+    // allEphemeralPresses() without the copy
+    template <typename Visitor>
+    void forEachEphemeralPress(Visitor visit) const {
+        for (const auto & pair : ephemeralPresses) {
+            visit(pair.second);
+        }
+    }
     const std::multimap<int, Press> allEphemeralPressesChromaticGrouped();
 
     std::optional<double> sustainTimeS;
@@ -0,0 +1,95 @@
+//
+//  LedOutput.cpp
+//  orgb
+//
+
+#include "LedOutput.hpp"
+
+#include <sstream>
+
+#include "FrameProfiler.hpp"
+
+LedOutput::~LedOutput() { stop(); }
+
+void LedOutput::start(Sink newSink, double refreshHz) {
+    stop();
+    if (refreshHz <= 0) {
+        ofLogError("LedOutput") << "Refresh rate must be positive, got " << refreshHz;
+        return;
+    }
+    sink = std::move(newSink);
+    period = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / refreshHz));
+    running = true;
+    thread = std::thread(&LedOutput::run, this);
+    ofLogNotice("LedOutput") << "Output thread started at " << refreshHz << " Hz";
+}
+
+void LedOutput::stop() {
+    if (!thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wake.notify_all();
+    thread.join();
+    ofLogNotice("LedOutput") << "Output thread stopped. " << getSummary();
+}
+
+void LedOutput::submit(const ofPixels & pixels) {
+    // Same size as last time, so this copies without reallocating
+    frames.writeBuffer() = pixels;
+    submitted++;
+    if (frames.publish()) {
+        dropped++;
+    }
+}
+
+void LedOutput::toRgb(const ofPixels & source, ofPixels & rgb) {
+    size_t width = source.getWidth();
+    size_t height = source.getHeight();
+    if (rgb.getWidth() != width || rgb.getHeight() != height || rgb.getNumChannels() != 3) {
+        rgb.allocate(width, height, OF_PIXELS_RGB);
+    }
+    size_t channels = source.getNumChannels();
+    const unsigned char * from = source.getData();
+    unsigned char * to = rgb.getData();
+    for (size_t i = 0; i < width * height; i++, from += channels, to += 3) {
+        to[0] = from[0];
+        to[1] = from[1];
+        to[2] = from[2];
+    }
+}
+
+void LedOutput::run() {
+    FrameProfiler::setThreadName("LED Output");
+    bool haveFrame = false;
+    auto next = std::chrono::steady_clock::now();
+    while (running) {
+        if (frames.acquire()) {
+            haveFrame = true;
+            sent++;
+        } else if (haveFrame) {
+            repeated++;
+        }
+        if (haveFrame) {
+            PROFILE_ZONE("LED Output");
+            sink(frames.readBuffer());
+        }
+
+        next += period;
+        auto now = std::chrono::steady_clock::now();
+        if (next < now) {
+            next = now;  // Fell behind; refresh late rather than in a burst
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_until(lock, next, [this] { return !running; });
+    }
+}
+
+std::string LedOutput::getSummary() const {
+    std::stringstream ss;
+    ss << "LED: " << sent << " sent, " << dropped << " dropped, " << repeated << " repeated";
+    return ss.str();
+}
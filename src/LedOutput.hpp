@@ -0,0 +1,73 @@
+//
+//  LedOutput.hpp
+//  orgb
+//
+//  Sends frames to the LED panels from a thread of their own. The render thread submits each frame into a triple
+//  buffer and moves on; the output thread wakes at the panel refresh rate and hands the newest complete frame to the
+//  driver. A slow driver call (GPIO slowdown, a brightness change) therefore delays the panels, not the next render.
+//
+//  A frame replaced before the output thread took it is counted as dropped. A refresh with no new frame re-sends
+//  the last one and is counted as repeated.
+//
+
+#ifndef LedOutput_hpp
+#define LedOutput_hpp
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "TripleBuffer.hpp"
+#include "ofMain.h"
+
+class LedOutput {
+   public:
+    // Runs on the output thread. The pixels stay valid, and unchanged, until the call returns.
+    typedef std::function<void(ofPixels &)> Sink;
+
+    LedOutput() = default;
+    ~LedOutput();
+
+    LedOutput(const LedOutput &) = delete;
+    LedOutput & operator=(const LedOutput &) = delete;
+
+    void start(Sink sink, double refreshHz);
+    void stop();  // Waits for the sink call in progress, if any
+    [[nodiscard]] bool isRunning() const { return running; }
+
+    // Copy a frame in for the output thread. Never blocks; call from one thread only.
+    void submit(const ofPixels & pixels);
+
+    [[nodiscard]] uint64_t getSubmittedFrames() const { return submitted; }
+    [[nodiscard]] uint64_t getSentFrames() const { return sent; }
+    [[nodiscard]] uint64_t getDroppedFrames() const { return dropped; }
+    [[nodiscard]] uint64_t getRepeatedFrames() const { return repeated; }
+    [[nodiscard]] std::string getSummary() const;
+
+    // Drop the alpha the readback returns, for drivers that expect RGB. rgb is only reallocated when the size
+    // changes.
+    static void toRgb(const ofPixels & source, ofPixels & rgb);
+
+   private:
+    void run();
+
+    TripleBuffer<ofPixels> frames;
+    Sink sink;
+    std::chrono::nanoseconds period{0};
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::mutex wakeMutex;  // Lets stop() interrupt the wait between refreshes
+    std::condition_variable wake;
+
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> repeated{0};
+};
+
+#endif /* LedOutput_hpp */
@@ -0,0 +1,97 @@
+//
+//  PanelResolve.cpp
+//  orgb
+//
+
+#include "PanelResolve.hpp"
+
+#include "DrawContext.hpp"
+
+#define PANEL_RESOLVE_LUT_SIZE 256
+
+void PanelResolve::setup(int sourceWidth, int sourceHeight, int panelWidth, int panelHeight,
+                         int clockwiseRotations) {
+    rotations = ((clockwiseRotations % 4) + 4) % 4;
+    frame.allocate(sourceWidth, sourceHeight, GL_RGBA);
+    panel.allocate(panelWidth, panelHeight, GL_RGBA);
+    frame.begin();
+    ofClear(0, 0, 0, 255);
+    frame.end();
+
+    // A quarter turn swaps which source axis runs along the panel's width
+    bool quarterTurn = rotations % 2 == 1;
+    footprint = {static_cast<float>(sourceWidth) / (quarterTurn ? panelHeight : panelWidth),
+                 static_cast<float>(sourceHeight) / (quarterTurn ? panelWidth : panelHeight)};
+    if (footprint.x > 4 || footprint.y > 4) {
+        ofLogWarning("PanelResolve") << "Source is over 4x the panel size; the downscale will skip pixels";
+    }
+
+    shader = createShader("shaderPanelResolve");
+    if (!lut.isAllocated()) {
+        setLut(1.0, 1.0);
+    }
+    buildQuad();
+    ofLogNotice("PanelResolve") << "Resolving " << sourceWidth << "x" << sourceHeight << " to " << panelWidth << "x"
+                                << panelHeight << " panels, " << rotations << " clockwise rotations";
+}
+
+void PanelResolve::setLut(float gamma, float brightness) {
+    ofPixels curve;
+    curve.allocate(PANEL_RESOLVE_LUT_SIZE, 1, OF_PIXELS_RGB);
+    for (int i = 0; i < PANEL_RESOLVE_LUT_SIZE; i++) {
+        float value = brightness * powf(i / float(PANEL_RESOLVE_LUT_SIZE - 1), gamma);
+        curve.setColor(i, 0, ofColor(static_cast<unsigned char>(ofClamp(value * 255 + 0.5f, 0, 255))));
+    }
+    // A normalized texture in every GL version, so the shaders index it the same way
+    lut.allocate(PANEL_RESOLVE_LUT_SIZE, 1, GL_RGB, false);
+    lut.setTextureMinMagFilter(GL_NEAREST, GL_NEAREST);
+    lut.setTextureWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+    lut.loadData(curve);
+}
+
+void PanelResolve::buildQuad() {
+    // Where each panel corner samples the source, as fractions of the source with y down
+    auto sourceAt = [this](float s, float t) {
+        switch (rotations) {
+            case 1:
+                return glm::vec2(t, 1 - s);
+            case 2:
+                return glm::vec2(1 - s, 1 - t);
+            case 3:
+                return glm::vec2(1 - t, s);
+            default:
+                return glm::vec2(s, t);
+        }
+    };
+
+    quad.clear();
+    quad.setMode(OF_PRIMITIVE_TRIANGLE_STRIP);
+    const ofTexture & texture = frame.getTexture();
+    for (auto corner : {glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(0, 1), glm::vec2(1, 1)}) {
+        quad.addVertex({corner.x * panel.getWidth(), corner.y * panel.getHeight(), 0});
+        glm::vec2 source = sourceAt(corner.x, corner.y);
+        quad.addTexCoord(texture.getCoordFromPercent(source.x, source.y));
+    }
+}
+
+void PanelResolve::begin() { frame.begin(); }
+
+void PanelResolve::end() { frame.end(); }
+
+void PanelResolve::resolve() {
+    panel.begin();
+    ofPushStyle();
+    ofDisableAlphaBlending();
+    ofSetColor(255);
+    shader.begin();
+    {
+        shader.setUniformTexture("tex0", frame.getTexture(), 0);
+        shader.setUniformTexture("lut", lut, 1);
+        shader.setUniform2f("sourceDimensions", frame.getWidth(), frame.getHeight());
+        shader.setUniform2f("footprint", footprint);
+        quad.draw();
+    }
+    shader.end();
+    ofPopStyle();
+    panel.end();
+}
@@ -0,0 +1,50 @@
+//
+//  PanelResolve.hpp
+//  orgb
+//
+//  Final stage before the LED panels. The app composes each frame into a source-sized buffer (the window size,
+//  OFW_WIDTH x OFW_HEIGHT), which resolve() scales on the GPU to the exact panel resolution, rotating it and mapping
+//  each channel through a gamma/brightness LUT. Only the panel-sized buffer needs reading back, however large the
+//  source is, and the source size no longer has to match the panels.
+//
+//  Rotation follows the rpi-rgb-led-matrix Rotate mapper: the panel shows the source turned clockwise, so with one or
+//  three rotations a 32x160 source fills a 160x32 chain.
+//
+
+#ifndef PanelResolve_hpp
+#define PanelResolve_hpp
+
+#include "ofMain.h"
+
+class PanelResolve {
+   public:
+    void setup(int sourceWidth, int sourceHeight, int panelWidth, int panelHeight, int clockwiseRotations);
+
+    // out = 255 * brightness * (in / 255) ^ gamma, per channel. Identity by default; the driver applies its own
+    // luminance correction.
+    void setLut(float gamma, float brightness);
+
+    // Draw the frame between begin() and end(), as if to the screen
+    void begin();
+    void end();
+
+    // Scale, rotate and apply the LUT into the panel buffer. Rows are stored top-down, as in any OF FBO.
+    void resolve();
+
+    ofFbo & getFrame() { return frame; }
+    ofFbo & getPanel() { return panel; }
+    [[nodiscard]] int getClockwiseRotations() const { return rotations; }
+
+   private:
+    void buildQuad();
+
+    ofFbo frame;
+    ofFbo panel;
+    ofShader shader;
+    ofTexture lut;
+    ofMesh quad;
+    glm::vec2 footprint;  // Source pixels per panel pixel, along the source axes
+    int rotations = 0;
+};
+
+#endif /* PanelResolve_hpp */
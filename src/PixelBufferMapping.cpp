@@ -0,0 +1,49 @@
+//
+//  PixelBufferMapping.cpp
+//  orgb
+//
+
+#include "PixelBufferMapping.hpp"
+
+#include <cstring>
+
+#if defined(TARGET_OPENGLES) && !defined(__EMSCRIPTEN__)
+#include <EGL/egl.h>
+#endif
+
+#if defined(__EMSCRIPTEN__)
+static bool mappingAvailable() { return false; }
+void * mapPixelBuffer(GLenum, size_t, GLbitfield) { return nullptr; }
+void unmapPixelBuffer(GLenum) {}
+#elif defined(TARGET_OPENGLES)
+typedef void * (*MapBufferRangeFunction)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+typedef GLboolean (*UnmapBufferFunction)(GLenum);
+static MapBufferRangeFunction mapBufferRange() {
+    static auto function = reinterpret_cast<MapBufferRangeFunction>(eglGetProcAddress("glMapBufferRange"));
+    return function;
+}
+static UnmapBufferFunction unmapBuffer() {
+    static auto function = reinterpret_cast<UnmapBufferFunction>(eglGetProcAddress("glUnmapBuffer"));
+    return function;
+}
+static bool mappingAvailable() {
+    const GLubyte * version = glGetString(GL_VERSION);
+    bool es3 = version != nullptr && strncmp(reinterpret_cast<const char *>(version), "OpenGL ES 3", 11) == 0;
+    return es3 && mapBufferRange() != nullptr && unmapBuffer() != nullptr;
+}
+void * mapPixelBuffer(GLenum target, size_t bytes, GLbitfield access) {
+    return mapBufferRange()(target, 0, bytes, access);
+}
+void unmapPixelBuffer(GLenum target) { unmapBuffer()(target); }
+#else
+static bool mappingAvailable() { return glMapBufferRange != nullptr && glUnmapBuffer != nullptr; }
+void * mapPixelBuffer(GLenum target, size_t bytes, GLbitfield access) {
+    return glMapBufferRange(target, 0, bytes, access);
+}
+void unmapPixelBuffer(GLenum target) { glUnmapBuffer(target); }
+#endif
+
+bool pixelBufferMappingAvailable() {
+    static bool available = mappingAvailable();
+    return available;
+}
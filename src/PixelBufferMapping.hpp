@@ -0,0 +1,32 @@
+//
+//  PixelBufferMapping.hpp
+//  orgb
+//
+//  Mapping of pixel buffer objects into client memory, shared by PixelReadback (pack buffers) and StreamingTexture
+//  (unpack buffers). glMapBufferRange is core in desktop GL 3.0 and GLES 3; GLES 2 headers do not declare it and a
+//  GLES 2 context does not have it, so callers check pixelBufferMappingAvailable() and fall back to plain reads and
+//  uploads.
+//
+
+#ifndef PixelBufferMapping_hpp
+#define PixelBufferMapping_hpp
+
+#include "ofMain.h"
+
+// Same values in desktop GL and GLES 3
+#define PIXEL_PACK_BUFFER 0x88EB
+#define PIXEL_UNPACK_BUFFER 0x88EC
+#define STREAM_DRAW 0x88E0
+#define STREAM_READ 0x88E1
+#define MAP_READ_BIT 0x0001
+#define MAP_WRITE_BIT 0x0002
+#define MAP_INVALIDATE_BUFFER_BIT 0x0008
+
+// Needs a current context on first call; the answer is cached
+bool pixelBufferMappingAvailable();
+
+// Map the first `bytes` of the buffer bound to `target`. Returns nullptr on failure.
+void * mapPixelBuffer(GLenum target, size_t bytes, GLbitfield access);
+void unmapPixelBuffer(GLenum target);
+
+#endif /* PixelBufferMapping_hpp */
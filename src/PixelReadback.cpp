@@ -0,0 +1,105 @@
+//
+//  PixelReadback.cpp
+//  orgb
+//
+
+#include "PixelReadback.hpp"
+
+#include <cstring>
+
+#include "PixelBufferMapping.hpp"
+
+// Three buffers: one being written this frame, one possibly still in flight, one ready to read
+#define PIXEL_READBACK_RING_SIZE 3
+
+// ============================================================================
+// PixelReadback
+// ============================================================================
+
+PixelReadback::~PixelReadback() { release(); }
+
+bool PixelReadback::isAsynchronous() const { return pixelBufferMappingAvailable(); }
+
+int PixelReadback::getLatencyFrames() const { return isAsynchronous() ? PIXEL_READBACK_RING_SIZE - 1 : 0; }
+
+void PixelReadback::release() {
+    for (auto & slot : slots) {
+        glDeleteBuffers(1, &slot.buffer);
+    }
+    slots.clear();
+}
+
+void PixelReadback::allocate(int newWidth, int newHeight) {
+    release();
+    width = newWidth;
+    height = newHeight;
+    next = 0;
+    ready = false;
+    pixels.allocate(width, height, OF_PIXELS_RGBA);
+    size_t bytes = static_cast<size_t>(width) * height * 4;
+
+    if (!isAsynchronous()) {
+        scratch.resize(bytes);
+        ofLogNotice("PixelReadback") << "No pixel buffer mapping, reading " << width << "x" << height
+                                     << " synchronously";
+        return;
+    }
+    slots.resize(PIXEL_READBACK_RING_SIZE);
+    for (auto & slot : slots) {
+        glGenBuffers(1, &slot.buffer);
+        glBindBuffer(PIXEL_PACK_BUFFER, slot.buffer);
+        glBufferData(PIXEL_PACK_BUFFER, bytes, nullptr, STREAM_READ);
+    }
+    glBindBuffer(PIXEL_PACK_BUFFER, 0);
+    ofLogNotice("PixelReadback") << "Reading " << width << "x" << height << " through " << slots.size()
+                                 << " pixel buffers";
+}
+
+void PixelReadback::copyRows(const unsigned char * source) {
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    unsigned char * destination = pixels.getData();
+    for (int row = 0; row < height; row++) {
+        int target = flipVertical ? height - 1 - row : row;
+        memcpy(destination + target * rowBytes, source + row * rowBytes, rowBytes);
+    }
+}
+
+void PixelReadback::request(int x, int y, int requestWidth, int requestHeight) {
+    if (requestWidth <= 0 || requestHeight <= 0) {
+        return;
+    }
+    if (requestWidth != width || requestHeight != height) {
+        allocate(requestWidth, requestHeight);
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    if (slots.empty()) {
+        glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, scratch.data());
+        copyRows(scratch.data());
+        ready = true;
+        return;
+    }
+
+    // With a buffer bound, glReadPixels takes an offset and returns once the copy is queued
+    Slot & slot = slots[next];
+    glBindBuffer(PIXEL_PACK_BUFFER, slot.buffer);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    slot.pending = true;
+    next = (next + 1) % slots.size();
+
+    // The slot written next is the oldest, requested PIXEL_READBACK_RING_SIZE - 1 frames ago
+    Slot & oldest = slots[next];
+    if (oldest.pending) {
+        glBindBuffer(PIXEL_PACK_BUFFER, oldest.buffer);
+        const void * mapped = mapPixelBuffer(PIXEL_PACK_BUFFER, static_cast<size_t>(width) * height * 4, MAP_READ_BIT);
+        if (mapped != nullptr) {
+            copyRows(static_cast<const unsigned char *>(mapped));
+            unmapPixelBuffer(PIXEL_PACK_BUFFER);
+            ready = true;
+        }
+        oldest.pending = false;
+    }
+    glBindBuffer(PIXEL_PACK_BUFFER, 0);
+}
+
+ofPixels * PixelReadback::latest() { return ready ? &pixels : nullptr; }
@@ -0,0 +1,63 @@
+//
+//  PixelReadback.hpp
+//  orgb
+//
+//  Reads a framebuffer region back to the CPU without waiting for the GPU. Each request() issues glReadPixels
+//  into the next pixel buffer object of a ring, and the pixels returned are those requested PIXEL_READBACK_LATENCY
+//  frames earlier, by which time the copy has finished. ofImage::grabScreen, by contrast, reads synchronously, so
+//  the CPU waits for every queued draw, and reallocates the image each frame.
+//
+//  Mapping pixel pack buffers needs desktop GL 3 or GLES 3 (see PixelBufferMapping.hpp). On a GLES 2 context the
+//  read is synchronous, as before, but still lands in the same persistent buffer.
+//
+
+#ifndef PixelReadback_hpp
+#define PixelReadback_hpp
+
+#include <vector>
+
+#include "ofMain.h"
+
+class PixelReadback {
+   public:
+    PixelReadback() = default;
+    ~PixelReadback();
+
+    PixelReadback(const PixelReadback &) = delete;
+    PixelReadback & operator=(const PixelReadback &) = delete;
+
+    // Rows come back bottom-up from GL. The default screen wants flipping; OF's FBOs are already stored flipped.
+    void setFlipVertical(bool state) { flipVertical = state; }
+
+    // Queue a read of (x, y, width, height) from the bound read framebuffer, as RGBA. A size change restarts the
+    // ring.
+    void request(int x, int y, int width, int height);
+
+    // Newest completed frame, or nullptr while the ring fills. The buffer is persistent: it is overwritten in
+    // place by later calls and is never reallocated unless the size changes.
+    ofPixels * latest();
+
+    [[nodiscard]] bool isAsynchronous() const;
+    [[nodiscard]] int getLatencyFrames() const;
+
+   private:
+    struct Slot {
+        GLuint buffer = 0;
+        bool pending = false;
+    };
+
+    void allocate(int width, int height);
+    void release();
+    void copyRows(const unsigned char * source);
+
+    std::vector<Slot> slots;
+    size_t next = 0;  // Slot the next request writes
+    int width = 0;
+    int height = 0;
+    bool flipVertical = true;
+    bool ready = false;
+    ofPixels pixels;
+    std::vector<unsigned char> scratch;  // Synchronous path only
+};
+
+#endif /* PixelReadback_hpp */
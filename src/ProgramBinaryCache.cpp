@@ -0,0 +1,452 @@
+//
+//  ProgramBinaryCache.cpp
+//  orgb
+//
+
+#include "ProgramBinaryCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#if defined(TARGET_OPENGLES) && !defined(__EMSCRIPTEN__)
+#include <EGL/egl.h>
+#endif
+
+#define PROGRAM_BINARY_CACHE_MAGIC "ORGBPRG1"
+#define PROGRAM_BINARY_CACHE_MAX_INCLUDE_DEPTH 16
+// Same values for the core enums and the GL_OES_get_program_binary ones
+#define PROGRAM_BINARY_LENGTH 0x8741
+#define NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
+// ============================================================================
+// Entry points
+// ============================================================================
+
+#if defined(__EMSCRIPTEN__)
+// WebGL has no program binaries
+static bool binaryFunctionsAvailable() { return false; }
+static void getProgramBinary(GLuint, GLsizei, GLsizei *, GLenum *, void *) {}
+static void programBinary(GLuint, GLenum, const void *, GLsizei) {}
+#elif defined(TARGET_OPENGLES)
+// GL_OES_get_program_binary, which GLES2 only exposes through eglGetProcAddress
+typedef void (*GetProgramBinaryFunction)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+typedef void (*ProgramBinaryFunction)(GLuint, GLenum, const void *, GLint);
+static GetProgramBinaryFunction getProgramBinaryOES() {
+    static auto function = reinterpret_cast<GetProgramBinaryFunction>(eglGetProcAddress("glGetProgramBinaryOES"));
+    return function;
+}
+static ProgramBinaryFunction programBinaryOES() {
+    static auto function = reinterpret_cast<ProgramBinaryFunction>(eglGetProcAddress("glProgramBinaryOES"));
+    return function;
+}
+static bool binaryFunctionsAvailable() { return getProgramBinaryOES() != nullptr && programBinaryOES() != nullptr; }
+static void getProgramBinary(GLuint program, GLsizei bufferSize, GLsizei * length, GLenum * format, void * binary) {
+    getProgramBinaryOES()(program, bufferSize, length, format, binary);
+}
+static void programBinary(GLuint program, GLenum format, const void * binary, GLsizei length) {
+    programBinaryOES()(program, format, binary, length);
+}
+#else
+// GL 4.1 or ARB_get_program_binary, loaded by GLEW. A legacy 2.1 context on macOS has neither.
+static bool binaryFunctionsAvailable() { return glGetProgramBinary != nullptr && glProgramBinary != nullptr; }
+static void getProgramBinary(GLuint program, GLsizei bufferSize, GLsizei * length, GLenum * format, void * binary) {
+    glGetProgramBinary(program, bufferSize, length, format, binary);
+}
+static void programBinary(GLuint program, GLenum format, const void * binary, GLsizei length) {
+    glProgramBinary(program, format, binary, length);
+}
+#endif
+
+// ============================================================================
+// Stub shaders
+// ============================================================================
+
+// GLSL type for a uniform or attribute type, and an expression reading one float from a value of it, so the
+// stub keeps the variable active. Empty for types the stub cannot declare.
+static bool describeType(GLenum type, const std::string & value, std::string & glslType, std::string & read) {
+    bool programmable = ofIsGLProgrammableRenderer();
+#ifdef TARGET_OPENGLES
+    programmable = false;  // GLSL ES 1.00 has the GL2 spellings
+#endif
+    switch (type) {
+        case GL_FLOAT:
+            glslType = "float";
+            read = value;
+            return true;
+        case GL_FLOAT_VEC2:
+        case GL_FLOAT_VEC3:
+        case GL_FLOAT_VEC4:
+            glslType = type == GL_FLOAT_VEC2 ? "vec2" : type == GL_FLOAT_VEC3 ? "vec3" : "vec4";
+            read = value + ".x";
+            return true;
+        case GL_INT:
+            glslType = "int";
+            read = "float(" + value + ")";
+            return true;
+        case GL_INT_VEC2:
+        case GL_INT_VEC3:
+        case GL_INT_VEC4:
+            glslType = type == GL_INT_VEC2 ? "ivec2" : type == GL_INT_VEC3 ? "ivec3" : "ivec4";
+            read = "float(" + value + ".x)";
+            return true;
+        case GL_BOOL:
+            glslType = "bool";
+            read = "(" + value + " ? 1.0 : 0.0)";
+            return true;
+        case GL_FLOAT_MAT2:
+        case GL_FLOAT_MAT3:
+        case GL_FLOAT_MAT4:
+            glslType = type == GL_FLOAT_MAT2 ? "mat2" : type == GL_FLOAT_MAT3 ? "mat3" : "mat4";
+            read = value + "[0].x";
+            return true;
+        case GL_SAMPLER_2D:
+            glslType = "sampler2D";
+            read = (programmable ? "texture(" : "texture2D(") + value + ", vec2(0.0)).x";
+            return true;
+#ifndef TARGET_OPENGLES
+        case GL_SAMPLER_2D_RECT:
+            glslType = "sampler2DRect";
+            read = (programmable ? "texture(" : "texture2DRect(") + value + ", vec2(0.0)).x";
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+// Declaration name and read expression for a uniform or attribute as glGetActive* reports it. Arrays come back
+// as "name[0]" with size > 1.
+static bool describeVariable(GLenum type, GLint size, const std::string & activeName, std::string & declaration,
+                             std::string & read) {
+    std::string name = activeName.substr(0, activeName.find('['));
+    std::string glslType;
+    bool isArray = size > 1 || activeName.find('[') != std::string::npos;
+    std::string value = isArray ? name + "[" + ofToString(std::max(size, 1) - 1) + "]" : name;
+    if (!describeType(type, value, glslType, read)) {
+        return false;
+    }
+    declaration = glslType + " " + name + (isArray ? "[" + ofToString(std::max(size, 1)) + "]" : "") + ";";
+    return true;
+}
+
+static bool isBuiltIn(const std::string & name) { return name.compare(0, 3, "gl_") == 0; }
+
+// ============================================================================
+// ProgramBinaryCache
+// ============================================================================
+
+ProgramBinaryCache::ProgramBinaryCache(const std::string & directory, bool enabled)
+    : directory(directory), enabled(enabled) {}
+
+bool ProgramBinaryCache::isSupported() const {
+    if (!enabled || !binaryFunctionsAvailable()) {
+        return false;
+    }
+    GLint formats = 0;
+    glGetIntegerv(NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+std::string ProgramBinaryCache::expandIncludes(const std::string & path, int depth) {
+    if (depth > PROGRAM_BINARY_CACHE_MAX_INCLUDE_DEPTH) {
+        return "";
+    }
+    ofBuffer buffer = ofBufferFromFile(path);
+    std::stringstream result;
+    for (const auto & line : buffer.getLines()) {
+        size_t pragma = line.find("#pragma include");
+        if (pragma != std::string::npos) {
+            size_t open = line.find('"', pragma);
+            size_t close = line.find('"', open + 1);
+            if (open != std::string::npos && close != std::string::npos) {
+                std::filesystem::path included =
+                    std::filesystem::path(path).parent_path() / line.substr(open + 1, close - open - 1);
+                result << expandIncludes(included.lexically_normal().string(), depth + 1) << "\n";
+                continue;
+            }
+        }
+        result << line << "\n";
+    }
+    return result.str();
+}
+
+uint64_t ProgramBinaryCache::hash(const std::string & text) {
+    // FNV-1a
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+uint64_t ProgramBinaryCache::keyFor(const std::string & shaderDirectory, const std::string & shaderName,
+                                    const std::map<std::string, int> & intDefines) const {
+    std::stringstream description;
+    description << shaderDirectory << shaderName << "\n";
+    for (const auto & define : intDefines) {
+        description << "#define " << define.first << " " << define.second << "\n";
+    }
+    description << expandIncludes(shaderDirectory + shaderName + ".vert");
+    description << expandIncludes(shaderDirectory + shaderName + ".frag");
+    for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        const GLubyte * value = glGetString(name);
+        description << (value != nullptr ? reinterpret_cast<const char *>(value) : "") << "\n";
+    }
+    return hash(description.str());
+}
+
+std::string ProgramBinaryCache::pathFor(const std::string & fileName, uint64_t key) const {
+    std::stringstream name;
+    name << fileName << "-" << std::hex << key << ".bin";
+    return (std::filesystem::path(directory) / name.str()).string();
+}
+
+bool ProgramBinaryCache::load(ofShader & shader, const std::string & fileName, uint64_t key) {
+    if (!isSupported()) {
+        return false;
+    }
+    Entry entry;
+    if (!read(pathFor(fileName, key), entry) || entry.key != key) {
+        misses++;
+        return false;
+    }
+
+    if (!linkStub(shader, entry)) {
+        ofLogNotice("ProgramBinaryCache") << fileName << ": cached interface not reproducible, compiling";
+        shader.unload();
+        misses++;
+        return false;
+    }
+
+    GLuint program = shader.getProgram();
+    while (glGetError() != GL_NO_ERROR) {
+    }
+    programBinary(program, entry.format, entry.binary.data(), static_cast<GLsizei>(entry.binary.size()));
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    bool usable = glGetError() == GL_NO_ERROR && linked == GL_TRUE;
+
+    // ofShader looks uniforms up in the table it built from the stub, so that table must agree with the binary
+    for (size_t i = 0; usable && i < entry.uniforms.size(); i++) {
+        const std::string & name = entry.uniforms[i].name;
+        if (isBuiltIn(name)) continue;
+        std::string baseName = name.substr(0, name.find('['));
+        usable = shader.getUniformLocation(baseName) == glGetUniformLocation(program, baseName.c_str());
+    }
+
+    if (!usable) {
+        // Typically a driver update that kept the version string, which the driver reports as a link failure
+        ofLogNotice("ProgramBinaryCache") << fileName << ": cached binary rejected, compiling";
+        shader.unload();
+        misses++;
+        return false;
+    }
+    hits++;
+    ofLogVerbose("ProgramBinaryCache") << fileName << ": loaded from cache";
+    return true;
+}
+
+void ProgramBinaryCache::save(const ofShader & shader, const std::string & fileName, uint64_t key) {
+    if (!isSupported() || !shader.isLoaded()) {
+        return;
+    }
+    GLuint program = shader.getProgram();
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    GLint length = 0;
+    glGetProgramiv(program, PROGRAM_BINARY_LENGTH, &length);
+    if (linked != GL_TRUE || length <= 0) {
+        return;
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.binary.resize(length);
+    GLsizei written = 0;
+    getProgramBinary(program, length, &written, &entry.format, entry.binary.data());
+    entry.binary.resize(written);
+    if (written <= 0) {
+        return;
+    }
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    std::vector<char> name;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    name.resize(std::max(maxLength, 1));
+    for (GLint i = 0; i < count; i++) {
+        Variable variable;
+        GLsizei nameLength = 0;
+        glGetActiveUniform(program, i, name.size(), &nameLength, &variable.size, &variable.type, name.data());
+        variable.name.assign(name.data(), nameLength);
+        entry.uniforms.push_back(variable);
+    }
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+    name.resize(std::max(maxLength, 1));
+    for (GLint i = 0; i < count; i++) {
+        Variable variable;
+        GLsizei nameLength = 0;
+        glGetActiveAttrib(program, i, name.size(), &nameLength, &variable.size, &variable.type, name.data());
+        variable.name.assign(name.data(), nameLength);
+        entry.attributes.push_back(variable);
+    }
+
+    if (write(pathFor(fileName, key), entry)) {
+        ofLogVerbose("ProgramBinaryCache") << fileName << ": saved " << written << " bytes";
+    }
+}
+
+bool ProgramBinaryCache::linkStub(ofShader & shader, const Entry & entry) const {
+    std::stringstream vertex;
+    std::stringstream fragment;
+    bool programmable = ofIsGLProgrammableRenderer();
+#ifdef TARGET_OPENGLES
+    vertex << "precision highp float;\n";
+    fragment << "precision highp float;\n";
+    programmable = false;
+#else
+    vertex << (programmable ? "#version 150\n" : "#version 120\n");
+    fragment << (programmable ? "#version 150\nout vec4 outputColor;\n" : "#version 120\n");
+#endif
+
+    std::string vertexSum = "0.0";
+    for (const auto & attribute : entry.attributes) {
+        if (isBuiltIn(attribute.name)) continue;
+        std::string declaration;
+        std::string read;
+        if (!describeVariable(attribute.type, attribute.size, attribute.name, declaration, read)) {
+            return false;
+        }
+        vertex << (programmable ? "in " : "attribute ") << declaration << "\n";
+        vertexSum += " + " + read;
+    }
+    vertex << "void main() { gl_Position = vec4(" << vertexSum << "); }\n";
+
+    // Every uniform goes in the fragment stage. Only the names matter to ofShader's table, not the stage.
+    std::string fragmentSum = "0.0";
+    for (const auto & uniform : entry.uniforms) {
+        if (isBuiltIn(uniform.name)) continue;
+        std::string declaration;
+        std::string read;
+        if (!describeVariable(uniform.type, uniform.size, uniform.name, declaration, read)) {
+            return false;
+        }
+        fragment << "uniform " << declaration << "\n";
+        fragmentSum += " + " + read;
+    }
+    fragment << "void main() { " << (programmable ? "outputColor" : "gl_FragColor") << " = vec4(" << fragmentSum
+             << "); }\n";
+
+    // Stub failures are expected to be rare and are handled by compiling the real source
+    ofLogLevel previousLevel = ofGetLogLevel("ofShader");
+    ofSetLogLevel("ofShader", OF_LOG_FATAL_ERROR);
+    bool ok = shader.setupShaderFromSource(GL_VERTEX_SHADER, vertex.str()) &&
+              shader.setupShaderFromSource(GL_FRAGMENT_SHADER, fragment.str());
+    if (ok && ofIsGLProgrammableRenderer()) {
+        shader.bindDefaults();
+    }
+    ok = ok && shader.linkProgram();
+    ofSetLogLevel("ofShader", previousLevel);
+    return ok;
+}
+
+// ============================================================================
+// File format: magic, key, format, uniform and attribute tables, binary
+// ============================================================================
+
+template <typename T>
+static void writeValue(std::ofstream & out, const T & value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readValue(std::ifstream & in, T & value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+bool ProgramBinaryCache::write(const std::string & path, const Entry & entry) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        ofLogWarning("ProgramBinaryCache") << "Can't create " << directory << ": " << error.message();
+        return false;
+    }
+
+    // Write to a temporary name and rename, so a crash mid-write never leaves a truncated entry
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(PROGRAM_BINARY_CACHE_MAGIC, strlen(PROGRAM_BINARY_CACHE_MAGIC));
+        writeValue(out, entry.key);
+        writeValue(out, static_cast<uint32_t>(entry.format));
+        for (const auto * variables : {&entry.uniforms, &entry.attributes}) {
+            writeValue(out, static_cast<uint32_t>(variables->size()));
+            for (const auto & variable : *variables) {
+                writeValue(out, static_cast<uint32_t>(variable.type));
+                writeValue(out, static_cast<int32_t>(variable.size));
+                writeValue(out, static_cast<uint32_t>(variable.name.size()));
+                out.write(variable.name.data(), variable.name.size());
+            }
+        }
+        writeValue(out, static_cast<uint32_t>(entry.binary.size()));
+        out.write(entry.binary.data(), entry.binary.size());
+        if (!out) {
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    return !error;
+}
+
+bool ProgramBinaryCache::read(const std::string & path, Entry & entry) const {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    char magic[sizeof(PROGRAM_BINARY_CACHE_MAGIC) - 1];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, PROGRAM_BINARY_CACHE_MAGIC, sizeof(magic)) != 0) {
+        return false;
+    }
+    uint32_t format = 0;
+    if (!readValue(in, entry.key) || !readValue(in, format)) {
+        return false;
+    }
+    entry.format = format;
+    for (auto * variables : {&entry.uniforms, &entry.attributes}) {
+        uint32_t count = 0;
+        if (!readValue(in, count) || count > 4096) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t type = 0;
+            int32_t size = 0;
+            uint32_t nameLength = 0;
+            if (!readValue(in, type) || !readValue(in, size) || !readValue(in, nameLength) || nameLength > 1024) {
+                return false;
+            }
+            Variable variable;
+            variable.type = type;
+            variable.size = size;
+            variable.name.resize(nameLength);
+            if (!in.read(&variable.name[0], nameLength)) {
+                return false;
+            }
+            variables->push_back(variable);
+        }
+    }
+    uint32_t length = 0;
+    if (!readValue(in, length) || length == 0 || length > (64u << 20)) {
+        return false;
+    }
+    entry.binary.resize(length);
+    return static_cast<bool>(in.read(entry.binary.data(), length));
+}
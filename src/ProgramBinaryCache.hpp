@@ -0,0 +1,75 @@
+//
+//  ProgramBinaryCache.hpp
+//  orgb
+//
+//  On-disk cache of linked GL programs (glGetProgramBinary / glProgramBinaryOES), so startup and every
+//  DrawManager rebuild skip compiling the shaders from source. Entries are keyed by a hash of the expanded
+//  sources, the defines and the driver strings, so editing a shader or updating the driver misses and
+//  recompiles.
+//
+//  ofShader can only link from attached shaders and caches uniform locations when it does. A hit therefore
+//  links a stub with the same uniforms first, so ofShader has a program and a uniform table, then loads the
+//  binary into that program and checks every location ofShader cached against the binary. Any mismatch, and
+//  any GL error, unloads the shader and the caller compiles from source as before.
+//
+
+#ifndef ProgramBinaryCache_hpp
+#define ProgramBinaryCache_hpp
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ofMain.h"
+
+class ProgramBinaryCache {
+   public:
+    // directory is created on first save. A disabled cache never loads or saves.
+    ProgramBinaryCache(const std::string & directory, bool enabled);
+    ~ProgramBinaryCache() = default;
+
+    // Key for shaderName in directory (e.g. "shadersES2/") from its expanded sources, defines and the driver
+    [[nodiscard]] uint64_t keyFor(const std::string & directory, const std::string & shaderName,
+                                  const std::map<std::string, int> & intDefines) const;
+
+    // Fill shader from the cache. Returns false on a miss or if the entry cannot be used; shader is then
+    // unloaded and ready to be compiled from source. fileName identifies the variant, e.g. "shaderBlurX".
+    bool load(ofShader & shader, const std::string & fileName, uint64_t key);
+    // Store a shader that was just compiled and linked from source
+    void save(const ofShader & shader, const std::string & fileName, uint64_t key);
+
+    [[nodiscard]] bool isSupported() const;
+    [[nodiscard]] int getHits() const { return hits; }
+    [[nodiscard]] int getMisses() const { return misses; }
+
+    // Source with #pragma include lines replaced by the included files, resolved relative to the including file
+    static std::string expandIncludes(const std::string & path, int depth = 0);
+    static uint64_t hash(const std::string & text);
+
+   private:
+    struct Variable {
+        GLenum type;
+        GLint size;
+        std::string name;
+    };
+    struct Entry {
+        uint64_t key;
+        GLenum format;
+        std::vector<Variable> uniforms;
+        std::vector<Variable> attributes;
+        std::vector<char> binary;
+    };
+
+    [[nodiscard]] std::string pathFor(const std::string & fileName, uint64_t key) const;
+    bool read(const std::string & path, Entry & entry) const;
+    bool write(const std::string & path, const Entry & entry) const;
+    bool linkStub(ofShader & shader, const Entry & entry) const;
+
+    std::string directory;
+    bool enabled;
+    int hits = 0;
+    int misses = 0;
+};
+
+#endif /* ProgramBinaryCache_hpp */
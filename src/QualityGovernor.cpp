@@ -0,0 +1,202 @@
+//
+//  QualityGovernor.cpp
+//  orgb
+//
+
+#include "QualityGovernor.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+
+// Step down when the typical frame is 10% over budget, step up only with 30% headroom. The gap between the
+// two is the hysteresis band where nothing changes.
+#define DOWNGRADE_ABOVE_TARGET_RATIO 1.10
+#define UPGRADE_BELOW_TARGET_RATIO 0.70
+// Upgrades need this many consecutive good windows, downgrades happen on the first bad one.
+#define UPGRADE_AFTER_GOOD_WINDOWS 3
+#define COST_EMA_WEIGHT 0.5
+#define LEVEL_EPSILON 0.0001f
+
+float QualityGovernor::Knob::scale() const {
+    if (steps <= 0) {
+        return 1.0f;
+    }
+    return 1.0f - (1.0f - minScale) * static_cast<float>(level) / static_cast<float>(steps);
+}
+
+QualityGovernor::QualityGovernor(double targetFrameTimeS, size_t newWindowFrames)
+    : window(std::max<size_t>(newWindowFrames, 1), 0.0),
+      sortScratch(window.size(), 0.0),
+      windowFrames(std::max<size_t>(newWindowFrames, 1)),
+      windowCount(0),
+      windowIndex(0),
+      targetS(targetFrameTimeS),
+      lastWindowMedianS(0.0),
+      minLevel(0.0f),
+      maxLevel(1.0f),
+      enabled(true),
+      consecutiveGoodWindows(0),
+      pendingChange(Change::NONE),
+      pendingKnob(0),
+      medianBeforeChangeS(0.0) {}
+
+size_t QualityGovernor::addKnob(const std::string & name, float minScale, int steps) {
+    Knob k;
+    k.name = name;
+    k.minScale = std::min(std::max(minScale, 0.01f), 1.0f);
+    k.steps = std::max(steps, 1);
+    k.level = 0;
+    k.costMs = -1.0f;
+    knobs.push_back(k);
+    return knobs.size() - 1;
+}
+
+void QualityGovernor::recordFrame(double frameTimeS) {
+    if (!enabled || knobs.empty()) {
+        return;
+    }
+    window[windowIndex] = frameTimeS;
+    windowIndex = (windowIndex + 1) % windowFrames;
+    if (++windowCount < windowFrames) {
+        return;
+    }
+    windowCount = 0;
+
+    // Median rather than mean so a single hitch (NDI scan, GC in a sender) doesn't trigger a downgrade.
+    std::copy(window.begin(), window.end(), sortScratch.begin());
+    std::nth_element(sortScratch.begin(), sortScratch.begin() + sortScratch.size() / 2, sortScratch.end());
+    double windowMedianS = sortScratch[sortScratch.size() / 2];
+    lastWindowMedianS = windowMedianS;
+
+    if (pendingChange != Change::NONE) {
+        measureChange(windowMedianS);
+    }
+
+    if (level() > maxLevel + LEVEL_EPSILON) {
+        consecutiveGoodWindows = 0;
+        stepDown();
+    } else if (windowMedianS > targetS * DOWNGRADE_ABOVE_TARGET_RATIO) {
+        consecutiveGoodWindows = 0;
+        stepDown();
+    } else if (windowMedianS < targetS * UPGRADE_BELOW_TARGET_RATIO) {
+        if (++consecutiveGoodWindows >= UPGRADE_AFTER_GOOD_WINDOWS) {
+            consecutiveGoodWindows = 0;
+            stepUp();
+        }
+    } else {
+        consecutiveGoodWindows = 0;
+    }
+    medianBeforeChangeS = windowMedianS;
+}
+
+// CPU work alone misses a GPU-bound frame: draw() returns once the commands are submitted, and the wait lands in the
+// buffer swap. The GPU time covers the timed passes. A late interval covers the rest, and is the only signal where
+// there are no timer queries; an on-time interval is pinned to vsync and would hide headroom, so it is ignored.
+double QualityGovernor::frameCost(double workS, double gpuS, double intervalS) const {
+    double costS = std::max(workS, gpuS);
+    if (intervalS > targetS * DOWNGRADE_ABOVE_TARGET_RATIO) {
+        costS = std::max(costS, intervalS);
+    }
+    return costS;
+}
+
+bool QualityGovernor::stepDown() {
+    // Try unmeasured knobs first so every knob gets a cost estimate, then cut the most expensive one.
+    std::optional<size_t> best;
+    for (size_t i = 0; i < knobs.size(); i++) {
+        if (knobs[i].level >= knobs[i].steps || levelAfter(i, 1) < minLevel - LEVEL_EPSILON) {
+            continue;
+        }
+        if (!best.has_value()) {
+            best = i;
+            continue;
+        }
+        const Knob & b = knobs[best.value()];
+        bool unmeasured = knobs[i].costMs < 0 && b.costMs >= 0;
+        bool costlier = knobs[i].costMs >= 0 && b.costMs >= 0 && knobs[i].costMs > b.costMs;
+        if (unmeasured || costlier) {
+            best = i;
+        }
+    }
+    if (!best.has_value()) {
+        return false;
+    }
+    knobs[best.value()].level++;
+    pendingChange = Change::DOWN;
+    pendingKnob = best.value();
+    return true;
+}
+
+bool QualityGovernor::stepUp() {
+    // Restore the cheapest knob first; it is the least likely to push us back over budget.
+    std::optional<size_t> best;
+    for (size_t i = 0; i < knobs.size(); i++) {
+        if (knobs[i].level == 0 || levelAfter(i, -1) > maxLevel + LEVEL_EPSILON) {
+            continue;
+        }
+        if (!best.has_value() || knobs[i].costMs < knobs[best.value()].costMs) {
+            best = i;
+        }
+    }
+    if (!best.has_value()) {
+        return false;
+    }
+    knobs[best.value()].level--;
+    pendingChange = Change::UP;
+    pendingKnob = best.value();
+    return true;
+}
+
+void QualityGovernor::measureChange(double windowMedianS) {
+    double deltaS =
+        pendingChange == Change::DOWN ? medianBeforeChangeS - windowMedianS : windowMedianS - medianBeforeChangeS;
+    float measuredMs = static_cast<float>(std::max(0.0, deltaS * 1000.0));
+    Knob & k = knobs[pendingKnob];
+    k.costMs = k.costMs < 0 ? measuredMs : COST_EMA_WEIGHT * measuredMs + (1 - COST_EMA_WEIGHT) * k.costMs;
+    pendingChange = Change::NONE;
+}
+
+float QualityGovernor::levelAfter(size_t knob, int delta) const {
+    if (knobs.empty()) {
+        return 1.0f;
+    }
+    float sum = 0;
+    for (size_t i = 0; i < knobs.size(); i++) {
+        int l = knobs[i].level + (i == knob ? delta : 0);
+        sum += 1.0f - static_cast<float>(l) / static_cast<float>(knobs[i].steps);
+    }
+    return sum / static_cast<float>(knobs.size());
+}
+
+float QualityGovernor::level() const { return levelAfter(knobs.size(), 0); }
+
+void QualityGovernor::setBounds(float newMinLevel, float newMaxLevel) {
+    minLevel = std::min(std::max(newMinLevel, 0.0f), 1.0f);
+    maxLevel = std::min(std::max(newMaxLevel, minLevel), 1.0f);
+}
+
+void QualityGovernor::reset() {
+    for (auto & k : knobs) {
+        k.level = 0;
+    }
+    std::fill(window.begin(), window.end(), 0.0);
+    windowCount = 0;
+    windowIndex = 0;
+    consecutiveGoodWindows = 0;
+    pendingChange = Change::NONE;
+}
+
+std::string QualityGovernor::getSummary() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2) << "Quality " << level() << " (" << lastWindowMedianS * 1000.0 << "ms / "
+       << targetS * 1000.0 << "ms)";
+    for (const auto & k : knobs) {
+        ss << " | " << k.name << " x" << k.scale();
+        if (k.costMs >= 0) {
+            ss << " [" << k.costMs << "ms/step]";
+        }
+    }
+    return ss.str();
+}
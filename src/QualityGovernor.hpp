@@ -0,0 +1,90 @@
+//
+//  QualityGovernor.hpp
+//  orgb
+//
+//  Frame-time-aware quality control. Each form owns a governor and registers the parameters that dominate
+//  its cost as knobs. The governor watches rolling frame work times and steps knobs down one at a time when
+//  frames run long, and back up once there is sustained headroom. Knob scales are multipliers on the GUI
+//  value, so the GUI stays the ceiling and the user's settings are never overwritten.
+//
+//  OF-independent so it can be unit tested without a GL context.
+//
+
+#ifndef QualityGovernor_hpp
+#define QualityGovernor_hpp
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class QualityGovernor {
+   public:
+    struct Knob {
+        std::string name;
+        float minScale;  // Multiplier at the lowest quality step
+        int steps;       // Number of steps between full quality and minScale
+        int level;       // Current reduction step, 0 = full quality
+        float costMs;    // Measured frame time recovered per step (EMA), negative until measured
+
+        [[nodiscard]] float scale() const;
+    };
+
+    explicit QualityGovernor(double targetFrameTimeS = 1.0 / 60.0, size_t newWindowFrames = 30);
+    ~QualityGovernor() = default;
+
+    // Register a knob and return its handle for scale(). minScale is clamped to (0, 1].
+    size_t addKnob(const std::string & name, float minScale, int steps = 4);
+    [[nodiscard]] float scale(size_t knob) const { return knobs[knob].scale(); }
+
+    // Feed the measured work time of one frame. May step a knob up or down.
+    void recordFrame(double frameTimeS);
+    // Feed a frame as the app measures it, see frameCost()
+    void recordFrame(double workS, double gpuS, double intervalS) { recordFrame(frameCost(workS, gpuS, intervalS)); }
+    // The time one frame took from its CPU work, the GPU time of its passes (negative when untimed) and the interval
+    // since the previous frame.
+    [[nodiscard]] double frameCost(double workS, double gpuS, double intervalS) const;
+
+    // Overall quality in [0, 1], 1 = every knob at full quality.
+    [[nodiscard]] float level() const;
+    // Keep level() within [minLevel, maxLevel]. maxLevel < 1 caps quality even when there is headroom.
+    void setBounds(float minLevel, float maxLevel);
+    void setTargetFrameTime(double targetFrameTimeS) { targetS = targetFrameTimeS; }
+    void setEnabled(bool e) { enabled = e; }
+    [[nodiscard]] bool isEnabled() const { return enabled; }
+
+    // Restore every knob to full quality and forget the frame history. Measured costs are kept.
+    void reset();
+
+    [[nodiscard]] const std::vector<Knob> & getKnobs() const { return knobs; }
+    // Median frame time of the last complete window.
+    [[nodiscard]] double getTypicalFrameTime() const { return lastWindowMedianS; }
+    [[nodiscard]] std::string getSummary() const;
+
+   private:
+    enum class Change { NONE, DOWN, UP };
+
+    bool stepDown();
+    bool stepUp();
+    [[nodiscard]] float levelAfter(size_t knob, int delta) const;
+    void measureChange(double windowMedianS);
+
+    std::vector<Knob> knobs;
+    std::vector<double> window;  // Ring buffer of frame times
+    std::vector<double> sortScratch;
+    size_t windowFrames;
+    size_t windowCount;
+    size_t windowIndex;
+
+    double targetS;
+    double lastWindowMedianS;
+    float minLevel;
+    float maxLevel;
+    bool enabled;
+
+    int consecutiveGoodWindows;
+    Change pendingChange;
+    size_t pendingKnob;
+    double medianBeforeChangeS;
+};
+
+#endif /* QualityGovernor_hpp */
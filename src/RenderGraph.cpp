@@ -0,0 +1,253 @@
+//
+//  RenderGraph.cpp
+//  orgb
+//
+
+#include "RenderGraph.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+#include "FrameProfiler.hpp"
+
+// Long enough that a target is not freed and reallocated when a form only uses it every few frames
+#define RENDER_TARGET_POOL_MAX_IDLE_FRAMES 120
+// Forms that shade every glow separately can log hundreds of passes a frame
+#define RENDER_GRAPH_MAX_LOGGED_PASSES 2048
+#define RENDER_GRAPH_SUMMARY_MAX_LINES 12
+
+static size_t bytesPerPixel(int internalFormat) {
+    switch (internalFormat) {
+        case GL_RGB:
+        case GL_RGB8:
+            return 3;
+#ifndef TARGET_OPENGLES
+        case GL_RGBA16F:
+            return 8;
+        case GL_RGBA32F:
+            return 16;
+#endif
+        default:
+            return 4;
+    }
+}
+
+size_t RenderTargetDesc::getBytes() const {
+    size_t pixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+    // Depth is allocated as a 24 bit renderbuffer, which drivers pad to 32
+    return pixels * bytesPerPixel(internalFormat) + (useDepth ? pixels * 4 : 0);
+}
+
+// ============================================================================
+// RenderTargetPool
+// ============================================================================
+
+ofFbo & RenderTargetPool::acquire(const RenderTargetDesc & desc) {
+    for (auto & entry : entries) {
+        if (!entry.inUse && entry.desc == desc) {
+            entry.inUse = true;
+            entry.lastUsedFrame = frame;
+            return *entry.fbo;
+        }
+    }
+
+    ofFbo::Settings settings;
+    settings.width = desc.width;
+    settings.height = desc.height;
+    settings.internalformat = desc.internalFormat;
+    settings.useDepth = desc.useDepth;
+    settings.minFilter = GL_LINEAR;
+    settings.maxFilter = GL_LINEAR;
+    settings.wrapModeHorizontal = GL_CLAMP_TO_EDGE;
+    settings.wrapModeVertical = GL_CLAMP_TO_EDGE;
+    entries.push_back({desc, std::make_unique<ofFbo>(), true, frame});
+    entries.back().fbo->allocate(settings);
+    ofLogVerbose("RenderTargetPool") << "Allocated " << desc.width << "x" << desc.height
+                                     << (desc.useDepth ? " with depth" : "") << ", " << entries.size()
+                                     << " targets";
+    return *entries.back().fbo;
+}
+
+void RenderTargetPool::release(const ofFbo & fbo) {
+    for (auto & entry : entries) {
+        if (entry.fbo.get() == &fbo) {
+            entry.inUse = false;
+            entry.lastUsedFrame = frame;
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::trim(uint64_t newFrame, uint64_t maxIdleFrames) {
+    frame = newFrame;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [this, maxIdleFrames](const Entry & entry) {
+                                     return !entry.inUse && frame - entry.lastUsedFrame > maxIdleFrames;
+                                 }),
+                  entries.end());
+}
+
+void RenderTargetPool::clear() {
+    if (getInUseCount() > 0) {
+        ofLogWarning("RenderTargetPool::clear") << "Freeing " << getInUseCount() << " targets still in use";
+    }
+    entries.clear();
+}
+
+size_t RenderTargetPool::getAllocatedBytes() const {
+    size_t bytes = 0;
+    for (const auto & entry : entries) {
+        bytes += entry.desc.getBytes();
+    }
+    return bytes;
+}
+
+size_t RenderTargetPool::getInUseCount() const {
+    size_t count = 0;
+    for (const auto & entry : entries) {
+        if (entry.inUse) count++;
+    }
+    return count;
+}
+
+// ============================================================================
+// RenderGraph
+// ============================================================================
+
+void RenderGraph::syncFrame() {
+    uint64_t now = ofGetFrameNum();
+    if (now == frame) {
+        return;
+    }
+    frame = now;
+    std::swap(passes, previousPasses);
+    passes.clear();
+    previousImportedBytes = importedBytes;
+    importedBytes = 0;
+    importedThisFrame.clear();
+    pool.trim(frame, RENDER_TARGET_POOL_MAX_IDLE_FRAMES);
+}
+
+RenderGraph::ResourceId RenderGraph::importTarget(const std::string & name, ofFbo & fbo) {
+    syncFrame();
+    if (std::find(importedThisFrame.begin(), importedThisFrame.end(), &fbo) == importedThisFrame.end()) {
+        importedThisFrame.push_back(&fbo);
+        importedBytes += static_cast<size_t>(fbo.getWidth()) * static_cast<size_t>(fbo.getHeight()) * 4;
+    }
+    RenderTargetDesc desc = {static_cast<int>(fbo.getWidth()), static_cast<int>(fbo.getHeight()), GL_RGBA, false};
+    resources.push_back({name, desc, &fbo, true, -1});
+    return static_cast<ResourceId>(resources.size() - 1);
+}
+
+RenderGraph::ResourceId RenderGraph::createTarget(const std::string & name, const RenderTargetDesc & desc) {
+    syncFrame();
+    resources.push_back({name, desc, nullptr, false, -1});
+    return static_cast<ResourceId>(resources.size() - 1);
+}
+
+void RenderGraph::addPass(const std::string & name, const std::vector<ResourceId> & inputs, ResourceId output,
+                          PassFunction run) {
+    queue.push_back({name, inputs, output, std::move(run)});
+}
+
+ofFbo * RenderGraph::execute(ResourceId keep) {
+    syncFrame();
+
+    // Find the last pass reading each target, which is when a transient can go back to the pool
+    for (size_t i = 0; i < queue.size(); i++) {
+        for (ResourceId input : queue[i].inputs) {
+            resources[input].lastRead = static_cast<int>(i);
+        }
+    }
+
+    std::vector<ofFbo *> inputFbos;
+    for (size_t i = 0; i < queue.size(); i++) {
+        Pass & pass = queue[i];
+        Resource & output = resources[pass.output];
+        if (output.fbo == nullptr) {
+            output.fbo = &pool.acquire(output.desc);
+        }
+
+        inputFbos.clear();
+        for (ResourceId input : pass.inputs) {
+            if (resources[input].fbo == nullptr) {
+                ofLogWarning("RenderGraph::execute") << pass.name << " reads " << resources[input].name
+                                                     << " before any pass writes it";
+                resources[input].fbo = &pool.acquire(resources[input].desc);
+            }
+            inputFbos.push_back(resources[input].fbo);
+        }
+
+        {
+            PROFILE_ZONE_NAMED(pass.name);
+            timer.begin(pass.name);
+            pass.run(inputFbos, *output.fbo);
+            timer.end();
+        }
+
+        std::vector<std::string> inputNames;
+        for (ResourceId input : pass.inputs) {
+            inputNames.push_back(resources[input].name);
+        }
+        recordPass(pass.name, inputNames, output.name, output.fbo->getWidth(), output.fbo->getHeight());
+
+        for (ResourceId input : pass.inputs) {
+            Resource & r = resources[input];
+            if (!r.imported && r.fbo != nullptr && r.lastRead == static_cast<int>(i) && input != keep) {
+                pool.release(*r.fbo);
+                r.fbo = nullptr;
+            }
+        }
+        // Written but never read: nothing later needs it
+        if (!output.imported && output.lastRead < static_cast<int>(i) && pass.output != keep) {
+            pool.release(*output.fbo);
+            output.fbo = nullptr;
+        }
+    }
+
+    ofFbo * kept = keep == NO_RESOURCE ? nullptr : resources[keep].fbo;
+    resources.clear();
+    queue.clear();
+    return kept;
+}
+
+void RenderGraph::recordPass(const std::string & name, const std::vector<std::string> & inputs,
+                             const std::string & output, int width, int height) {
+    syncFrame();
+    if (passes.size() < RENDER_GRAPH_MAX_LOGGED_PASSES) {
+        passes.push_back({name, inputs, output, width, height});
+    }
+}
+
+std::string RenderGraph::getSummary() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "Render graph: " << previousPasses.size() << " passes, pool " << pool.getTargetCount() << " targets ("
+       << pool.getInUseCount() << " in use) " << pool.getAllocatedBytes() / 1048576.0 << " MB, imported "
+       << previousImportedBytes / 1048576.0 << " MB";
+
+    // Collapse runs of the same pass, e.g. one glow pass per shape
+    int lines = 0;
+    for (size_t i = 0; i < previousPasses.size();) {
+        size_t j = i + 1;
+        while (j < previousPasses.size() && previousPasses[j].name == previousPasses[i].name &&
+               previousPasses[j].output == previousPasses[i].output) {
+            j++;
+        }
+        if (++lines > RENDER_GRAPH_SUMMARY_MAX_LINES) {
+            ss << "\n  ...";
+            break;
+        }
+        const PassRecord & pass = previousPasses[i];
+        ss << "\n  " << pass.name;
+        if (j - i > 1) ss << " x" << j - i;
+        ss << ": ";
+        for (size_t k = 0; k < pass.inputs.size(); k++) {
+            if (k > 0) ss << ", ";
+            ss << pass.inputs[k];
+        }
+        ss << " -> " << pass.output << " " << pass.width << "x" << pass.height;
+        i = j;
+    }
+    return ss.str();
+}
@@ -0,0 +1,143 @@
+//
+//  RenderGraph.hpp
+//  orgb
+//
+//  Per-frame list of render passes. Each pass names the targets it reads and the one it writes. Transient
+//  targets are not real FBOs until their first pass runs: they are taken from a pool keyed by size, format and
+//  depth, and handed back after their last read, so a chain of N full-screen passes needs two FBOs, not N.
+//
+//  Passes do their own binding and drawing. The graph only decides which FBO backs each target, and logs what
+//  ran so the frame's passes and GPU memory can be shown at runtime.
+//
+
+#ifndef RenderGraph_hpp
+#define RenderGraph_hpp
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GpuTimer.hpp"
+#include "ofMain.h"
+
+struct RenderTargetDesc {
+    int width;
+    int height;
+    int internalFormat;
+    bool useDepth;
+
+    bool operator==(const RenderTargetDesc & other) const {
+        return width == other.width && height == other.height && internalFormat == other.internalFormat &&
+               useDepth == other.useDepth;
+    }
+    [[nodiscard]] size_t getBytes() const;
+};
+
+class RenderTargetPool {
+   public:
+    RenderTargetPool() = default;
+    ~RenderTargetPool() = default;
+
+    RenderTargetPool(const RenderTargetPool &) = delete;
+    RenderTargetPool & operator=(const RenderTargetPool &) = delete;
+
+    // Returns an idle target matching desc, allocating one if there is none. Contents are whatever the last
+    // user left, so passes must clear or fully overwrite it. The reference stays valid until release().
+    ofFbo & acquire(const RenderTargetDesc & desc);
+    void release(const ofFbo & fbo);  // No-op for FBOs the pool does not own
+
+    // Free idle targets not used in the last maxIdleFrames frames, e.g. after a resize
+    void trim(uint64_t frame, uint64_t maxIdleFrames);
+    void clear();
+
+    [[nodiscard]] size_t getAllocatedBytes() const;
+    [[nodiscard]] size_t getTargetCount() const { return entries.size(); }
+    [[nodiscard]] size_t getInUseCount() const;
+
+   private:
+    struct Entry {
+        RenderTargetDesc desc;
+        std::unique_ptr<ofFbo> fbo;
+        bool inUse;
+        uint64_t lastUsedFrame;
+    };
+    std::vector<Entry> entries;
+    uint64_t frame = 0;
+};
+
+class RenderGraph {
+   public:
+    typedef int ResourceId;
+    static const ResourceId NO_RESOURCE = -1;
+    typedef std::function<void(const std::vector<ofFbo *> & inputs, ofFbo & output)> PassFunction;
+
+    struct PassRecord {
+        std::string name;
+        std::vector<std::string> inputs;
+        std::string output;
+        int width;
+        int height;
+    };
+
+    RenderGraph() = default;
+    ~RenderGraph() = default;
+
+    RenderGraph(const RenderGraph &) = delete;
+    RenderGraph & operator=(const RenderGraph &) = delete;
+
+    // Targets owned elsewhere, e.g. DrawManager's canvases. The graph never allocates or frees them.
+    ResourceId importTarget(const std::string & name, ofFbo & fbo);
+    ResourceId createTarget(const std::string & name, const RenderTargetDesc & desc);
+    void addPass(const std::string & name, const std::vector<ResourceId> & inputs, ResourceId output,
+                 PassFunction run);
+
+    // Run the queued passes in order, then forget them and their targets. keep, if given, is not returned to
+    // the pool after its last read; its FBO is returned and the caller hands it back with release().
+    ofFbo * execute(ResourceId keep = NO_RESOURCE);
+    void release(const ofFbo & fbo) { pool.release(fbo); }
+
+    // Log a pass that was drawn directly rather than through addPass, so the pass list stays complete
+    void recordPass(const std::string & name, const std::vector<std::string> & inputs, const std::string & output,
+                    int width, int height);
+
+    RenderTargetPool & getPool() { return pool; }
+    // Times every executed pass. Passes drawn directly time themselves here too, so one summary covers the frame.
+    GpuTimer & getTimer() { return timer; }
+    [[nodiscard]] const std::vector<PassRecord> & getFramePasses() const { return previousPasses; }  // Last frame
+    [[nodiscard]] const std::vector<PassRecord> & getCurrentPasses() const { return passes; }
+    [[nodiscard]] size_t getImportedBytes() const { return previousImportedBytes; }
+    [[nodiscard]] std::string getSummary() const;
+
+   private:
+    struct Resource {
+        std::string name;
+        RenderTargetDesc desc;
+        ofFbo * fbo;
+        bool imported;
+        int lastRead;
+    };
+    struct Pass {
+        std::string name;
+        std::vector<ResourceId> inputs;
+        ResourceId output;
+        PassFunction run;
+    };
+
+    void syncFrame();
+
+    RenderTargetPool pool;
+    GpuTimer timer;
+    std::vector<Resource> resources;
+    std::vector<Pass> queue;
+
+    uint64_t frame = UINT64_MAX;
+    std::vector<PassRecord> passes;
+    std::vector<PassRecord> previousPasses;
+    std::vector<const ofFbo *> importedThisFrame;
+    size_t importedBytes = 0;
+    size_t previousImportedBytes = 0;
+};
+
+#endif /* RenderGraph_hpp */
@@ -7,6 +7,8 @@
 
 #include "ShaderEffect.hpp"
 
+#include <algorithm>
+
 #include "Utilities.hpp"
 
 // ============================================================================
@@ -15,6 +17,8 @@
 
 ShaderEffect::ShaderEffect(const std::string & name, const std::string & shaderName)
     : effectName(name), shaderFileName(shaderName), enabled(true), shaderLoaded(false), shaderCompiled(false) {
+    resolutionUniform = declareUniform("resolution");
+    timeUniform = declareUniform("time");
     if (!shaderName.empty()) {
         loadShader();
     }
@@ -48,8 +52,8 @@ void ShaderEffect::apply(ofFbo & input, ofFbo & output) {
         {
             // Set common uniforms
             glm::vec2 resolution(input.getWidth(), input.getHeight());
-            shader.setUniform2f("resolution", resolution);
-            shader.setUniform1f("time", ofGetElapsedTimef());
+            setUniform2f(resolutionUniform, resolution.x, resolution.y);
+            setUniform1f(timeUniform, ofGetElapsedTimef());
 
             // Set effect-specific uniforms
             configureShaderUniforms(shader, resolution);
@@ -69,30 +73,115 @@ void ShaderEffect::configureShaderUniforms(ofShader & shader, const glm::vec2 &
     // Base implementation does nothing - subclasses override
 }
 
+void ShaderEffect::applyFusedUniforms(const ofShader & target, UniformCache & targetUniforms,
+                                      std::vector<size_t> & handles, const glm::vec2 & resolution) {
+    while (handles.size() < uniformNames.size()) {
+        handles.push_back(targetUniforms.declare(target, uniformNames[handles.size()]));
+    }
+    fusedShader = &target;
+    fusedTarget = &targetUniforms;
+    fusedHandles = &handles;
+    configureShaderUniforms(shader, resolution);
+    applyParametersToShader(shader);
+    fusedShader = nullptr;
+    fusedTarget = nullptr;
+    fusedHandles = nullptr;
+}
+
+size_t ShaderEffect::addParameter(const ShaderParameter & param) {
+    parameters.push_back(param);
+    parameterUniforms.push_back(declareUniform(param.uniformName));
+    return parameterUniforms.back();
+}
+
 void ShaderEffect::applyParametersToShader(ofShader & shader) {
-    for (const auto & param : parameters) {
+    UniformCache & target = uniformTarget();
+    for (size_t i = 0; i < parameters.size(); i++) {
+        const ShaderParameter & param = parameters[i];
+        size_t handle = uniformHandle(parameterUniforms[i]);
         switch (param.type) {
             case ParameterType::FLOAT:
-                shader.setUniform1f(param.uniformName, param.floatValue);
+                target.set1f(handle, param.floatValue);
                 break;
             case ParameterType::INT:
-                shader.setUniform1i(param.uniformName, param.intValue);
+                target.set1i(handle, param.intValue);
                 break;
             case ParameterType::BOOL:
-                shader.setUniform1i(param.uniformName, param.boolValue ? 1 : 0);
+                target.set1i(handle, param.boolValue ? 1 : 0);
                 break;
             case ParameterType::COLOR:
-                shader.setUniform4f(param.uniformName, param.colorValue.r, param.colorValue.g, param.colorValue.b,
-                                    param.colorValue.a);
+                target.set4f(handle, param.colorValue.r, param.colorValue.g, param.colorValue.b, param.colorValue.a);
                 break;
         }
     }
 }
 
+// ============================================================================
+// Uniforms
+// ============================================================================
+
+size_t ShaderEffect::declareUniform(const std::string & uniformName) {
+    auto found = std::find(uniformNames.begin(), uniformNames.end(), uniformName);
+    if (found != uniformNames.end()) {
+        return found - uniformNames.begin();
+    }
+    uniformNames.push_back(uniformName);
+    if (shaderLoaded) {
+        ownHandles.push_back(uniforms.declare(shader, uniformName));
+    }
+    return uniformNames.size() - 1;
+}
+
+void ShaderEffect::resolveUniforms() {
+    uniforms.clear();
+    ownHandles.clear();
+    for (const auto & name : uniformNames) {
+        ownHandles.push_back(uniforms.declare(shader, name));
+    }
+}
+
+void ShaderEffect::setUniform1f(size_t uniform, float value) { uniformTarget().set1f(uniformHandle(uniform), value); }
+
+void ShaderEffect::setUniform1i(size_t uniform, int value) { uniformTarget().set1i(uniformHandle(uniform), value); }
+
+void ShaderEffect::setUniform2f(size_t uniform, float x, float y) {
+    uniformTarget().set2f(uniformHandle(uniform), x, y);
+}
+
+void ShaderEffect::setUniform4f(size_t uniform, float x, float y, float z, float w) {
+    uniformTarget().set4f(uniformHandle(uniform), x, y, z, w);
+}
+
+size_t ShaderEffect::uniformFor(const std::string & uniformName) {
+    size_t uniform = declareUniform(uniformName);
+    // A name first declared mid-fusion also needs resolving in the fused shader
+    if (fusedHandles != nullptr && fusedHandles->size() < uniformNames.size()) {
+        fusedHandles->push_back(fusedTarget->declare(*fusedShader, uniformName));
+    }
+    return uniform;
+}
+
+void ShaderEffect::setUniform1f(const std::string & uniformName, float value) {
+    setUniform1f(uniformFor(uniformName), value);
+}
+
+void ShaderEffect::setUniform1i(const std::string & uniformName, int value) {
+    setUniform1i(uniformFor(uniformName), value);
+}
+
+void ShaderEffect::setUniform2f(const std::string & uniformName, float x, float y) {
+    setUniform2f(uniformFor(uniformName), x, y);
+}
+
+void ShaderEffect::setUniform4f(const std::string & uniformName, float x, float y, float z, float w) {
+    setUniform4f(uniformFor(uniformName), x, y, z, w);
+}
+
 bool ShaderEffect::loadShader() {
     if (shaderFileName.empty()) {
         shaderLoaded = true;  // No shader to load
         shaderCompiled = true;
+        resolveUniforms();
         return true;
     }
 
@@ -100,6 +189,7 @@ bool ShaderEffect::loadShader() {
         // Use existing createShader function for platform detection
         shader = createShader(shaderFileName);
         shaderLoaded = true;
+        resolveUniforms();
 
         // Validate compilation
         return validateShader();
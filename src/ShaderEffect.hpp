@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "DrawContext.hpp"
+#include "UniformCache.hpp"
 #include "ofMain.h"
 
 // ============================================================================
@@ -111,16 +112,41 @@ class ShaderEffect {
     [[nodiscard]] bool isValid() const { return shaderLoaded && shaderCompiled; }
     [[nodiscard]] std::string getErrorMessage() const { return errorMessage; }
 
+    // Fusion. An effect whose output pixel depends only on the input pixel under it returns a stage name with its
+    // current settings; ShaderPipeline then runs it in one pass with its pixel-local neighbours. The stage lives in
+    // shaders/post/<stage>.glsl and defines vec4 <stage>(vec4 color, vec2 uv) plus the uniforms it reads.
+    [[nodiscard]] virtual std::string getFusedStage() const { return ""; }
+    // Set this effect's uniforms on a bound fused shader that includes its stage. handles belongs to the fused
+    // shader and this effect's place in it; the first call resolves every uniform the effect declares into it.
+    void applyFusedUniforms(const ofShader & target, UniformCache & targetUniforms, std::vector<size_t> & handles,
+                            const glm::vec2 & resolution);
+
    protected:
     // Subclasses override this to configure shader uniforms
     virtual void configureShaderUniforms(ofShader & shader, const glm::vec2 & resolution);
 
-    // Subclasses can add parameters in constructor
-    void addParameter(const ShaderParameter & param) { parameters.push_back(param); }
+    // Subclasses can add parameters in constructor. Returns the parameter's uniform, as declareUniform does.
+    size_t addParameter(const ShaderParameter & param);
 
     // Helper to set parameter uniforms automatically
     void applyParametersToShader(ofShader & shader);
 
+    // Declare a uniform once, in the constructor, and set it through the returned id. Ids stay valid across
+    // shader reloads and fusion: locations are resolved when the shader loads and when a fused shader first
+    // runs the effect, never per set. Values are only uploaded when they change, so call these rather than
+    // shader.setUniform*.
+    size_t declareUniform(const std::string & uniformName);
+    void setUniform1f(size_t uniform, float value);
+    void setUniform1i(size_t uniform, int value);
+    void setUniform2f(size_t uniform, float x, float y);
+    void setUniform4f(size_t uniform, float x, float y, float z, float w);
+
+    // By name, for uniforms set too rarely to be worth declaring. Each call looks the name up.
+    void setUniform1f(const std::string & uniformName, float value);
+    void setUniform1i(const std::string & uniformName, int value);
+    void setUniform2f(const std::string & uniformName, float x, float y);
+    void setUniform4f(const std::string & uniformName, float x, float y, float z, float w);
+
     // Shader management
     bool loadShader();
     bool validateShader();
@@ -135,6 +161,27 @@ class ShaderEffect {
 
     ofShader shader;
     std::vector<ShaderParameter> parameters;
+
+   private:
+    void resolveUniforms();
+    size_t uniformFor(const std::string & uniformName);  // Declaring it if needed
+    UniformCache & uniformTarget() { return fusedTarget != nullptr ? *fusedTarget : uniforms; }
+    // The cache handle for a declared uniform in whichever shader is being set
+    size_t uniformHandle(size_t uniform) const {
+        return fusedHandles != nullptr ? (*fusedHandles)[uniform] : ownHandles[uniform];
+    }
+
+    std::vector<std::string> uniformNames;  // Declared uniforms, by id
+    UniformCache uniforms;
+    std::vector<size_t> ownHandles;         // Handle in uniforms for each id, once the shader is loaded
+    std::vector<size_t> parameterUniforms;  // Id for each entry of parameters
+    size_t resolutionUniform;
+    size_t timeUniform;
+
+    // Set during applyFusedUniforms, so setUniform* write to the fused shader instead of this effect's own
+    const ofShader * fusedShader = nullptr;
+    UniformCache * fusedTarget = nullptr;
+    std::vector<size_t> * fusedHandles = nullptr;
 };
 
 // ============================================================================
@@ -7,26 +7,27 @@
 
 #include "ShaderPipeline.hpp"
 
+#include <set>
+
 #include "DrawContext.hpp"
 
 // ============================================================================
 // ShaderPipeline Implementation
 // ============================================================================
 
-ShaderPipeline::ShaderPipeline(int width, int height) : width(width), height(height) { initializeFbos(); }
-
-void ShaderPipeline::initializeFbos() {
-    processingFbo1 = getConfiguredFrameBuffer(width, height);
-    processingFbo2 = getConfiguredFrameBuffer(width, height);
+ShaderPipeline::ShaderPipeline(int width, int height)
+    : graph(std::make_shared<RenderGraph>()), result(nullptr), width(width), height(height) {}
 
-    // Clear both FBOs
-    processingFbo1.begin();
-    ofClear(0, 0, 0, 0);
-    processingFbo1.end();
+void ShaderPipeline::setRenderGraph(std::shared_ptr<RenderGraph> newGraph) {
+    releaseResult();
+    graph = std::move(newGraph);
+}
 
-    processingFbo2.begin();
-    ofClear(0, 0, 0, 0);
-    processingFbo2.end();
+void ShaderPipeline::releaseResult() {
+    if (result != nullptr) {
+        graph->release(*result);
+        result = nullptr;
+    }
 }
 
 void ShaderPipeline::addEffect(std::shared_ptr<ShaderEffect> effect) {
@@ -140,11 +141,9 @@ void ShaderPipeline::toggleAll() {
     ofLogNotice("ShaderPipeline::toggleAll") << "Toggled all effects";
 }
 
-ofFbo & ShaderPipeline::getCurrentFbo(int index) { return (index % 2 == 0) ? processingFbo1 : processingFbo2; }
-
-ofFbo & ShaderPipeline::getNextFbo(int index) { return (index % 2 == 0) ? processingFbo2 : processingFbo1; }
-
 ofFbo & ShaderPipeline::process(ofFbo & input) {
+    releaseResult();
+
     if (effects.empty()) {
         return input;  // No effects - return input unchanged
     }
@@ -155,32 +154,124 @@ ofFbo & ShaderPipeline::process(ofFbo & input) {
         return input;  // All effects disabled
     }
 
-    // Copy input to first processing FBO
-    processingFbo1.begin();
-    ofClear(0, 0, 0, 0);
-    drawFboAtZeroZero(input);
-    processingFbo1.end();
-
-    // Apply effects in sequence, ping-ponging between FBOs
-    int appliedCount = 0;
-    for (size_t i = 0; i < effects.size(); i++) {
-        auto & effect = effects[i];
+    // The first pass reads the input directly, and each later one reads its predecessor's target. The graph
+    // returns each target to the pool once the next pass has read it, so the chain ping-pongs between two.
+    std::vector<std::shared_ptr<ShaderEffect>> enabledEffects;
+    for (auto & effect : effects) {
+        if (effect->isEnabled()) {
+            enabledEffects.push_back(effect);
+        }
+    }
 
-        if (!effect->isEnabled()) {
-            continue;  // Skip disabled effects
+    RenderTargetDesc desc = {width, height, GL_RGBA, false};
+    RenderGraph::ResourceId current = graph->importTarget("input", input);
+    auto addEffectPass = [&](const std::string & name, std::function<void(ofFbo &, ofFbo &)> apply) {
+        RenderGraph::ResourceId next = graph->createTarget(name, desc);
+        graph->addPass(name, {current}, next, [apply](const std::vector<ofFbo *> & inputs, ofFbo & output) {
+            apply(*inputs[0], output);
+        });
+        current = next;
+    };
+
+    for (size_t start = 0; start < enabledEffects.size();) {
+        // Longest run of fusable effects from start. A stage can appear once per shader, so a repeat ends the run.
+        size_t end = start + 1;
+        std::set<std::string> stages = {enabledEffects[start]->getFusedStage()};
+        if (fusionEnabled && !stages.begin()->empty()) {
+            while (end < enabledEffects.size()) {
+                std::string stage = enabledEffects[end]->getFusedStage();
+                if (stage.empty() || !stages.insert(stage).second) break;
+                end++;
+            }
+        }
+        std::vector<std::shared_ptr<ShaderEffect>> run(enabledEffects.begin() + start, enabledEffects.begin() + end);
+        start = end;
+
+        FusedShader * fused = run.size() > 1 ? &getFusedShader(run) : nullptr;
+        if (fused != nullptr && fused->valid) {
+            std::string name = run[0]->getName();
+            for (size_t i = 1; i < run.size(); i++) {
+                name += " + " + run[i]->getName();
+            }
+            addEffectPass(name, [fused, run](ofFbo & in, ofFbo & out) { applyFused(*fused, run, in, out); });
+            for (auto & effect : run) {
+                effectPasses[effect->getName()] = name;
+            }
+            continue;
         }
+        for (auto & effect : run) {
+            effectPasses[effect->getName()] = effect->getName();
+            addEffectPass(effect->getName(), [effect](ofFbo & in, ofFbo & out) { effect->apply(in, out); });
+        }
+    }
 
-        ofFbo & currentFbo = getCurrentFbo(appliedCount);
-        ofFbo & nextFbo = getNextFbo(appliedCount);
+    result = graph->execute(current);
+    return *result;
+}
+
+ShaderPipeline::FusedShader & ShaderPipeline::getFusedShader(const std::vector<std::shared_ptr<ShaderEffect>> & run) {
+    std::string key;
+    for (const auto & effect : run) {
+        key += (key.empty() ? "" : "+") + effect->getFusedStage();
+    }
+    auto found = fusedShaders.find(key);
+    if (found != fusedShaders.end()) {
+        return *found->second;
+    }
 
-        effect->apply(currentFbo, nextFbo);
-        appliedCount++;
+    // Splice an include and a call per stage into the template, in run order
+    std::string directory = getShaderDirectory() + "post/";
+    std::stringstream includes;
+    std::stringstream calls;
+    for (const auto & effect : run) {
+        std::string stage = effect->getFusedStage();
+        includes << "#pragma include \"../../shaders/post/" << stage << ".glsl\"\n";
+        calls << "    color = " << stage << "(color, uv);\n";
+    }
+    std::string source = ofBufferFromFile(directory + "shaderFused.frag").getText();
+    ofStringReplace(source, "// FUSED_STAGE_INCLUDES", includes.str());
+    ofStringReplace(source, "    // FUSED_STAGE_CALLS\n", calls.str());
+
+    auto fused = std::make_unique<FusedShader>();
+    if (source.empty()) {
+        ofLogWarning("ShaderPipeline::getFusedShader") << "No fused shader template in " << directory;
+    } else {
+        fused->valid = fused->shader.setupShaderFromFile(GL_VERTEX_SHADER, directory + "shaderFused.vert") &&
+                       fused->shader.setupShaderFromSource(GL_FRAGMENT_SHADER, source, ofToDataPath(directory, true));
+        if (fused->valid && ofIsGLProgrammableRenderer()) {
+            fused->shader.bindDefaults();
+        }
+        fused->valid = fused->valid && fused->shader.linkProgram();
     }
+    if (fused->valid) {
+        fused->resolutionUniform = fused->uniforms.declare(fused->shader, "resolution");
+        fused->timeUniform = fused->uniforms.declare(fused->shader, "time");
+        fused->effectUniforms.resize(run.size());
+        ofLogNotice("ShaderPipeline::getFusedShader") << "Fused " << key;
+    } else {
+        ofLogWarning("ShaderPipeline::getFusedShader") << "Failed to fuse " << key << ", running effects separately";
+    }
+    return *fusedShaders.emplace(key, std::move(fused)).first->second;
+}
 
-    // Return the FBO with the final result
-    // If odd number of enabled effects, result is in processingFbo2
-    // If even number, result is in processingFbo1
-    return getCurrentFbo(appliedCount);
+void ShaderPipeline::applyFused(FusedShader & fused, const std::vector<std::shared_ptr<ShaderEffect>> & run,
+                                ofFbo & input, ofFbo & output) {
+    output.begin();
+    {
+        ofClear(0, 0, 0, 0);
+        fused.shader.begin();
+        {
+            glm::vec2 resolution(input.getWidth(), input.getHeight());
+            fused.uniforms.set2f(fused.resolutionUniform, resolution.x, resolution.y);
+            fused.uniforms.set1f(fused.timeUniform, ofGetElapsedTimef());
+            for (size_t i = 0; i < run.size(); i++) {
+                run[i]->applyFusedUniforms(fused.shader, fused.uniforms, fused.effectUniforms[i], resolution);
+            }
+            drawFboAtZeroZero(input);
+        }
+        fused.shader.end();
+    }
+    output.end();
 }
 
 void ShaderPipeline::processAndDraw(ofFbo & input, float x, float y) {
@@ -199,7 +290,8 @@ void ShaderPipeline::resize(int newWidth, int newHeight) {
     width = newWidth;
     height = newHeight;
 
-    initializeFbos();
+    // Targets of the old size are no longer requested and age out of the pool
+    releaseResult();
 
     ofLogNotice("ShaderPipeline::resize") << "Resized to " << width << "x" << height;
 }
@@ -216,7 +308,9 @@ void ShaderPipeline::printPipeline() const {
         std::string status = effect->isEnabled() ? "[ENABLED]" : "[DISABLED]";
         std::string valid = effect->isValid() ? "VALID" : "INVALID";
 
-        ofLogNotice("ShaderPipeline") << i << ". " << status << " " << effect->getName() << " (" << valid << ")";
+        double gpuMs = getEffectGpuMs(effect->getName());
+        ofLogNotice("ShaderPipeline") << i << ". " << status << " " << effect->getName() << " (" << valid << ")"
+                                      << (gpuMs >= 0 ? " " + ofToString(gpuMs, 2) + " ms GPU" : "");
 
         if (!effect->isValid()) {
             ofLogNotice("ShaderPipeline") << "   Error: " << effect->getErrorMessage();
@@ -233,12 +327,21 @@ std::string ShaderPipeline::getPipelineSummary() const {
     for (size_t i = 0; i < effects.size(); i++) {
         if (i > 0) ss << " -> ";
         ss << effects[i]->getName();
-        if (!effects[i]->isEnabled()) ss << "(off)";
+        if (!effects[i]->isEnabled()) {
+            ss << "(off)";
+        } else if (getEffectGpuMs(effects[i]->getName()) >= 0) {
+            ss << "(" << ofToString(getEffectGpuMs(effects[i]->getName()), 2) << " ms)";
+        }
     }
 
     return ss.str();
 }
 
+double ShaderPipeline::getEffectGpuMs(const std::string & name) const {
+    auto found = effectPasses.find(name);
+    return found != effectPasses.end() ? graph->getTimer().getAverageMs(found->second) : -1.0;
+}
+
 int ShaderPipeline::getEnabledEffectCount() const {
     int count = 0;
     for (const auto & effect : effects) {
@@ -3,16 +3,23 @@
 //  orgb
 //
 //  Manages a stack of post-processing shader effects with runtime toggling,
-//  reordering, and efficient FBO ping-ponging.
+//  reordering, and efficient FBO ping-ponging. Intermediate targets come from
+//  a RenderGraph pool, so only two are live however many effects are enabled.
+//
+//  Consecutive enabled effects that report a fused stage run as one pass through
+//  a generated shader, compiled once per stage sequence. Toggling or reordering
+//  effects changes the sequence and so picks or generates another shader.
 //
 
 #ifndef ShaderPipeline_hpp
 #define ShaderPipeline_hpp
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "RenderGraph.hpp"
 #include "ShaderEffect.hpp"
 #include "ofMain.h"
 
@@ -49,7 +56,7 @@ class ShaderPipeline {
 
     // Main render interface
     // Applies all enabled effects in order to the input FBO
-    // Returns the final processed FBO
+    // Returns the final processed FBO, valid until the next process() call
     ofFbo & process(ofFbo & input);
 
     // Direct draw to screen (convenience)
@@ -60,6 +67,19 @@ class ShaderPipeline {
     [[nodiscard]] int getWidth() const { return width; }
     [[nodiscard]] int getHeight() const { return height; }
 
+    // Share a graph (and its target pool) with the rest of the frame. The pipeline has its own until then.
+    void setRenderGraph(std::shared_ptr<RenderGraph> newGraph);
+    std::shared_ptr<RenderGraph> getRenderGraph() { return graph; }
+
+    // Fusion of pixel-local effects, on by default. Off runs one pass per effect.
+    void setFusionEnabled(bool state) { fusionEnabled = state; }
+    [[nodiscard]] bool isFusionEnabled() const { return fusionEnabled; }
+    [[nodiscard]] size_t getFusedShaderCount() const { return fusedShaders.size(); }
+
+    // Rolling GPU time of the pass that ran an effect, negative until measured. Fused effects share their pass's
+    // time. Timing is off until getRenderGraph()->getTimer() is enabled.
+    [[nodiscard]] double getEffectGpuMs(const std::string & name) const;
+
     // Debug/Info
     void printPipeline() const;
     [[nodiscard]] std::string getPipelineSummary() const;
@@ -72,18 +92,32 @@ class ShaderPipeline {
     // Effect stack (applied in order)
     std::vector<std::shared_ptr<ShaderEffect>> effects;
 
-    // Double-buffered FBOs for ping-pong processing
-    ofFbo processingFbo1;
-    ofFbo processingFbo2;
+    // Intermediate targets are pooled by the graph. The last result stays acquired until the next process().
+    std::shared_ptr<RenderGraph> graph;
+    ofFbo * result;
 
     int width;
     int height;
 
-    // Helper to get appropriate processing FBO
-    ofFbo & getCurrentFbo(int index);
-    ofFbo & getNextFbo(int index);
-
-    void initializeFbos();
+    struct FusedShader {
+        ofShader shader;
+        UniformCache uniforms;
+        size_t resolutionUniform = UniformCache::npos;
+        size_t timeUniform = UniformCache::npos;
+        // Each stage's uniform handles, in run order. A stage always comes from the same effect class, which
+        // declares the same uniforms, so they hold for any run with this key.
+        std::vector<std::vector<size_t>> effectUniforms;
+        bool valid = false;
+    };
+    // Keyed by stage sequence, e.g. "filmGrain+scanlines". Invalid entries are kept so a failure is not retried.
+    std::map<std::string, std::unique_ptr<FusedShader>> fusedShaders;
+    bool fusionEnabled = true;
+    std::map<std::string, std::string> effectPasses;  // Effect name to the name of the pass that last ran it
+
+    void releaseResult();
+    FusedShader & getFusedShader(const std::vector<std::shared_ptr<ShaderEffect>> & run);
+    static void applyFused(FusedShader & fused, const std::vector<std::shared_ptr<ShaderEffect>> & run,
+                           ofFbo & input, ofFbo & output);
 };
 
 // ============================================================================
@@ -0,0 +1,227 @@
+//
+//  SharedFrameRing.cpp
+//  orgb
+//
+
+#include "SharedFrameRing.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#ifndef __EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Pixel rows of each slot start on a cache line
+#define SHARED_FRAME_ALIGNMENT 64
+
+static size_t alignUp(size_t bytes) {
+    return (bytes + SHARED_FRAME_ALIGNMENT - 1) / SHARED_FRAME_ALIGNMENT * SHARED_FRAME_ALIGNMENT;
+}
+
+static uint32_t formatFor(int channels) {
+    switch (channels) {
+        case 1:
+            return SHARED_FRAME_FORMAT_GRAY;
+        case 3:
+            return SHARED_FRAME_FORMAT_RGB;
+        default:
+            return SHARED_FRAME_FORMAT_RGBA;
+    }
+}
+
+static uint64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+// ============================================================================
+// SharedFrameWriter
+// ============================================================================
+
+SharedFrameWriter::~SharedFrameWriter() { close(); }
+
+void SharedFrameWriter::setup(const std::string & newName, int slots) {
+    close();
+    name = newName;
+    slotCount = std::max(slots, 2);
+}
+
+void SharedFrameWriter::close() {
+#ifndef __EMSCRIPTEN__
+    if (header == nullptr) {
+        return;
+    }
+    header->closed.store(1, std::memory_order_release);
+    munmap(header, mappedBytes);
+    shm_unlink(name.c_str());
+    header = nullptr;
+    mappedBytes = 0;
+#endif
+}
+
+bool SharedFrameWriter::create(int newWidth, int newHeight, int newChannels) {
+#ifdef __EMSCRIPTEN__
+    return false;
+#else
+    close();
+    size_t slotStride = sizeof(SharedFrameSlot) + alignUp(static_cast<size_t>(newWidth) * newHeight * newChannels);
+    size_t bytes = sizeof(SharedFrameHeader) + slotStride * slotCount;
+
+    // Unlink first so readers still mapping an old segment keep it, marked closed, while new ones get this one
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        ofLogError("SharedFrameWriter") << "Could not create " << name << ": " << strerror(errno);
+        return false;
+    }
+    if (ftruncate(fd, bytes) != 0) {
+        ofLogError("SharedFrameWriter") << "Could not size " << name << " to " << bytes
+                                        << " bytes: " << strerror(errno);
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    void * mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        ofLogError("SharedFrameWriter") << "Could not map " << name << ": " << strerror(errno);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // A new segment is zero-filled, so every slot starts out incomplete and latest at 0
+    header = static_cast<SharedFrameHeader *>(mapped);
+    mappedBytes = bytes;
+    memcpy(header->magic, SHARED_FRAME_MAGIC, sizeof(header->magic));
+    header->version = SHARED_FRAME_VERSION;
+    header->slotCount = slotCount;
+    header->slotStride = slotStride;
+    width = newWidth;
+    height = newHeight;
+    channels = newChannels;
+    ofLogNotice("SharedFrameWriter") << "Publishing " << width << "x" << height << "x" << channels << " frames to "
+                                     << name << " in " << slotCount << " slots";
+    return true;
+#endif
+}
+
+bool SharedFrameWriter::write(const ofPixels & pixels) {
+    if (name.empty() || !pixels.isAllocated()) {
+        return false;
+    }
+    int w = pixels.getWidth();
+    int h = pixels.getHeight();
+    int c = pixels.getNumChannels();
+    if ((header == nullptr || w != width || h != height || c != channels) && !create(w, h, c)) {
+        return false;
+    }
+
+    sequence++;
+    auto * slot = reinterpret_cast<SharedFrameSlot *>(reinterpret_cast<unsigned char *>(header) +
+                                                      sizeof(SharedFrameHeader) +
+                                                      header->slotStride * (sequence % slotCount));
+    slot->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->timestampUs = nowMicros();
+    slot->format = formatFor(c);
+    slot->width = w;
+    slot->height = h;
+    slot->rowBytes = w * c;
+    memcpy(reinterpret_cast<unsigned char *>(slot) + sizeof(SharedFrameSlot), pixels.getData(),
+           pixels.getTotalBytes());
+    slot->sequence.store(sequence, std::memory_order_release);
+    header->latest.store(sequence, std::memory_order_release);
+    return true;
+}
+
+// ============================================================================
+// SharedFrameReader
+// ============================================================================
+
+SharedFrameReader::~SharedFrameReader() { close(); }
+
+bool SharedFrameReader::open(const std::string & name) {
+#ifdef __EMSCRIPTEN__
+    return false;
+#else
+    close();
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SharedFrameHeader)) {
+        ::close(fd);
+        return false;
+    }
+    void * mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    auto * candidate = static_cast<const SharedFrameHeader *>(mapped);
+    size_t needed = sizeof(SharedFrameHeader) + candidate->slotStride * candidate->slotCount;
+    if (memcmp(candidate->magic, SHARED_FRAME_MAGIC, sizeof(candidate->magic)) != 0 ||
+        candidate->version != SHARED_FRAME_VERSION || candidate->slotCount == 0 ||
+        needed > static_cast<size_t>(info.st_size)) {
+        ofLogWarning("SharedFrameReader") << name << " is not a frame ring this reader understands";
+        munmap(mapped, info.st_size);
+        return false;
+    }
+    header = candidate;
+    mappedBytes = info.st_size;
+    return true;
+#endif
+}
+
+void SharedFrameReader::close() {
+#ifndef __EMSCRIPTEN__
+    if (header != nullptr) {
+        munmap(const_cast<SharedFrameHeader *>(header), mappedBytes);
+        header = nullptr;
+        mappedBytes = 0;
+    }
+#endif
+}
+
+const SharedFrameSlot * SharedFrameReader::slot(uint64_t sequence) const {
+    return reinterpret_cast<const SharedFrameSlot *>(reinterpret_cast<const unsigned char *>(header) +
+                                                     sizeof(SharedFrameHeader) +
+                                                     header->slotStride * (sequence % header->slotCount));
+}
+
+bool SharedFrameReader::latest(Frame & frame) const {
+    if (header == nullptr) {
+        return false;
+    }
+    uint64_t sequence = header->latest.load(std::memory_order_acquire);
+    if (sequence == 0) {
+        return false;
+    }
+    const SharedFrameSlot * s = slot(sequence);
+    if (s->sequence.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+    frame = {sequence, s->timestampUs, s->format, s->width, s->height, s->rowBytes,
+             reinterpret_cast<const unsigned char *>(s) + sizeof(SharedFrameSlot)};
+    return stillValid(frame);  // The fields above may be torn if the writer lapped us while reading them
+}
+
+bool SharedFrameReader::stillValid(const Frame & frame) const {
+    if (header == nullptr) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot(frame.sequence)->sequence.load(std::memory_order_relaxed) == frame.sequence;
+}
+
+bool SharedFrameReader::isClosed() const {
+    return header == nullptr || header->closed.load(std::memory_order_acquire) != 0;
+}
@@ -0,0 +1,132 @@
+//
+//  SharedFrameRing.hpp
+//  orgb
+//
+//  Publishes rendered frames into a POSIX shared-memory segment (/dev/shm/<name> on Linux) so other local processes
+//  (encoders, previews, test harnesses) can read them in place, without a GL context or a copy.
+//
+//  Layout, all integers little-endian and naturally aligned:
+//
+//    SharedFrameHeader (64 bytes)
+//    slotCount x { SharedFrameSlot (64 bytes), pixels (slotStride - 64 bytes) }
+//
+//  Frame n (sequences start at 1) goes to slot n % slotCount. Each slot's sequence is a seqlock: it is 0 while the
+//  writer fills the slot and the frame's sequence once it is complete, and the header's latest names the newest
+//  complete frame. A reader takes latest, checks the slot carries that sequence, uses the pixels, then checks the
+//  sequence again; if it changed, the writer lapped the reader and the pixels may be torn. With the default three
+//  slots a reader has two frame periods to finish with a frame.
+//
+//  When the frame size changes the writer marks the segment closed and replaces it; readers reopen by name.
+//  scripts/read_shared_frames.py is a minimal reader.
+//
+
+#ifndef SharedFrameRing_hpp
+#define SharedFrameRing_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "ofMain.h"
+
+#define SHARED_FRAME_MAGIC "ORGBFRM1"
+#define SHARED_FRAME_VERSION 1
+#define SHARED_FRAME_DEFAULT_SLOTS 3
+
+// Pixel formats, as little-endian FourCCs
+#define SHARED_FRAME_FORMAT_GRAY 0x20203859  // "Y8  "
+#define SHARED_FRAME_FORMAT_RGB 0x20424752   // "RGB "
+#define SHARED_FRAME_FORMAT_RGBA 0x41424752  // "RGBA"
+
+struct SharedFrameHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slotCount;
+    uint64_t slotStride;  // Bytes from one slot to the next, slot header included
+    std::atomic<uint64_t> latest;
+    std::atomic<uint32_t> closed;  // Set once the writer has replaced or abandoned the segment
+    uint8_t reserved[28];
+};
+
+struct SharedFrameSlot {
+    std::atomic<uint64_t> sequence;
+    uint64_t timestampUs;  // Microseconds since the Unix epoch when the frame was published
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t rowBytes;
+    uint8_t reserved[32];
+};
+
+static_assert(sizeof(SharedFrameHeader) == 64, "Shared frame header layout is fixed");
+static_assert(sizeof(SharedFrameSlot) == 64, "Shared frame slot layout is fixed");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared frame sequences must be lock-free");
+
+class SharedFrameWriter {
+   public:
+    SharedFrameWriter() = default;
+    ~SharedFrameWriter();
+
+    SharedFrameWriter(const SharedFrameWriter &) = delete;
+    SharedFrameWriter & operator=(const SharedFrameWriter &) = delete;
+
+    // Name as for shm_open, e.g. "/orgb-frames". The segment is created on the first write.
+    void setup(const std::string & name, int slots = SHARED_FRAME_DEFAULT_SLOTS);
+    void close();  // Marks the segment closed and unlinks it
+
+    // Copy a frame into the next slot. Returns false if the segment could not be created.
+    bool write(const ofPixels & pixels);
+
+    [[nodiscard]] bool isOpen() const { return header != nullptr; }
+    [[nodiscard]] uint64_t getSequence() const { return sequence; }
+
+   private:
+    bool create(int width, int height, int channels);
+
+    std::string name;
+    int slotCount = SHARED_FRAME_DEFAULT_SLOTS;
+    SharedFrameHeader * header = nullptr;
+    size_t mappedBytes = 0;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    uint64_t sequence = 0;
+};
+
+class SharedFrameReader {
+   public:
+    struct Frame {
+        uint64_t sequence;
+        uint64_t timestampUs;
+        uint32_t format;
+        uint32_t width;
+        uint32_t height;
+        uint32_t rowBytes;
+        const unsigned char * pixels;  // Into shared memory; check stillValid() after using them
+    };
+
+    SharedFrameReader() = default;
+    ~SharedFrameReader();
+
+    SharedFrameReader(const SharedFrameReader &) = delete;
+    SharedFrameReader & operator=(const SharedFrameReader &) = delete;
+
+    bool open(const std::string & name);
+    void close();
+
+    // Newest complete frame. Returns false if there is none yet or the writer is mid-way through it.
+    bool latest(Frame & frame) const;
+    // Whether the frame's pixels are still the ones published, i.e. the writer has not lapped them
+    [[nodiscard]] bool stillValid(const Frame & frame) const;
+    // The writer replaced or abandoned the segment; reopen to follow it
+    [[nodiscard]] bool isClosed() const;
+    [[nodiscard]] bool isOpen() const { return header != nullptr; }
+
+   private:
+    const SharedFrameSlot * slot(uint64_t sequence) const;
+
+    const SharedFrameHeader * header = nullptr;
+    size_t mappedBytes = 0;
+};
+
+#endif /* SharedFrameRing_hpp */
@@ -0,0 +1,28 @@
+//
+//  StderrLoggerChannel.cpp
+//  orgb
+//
+
+#include "StderrLoggerChannel.hpp"
+
+#include <cstdio>
+
+void StderrLoggerChannel::log(ofLogLevel level, const std::string & module, const std::string & message) {
+    log(level, module, "%s", message.c_str());
+}
+
+void StderrLoggerChannel::log(ofLogLevel level, const std::string & module, const char * format, ...) {
+    va_list args;
+    va_start(args, format);
+    log(level, module, format, args);
+    va_end(args);
+}
+
+void StderrLoggerChannel::log(ofLogLevel level, const std::string & module, const char * format, va_list args) {
+    fprintf(stderr, "[%s] ", ofGetLogLevelName(level, true).c_str());
+    if (!module.empty()) {
+        fprintf(stderr, "%s: ", module.c_str());
+    }
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+}
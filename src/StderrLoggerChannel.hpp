@@ -0,0 +1,25 @@
+//
+//  StderrLoggerChannel.hpp
+//  orgb
+//
+//  ofConsoleLoggerChannel's format, with every level on stderr. OF's console logger prints notices to stdout, so
+//  main() installs this one when stdout carries a stream, such as an offline render to "-".
+//
+
+#ifndef StderrLoggerChannel_hpp
+#define StderrLoggerChannel_hpp
+
+#include <cstdarg>
+#include <string>
+
+#include "ofMain.h"
+
+class StderrLoggerChannel : public ofBaseLoggerChannel {
+   public:
+    void log(ofLogLevel level, const std::string & module, const std::string & message) override;
+    // Attribute first: GCC does not accept override after it
+    OF_PRINTF_ATTR(4, 5) void log(ofLogLevel level, const std::string & module, const char * format, ...) override;
+    void log(ofLogLevel level, const std::string & module, const char * format, va_list args) override;
+};
+
+#endif /* StderrLoggerChannel_hpp */
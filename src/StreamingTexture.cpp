@@ -0,0 +1,71 @@
+//
+//  StreamingTexture.cpp
+//  orgb
+//
+
+#include "StreamingTexture.hpp"
+
+#include <cstring>
+
+#include "PixelBufferMapping.hpp"
+
+StreamingTexture::~StreamingTexture() { clear(); }
+
+bool StreamingTexture::isStreaming() const { return pixelBufferMappingAvailable(); }
+
+void StreamingTexture::clear() {
+    if (buffer != 0) {
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+    bytes = 0;
+    texture.clear();
+}
+
+void StreamingTexture::allocate(const ofPixels & pixels) {
+    clear();
+    texture.allocate(pixels);
+    bytes = pixels.getTotalBytes();
+    if (isStreaming()) {
+        glGenBuffers(1, &buffer);
+    }
+    ofLogNotice("StreamingTexture") << "Allocated " << pixels.getWidth() << "x" << pixels.getHeight() << "x"
+                                    << pixels.getNumChannels() << (isStreaming() ? " through a pixel buffer" : "");
+}
+
+void StreamingTexture::update(const ofPixels & pixels) {
+    if (!pixels.isAllocated()) {
+        return;
+    }
+    if (!texture.isAllocated() || pixels.getWidth() != texture.getWidth() ||
+        pixels.getHeight() != texture.getHeight() || pixels.getTotalBytes() != bytes) {
+        allocate(pixels);
+    }
+    if (buffer == 0) {
+        texture.loadData(pixels);  // glTexSubImage2D into the existing texture
+        return;
+    }
+
+    // Orphan the previous contents: if the GPU is still reading them, the driver hands over fresh storage instead of
+    // making the map wait
+    glBindBuffer(PIXEL_UNPACK_BUFFER, buffer);
+    glBufferData(PIXEL_UNPACK_BUFFER, bytes, nullptr, STREAM_DRAW);
+    void * mapped = mapPixelBuffer(PIXEL_UNPACK_BUFFER, bytes, MAP_WRITE_BIT | MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped == nullptr) {
+        glBindBuffer(PIXEL_UNPACK_BUFFER, 0);
+        texture.loadData(pixels);
+        return;
+    }
+    memcpy(mapped, pixels.getData(), bytes);
+    unmapPixelBuffer(PIXEL_UNPACK_BUFFER);
+
+    // With a buffer bound, the data argument is an offset into it and the call returns once the copy is queued
+    const ofTextureData & data = texture.getTextureData();
+    glBindTexture(data.textureTarget, data.textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(data.textureTarget, 0, 0, 0, pixels.getWidth(), pixels.getHeight(), ofGetGLFormat(pixels),
+                    GL_UNSIGNED_BYTE, nullptr);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(data.textureTarget, 0);
+    glBindBuffer(PIXEL_UNPACK_BUFFER, 0);
+}
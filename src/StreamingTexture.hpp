@@ -0,0 +1,42 @@
+//
+//  StreamingTexture.hpp
+//  orgb
+//
+//  A texture that is rewritten with a new frame of the same size over and over, as from a video stream. The texture
+//  is allocated once, and each update() copies the frame into a pixel unpack buffer and issues glTexSubImage2D from
+//  it, so the upload runs asynchronously instead of stalling the CPU. Constructing an ofImage from the pixels each
+//  draw, by contrast, allocates a new texture and uploads synchronously every time.
+//
+//  Without pixel buffer mapping (GLES 2) the upload goes straight to glTexSubImage2D, still into the same texture.
+//
+
+#ifndef StreamingTexture_hpp
+#define StreamingTexture_hpp
+
+#include "ofMain.h"
+
+class StreamingTexture {
+   public:
+    StreamingTexture() = default;
+    ~StreamingTexture();
+
+    StreamingTexture(const StreamingTexture &) = delete;
+    StreamingTexture & operator=(const StreamingTexture &) = delete;
+
+    // Upload a frame. Reallocates only when the size or channel count changes.
+    void update(const ofPixels & pixels);
+    void clear();
+
+    [[nodiscard]] bool isAllocated() const { return texture.isAllocated(); }
+    [[nodiscard]] bool isStreaming() const;  // Uploads go through the unpack buffer
+    ofTexture & getTexture() { return texture; }
+
+   private:
+    void allocate(const ofPixels & pixels);
+
+    ofTexture texture;
+    GLuint buffer = 0;
+    size_t bytes = 0;
+};
+
+#endif /* StreamingTexture_hpp */
@@ -0,0 +1,55 @@
+//
+//  TripleBuffer.hpp
+//  orgb
+//
+//  Lock-free handoff of the newest value from one producer thread to one consumer thread. The producer fills
+//  writeBuffer() and publishes it; the consumer acquires the newest published buffer and reads it in place. Neither
+//  side ever waits for the other, and a value published before the consumer took the previous one replaces it.
+//
+
+#ifndef TripleBuffer_hpp
+#define TripleBuffer_hpp
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer {
+   public:
+    // Producer side
+    T & writeBuffer() { return buffers[writeIndex]; }
+
+    // Hand writeBuffer() to the consumer and start on another buffer. Returns true if this replaced a published
+    // value the consumer never acquired.
+    bool publish() {
+        uint8_t previous = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+        return (previous & FRESH) != 0;
+    }
+
+    // Consumer side. Take the newest published value, if there is one the consumer has not seen. Otherwise returns
+    // false and readBuffer() keeps the previous value.
+    bool acquire() {
+        // Only the producer sets FRESH, so it cannot be cleared between the load and the exchange
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    T & readBuffer() { return buffers[readIndex]; }
+
+   private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;
+
+    std::array<T, 3> buffers;
+    uint8_t writeIndex = 0;          // Owned by the producer
+    std::atomic<uint8_t> middle{1};  // Index of the buffer between the two, plus FRESH once published
+    uint8_t readIndex = 2;           // Owned by the consumer
+};
+
+#endif /* TripleBuffer_hpp */
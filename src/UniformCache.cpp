@@ -0,0 +1,81 @@
+//
+//  UniformCache.cpp
+//  orgb
+//
+
+#include "UniformCache.hpp"
+
+#include <algorithm>
+
+size_t UniformCache::declare(const ofShader & shader, const std::string & name) {
+    size_t existing = find(name);
+    if (existing != npos) {
+        return existing;
+    }
+    GLint location = shader.getUniformLocation(name);
+    if (location < 0) {
+        // Not an error: the compiler drops uniforms a variant does not use. Sets become no-ops.
+        ofLogVerbose("UniformCache::declare") << "Uniform " << name << " not found";
+    }
+    uniforms.push_back({name, location, {}});
+    return uniforms.size() - 1;
+}
+
+size_t UniformCache::find(const std::string & name) const {
+    for (size_t i = 0; i < uniforms.size(); i++) {
+        if (uniforms[i].name == name) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+bool UniformCache::changed(Uniform & uniform, const float * values, size_t count) {
+    if (uniform.location < 0 ||
+        (uniform.values.size() == count && std::equal(values, values + count, uniform.values.begin()))) {
+        skipped++;
+        return false;
+    }
+    uniform.values.assign(values, values + count);
+    uploads++;
+    return true;
+}
+
+void UniformCache::set1f(size_t handle, float value) {
+    Uniform & uniform = uniforms[handle];
+    if (changed(uniform, &value, 1)) {
+        glUniform1f(uniform.location, value);
+    }
+}
+
+void UniformCache::set1i(size_t handle, int value) {
+    // Stored as a float for the comparison, which is exact for anything a uniform int is used for here
+    Uniform & uniform = uniforms[handle];
+    float asFloat = static_cast<float>(value);
+    if (changed(uniform, &asFloat, 1)) {
+        glUniform1i(uniform.location, value);
+    }
+}
+
+void UniformCache::set2f(size_t handle, float x, float y) {
+    Uniform & uniform = uniforms[handle];
+    float values[2] = {x, y};
+    if (changed(uniform, values, 2)) {
+        glUniform2f(uniform.location, x, y);
+    }
+}
+
+void UniformCache::set4f(size_t handle, float x, float y, float z, float w) {
+    Uniform & uniform = uniforms[handle];
+    float values[4] = {x, y, z, w};
+    if (changed(uniform, values, 4)) {
+        glUniform4f(uniform.location, x, y, z, w);
+    }
+}
+
+void UniformCache::set4fv(size_t handle, const float * values, size_t vec4Count) {
+    Uniform & uniform = uniforms[handle];
+    if (changed(uniform, values, vec4Count * 4)) {
+        glUniform4fv(uniform.location, static_cast<GLsizei>(vec4Count), values);
+    }
+}
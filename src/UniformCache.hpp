@@ -0,0 +1,61 @@
+//
+//  UniformCache.hpp
+//  orgb
+//
+//  Uniform locations resolved once per shader, plus the last value uploaded to each. Setting a uniform by name
+//  through ofShader hashes the name and calls into the driver every time; here a set is an index and a compare,
+//  and the driver is only called when the value actually changed.
+//
+//  Uniform values are program state and persist across begin()/end(), so skipping an unchanged upload is safe as
+//  long as nothing else writes the same uniform of the same program by name.
+//
+
+#ifndef UniformCache_hpp
+#define UniformCache_hpp
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ofMain.h"
+
+class UniformCache {
+   public:
+    UniformCache() = default;
+    ~UniformCache() = default;
+
+    // Forget every location and value, e.g. after the shader is reloaded
+    void clear() { uniforms.clear(); }
+
+    // Resolve name in shader and return a handle for the set functions. Declaring a name twice returns the same
+    // handle.
+    size_t declare(const ofShader & shader, const std::string & name);
+    [[nodiscard]] size_t find(const std::string & name) const;  // npos if not declared
+    static const size_t npos = static_cast<size_t>(-1);
+
+    // The shader must be bound
+    void set1f(size_t handle, float value);
+    void set1i(size_t handle, int value);
+    void set2f(size_t handle, float x, float y);
+    void set4f(size_t handle, float x, float y, float z, float w);
+    void set4fv(size_t handle, const float * values, size_t vec4Count);
+
+    [[nodiscard]] uint64_t getUploadCount() const { return uploads; }
+    [[nodiscard]] uint64_t getSkippedCount() const { return skipped; }
+
+   private:
+    struct Uniform {
+        std::string name;
+        GLint location;
+        std::vector<float> values;  // Empty until the first upload
+    };
+
+    // True if the uniform needs uploading, recording values as the new state
+    bool changed(Uniform & uniform, const float * values, size_t count);
+
+    std::vector<Uniform> uniforms;
+    uint64_t uploads = 0;
+    uint64_t skipped = 0;
+};
+
+#endif /* UniformCache_hpp */
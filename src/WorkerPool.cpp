@@ -0,0 +1,85 @@
+//
+//  WorkerPool.cpp
+//  orgb
+//
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t threadCount)
+    : job(nullptr), jobSize(0), jobGrain(1), nextIndex(0), activeWorkers(0), generation(0), stopping(false) {
+    for (size_t i = 1; i < threadCount; i++) {
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto & worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void WorkerPool::parallelFor(size_t n, size_t grain, const std::function<void(size_t, size_t)> & fn) {
+    grain = std::max<size_t>(grain, 1);
+    if (workers.empty() || n <= grain) {
+        fn(0, n);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobSize = n;
+        jobGrain = grain;
+        nextIndex.store(0);
+        activeWorkers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    runChunks();
+
+    // Every worker must check in before fn goes out of scope, even those that found no chunks left.
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return activeWorkers == 0; });
+    job = nullptr;
+}
+
+void WorkerPool::workerLoop() {
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        runChunks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--activeWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void WorkerPool::runChunks() {
+    while (true) {
+        size_t begin = nextIndex.fetch_add(jobGrain);
+        if (begin >= jobSize) {
+            return;
+        }
+        (*job)(begin, std::min(begin + jobGrain, jobSize));
+    }
+}
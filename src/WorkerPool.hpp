@@ -0,0 +1,57 @@
+//
+//  WorkerPool.hpp
+//  orgb
+//
+//  Small fork-join pool for data-parallel loops inside a frame. Workers are started once and sleep between
+//  jobs. parallelFor blocks until every index has been processed, and the calling thread takes chunks too.
+//
+//  The pool makes no ordering promises, so callers must make each index independent: read shared input, write
+//  only the output for that index. Results are then identical for any thread count.
+//
+
+#ifndef WorkerPool_hpp
+#define WorkerPool_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+   public:
+    // threadCount includes the calling thread, so WorkerPool(1) runs everything inline.
+    explicit WorkerPool(size_t threadCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool & operator=(const WorkerPool &) = delete;
+
+    // Call fn(begin, end) over [0, n) in chunks of grain indices.
+    void parallelFor(size_t n, size_t grain, const std::function<void(size_t, size_t)> & fn);
+
+    [[nodiscard]] size_t getThreadCount() const { return workers.size() + 1; }
+
+   private:
+    void workerLoop();
+    void runChunks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    // Current job, guarded by mutex while it is published and retired
+    const std::function<void(size_t, size_t)> * job;
+    size_t jobSize;
+    size_t jobGrain;
+    std::atomic<size_t> nextIndex;
+    size_t activeWorkers;
+    uint64_t generation;
+    bool stopping;
+};
+
+#endif /* WorkerPool_hpp */
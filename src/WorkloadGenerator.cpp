@@ -0,0 +1,328 @@
+//
+//  WorkloadGenerator.cpp
+//  orgb
+//
+
+#include "WorkloadGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#define WORKLOAD_TRILL_S 2.0         // Before the trill moves
+#define WORKLOAD_PEDAL_S 2.0         // Between pedal lifts
+#define WORKLOAD_REPEDAL_S 0.05      // Pedal up before it goes down again
+#define WORKLOAD_GUITAR_NOTE_S 0.5   // Before the fundamental changes
+#define WORKLOAD_MIC_NOTE_S 1.0      // Before the sung pitch moves to a new target
+#define WORKLOAD_MIC_GLIDE_PER_S 12  // Semitones per second towards the target
+#define WORKLOAD_VIBRATO_HZ 5.5
+#define WORKLOAD_VIBRATO_SEMITONES 0.3
+
+static const int thirds[] = {4, 3};                               // Major then minor, repeating
+static const int harmonics[] = {0, 12, 19, 24, 28, 31, 34, 36};  // Semitones above the fundamental
+
+// Steps between pattern changes lasting durationS, at least one
+static uint64_t stepsPer(double durationS, double rateHz) {
+    return std::max<uint64_t>(1, static_cast<uint64_t>(std::lround(durationS * rateHz)));
+}
+
+// Offset of the chord tone i above the root, stacked in thirds
+static int chordTone(int i) {
+    int offset = 0;
+    for (int t = 0; t < i; t++) {
+        offset += thirds[t % 2];
+    }
+    return offset;
+}
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadSettings & settings) : settings(settings), random(settings.seed) {
+    this->settings.lowNote = std::clamp(settings.lowNote, 0, WORKLOAD_HIGHEST_NOTE);
+    this->settings.highNote = std::clamp(settings.highNote, this->settings.lowNote, WORKLOAD_HIGHEST_NOTE);
+    this->settings.rateHz = std::max(settings.rateHz, 0.001);
+    this->settings.polyphony = std::max(settings.polyphony, 1);
+    root = this->settings.lowNote;
+    pitch = (this->settings.lowNote + this->settings.highNote) / 2.0;
+}
+
+// ============================================================================
+// Generation
+// ============================================================================
+
+size_t WorkloadGenerator::generateUntil(double untilS, std::vector<WorkloadEvent> & out) {
+    size_t before = out.size();
+    while (true) {
+        bool stepDue = nextStepS < untilS;
+        bool pendingDue = !pending.empty() && pending.top().event.timeS < untilS;
+        if (pendingDue && (!stepDue || pending.top().event.timeS <= nextStepS)) {
+            out.push_back(pending.top().event);
+            pending.pop();
+        } else if (stepDue) {
+            step();
+            steps++;
+            nextStepS = steps / settings.rateHz;  // Not accumulated, so long runs don't drift
+        } else {
+            break;
+        }
+    }
+    return out.size() - before;
+}
+
+void WorkloadGenerator::step() {
+    double t = nextStepS;
+    double stepS = 1.0 / settings.rateHz;
+    int low = settings.lowNote;
+    int high = settings.highNote;
+
+    switch (settings.pattern) {
+        case WorkloadPattern::CHORDS: {
+            int span = chordTone(settings.polyphony - 1);
+            root = randomNote(low, std::max(low, high - span));
+            int velocity = randomVelocity();
+            for (int i = 0; i < settings.polyphony; i++) {
+                int note = root + chordTone(i);
+                while (note > high) {
+                    note -= 12;  // Voice wide chords back into range
+                }
+                scheduleNote(t, std::max(note, low), velocity, settings.noteLengthS);
+            }
+            break;
+        }
+        case WorkloadPattern::TRILLS: {
+            if (steps % stepsPer(WORKLOAD_TRILL_S, settings.rateHz) == 0) {
+                root = randomNote(low, std::max(low, high - 2));
+            }
+            int note = steps % 2 == 0 ? root : std::min(root + 2, high);
+            // Released by the time it sounds again
+            scheduleNote(t, note, randomVelocity(), std::min(settings.noteLengthS, 2 * stepS));
+            break;
+        }
+        case WorkloadPattern::GLISS: {
+            if (root + direction > high || root + direction < low) {
+                direction = -direction;
+            }
+            root = std::clamp(root + (steps == 0 ? 0 : direction), low, high);
+            scheduleNote(t, root, randomVelocity(), settings.noteLengthS);
+            break;
+        }
+        case WorkloadPattern::SUSTAIN: {
+            uint64_t stepsPerPedal = stepsPer(WORKLOAD_PEDAL_S, settings.rateHz);
+            if (steps % stepsPerPedal == 0) {
+                if (steps > 0) {
+                    schedule({t, WorkloadEventType::SUSTAIN, 64, 0, 0, false, {}});
+                }
+                schedule({t + WORKLOAD_REPEDAL_S, WorkloadEventType::SUSTAIN, 64, 127, 0, false, {}});
+                root = randomNote(low, std::max(low, high - chordTone(settings.polyphony - 1)));
+            }
+            int note = root + chordTone(static_cast<int>(steps % stepsPerPedal) % settings.polyphony);
+            while (note > high) {
+                note -= 12;
+            }
+            // Short notes; the pedal is what holds them
+            scheduleNote(t + WORKLOAD_REPEDAL_S, std::max(note, low), randomVelocity(),
+                         std::min(settings.noteLengthS, stepS / 2));
+            break;
+        }
+        case WorkloadPattern::GUITAR: {
+            uint64_t stepsPerNote = stepsPer(WORKLOAD_GUITAR_NOTE_S, settings.rateHz);
+            if (steps % stepsPerNote == 0) {
+                root = randomNote(std::max(low, GUITAR_MIDI_MIN), std::min(high, GUITAR_MIDI_MAX));
+            }
+            // Plucked: every partial decays over the note, higher ones faster
+            double sinceNoteS = (steps % stepsPerNote) * stepS;
+            std::uniform_real_distribution<float> jitter(0.8, 1.0);
+            std::vector<std::pair<float, float>> partials;
+            for (int i = 0; i < settings.polyphony; i++) {
+                int note = root + harmonics[i % 8] + 12 * (i / 8);
+                if (note > MIDI_NOTE_MAX) {
+                    break;
+                }
+                float amplitude = jitter(random) * std::exp(-sinceNoteS * (2 + i)) / (1 + i);
+                partials.emplace_back(note, amplitude);
+            }
+            schedulePartials(t, false, partials);
+            break;
+        }
+        case WorkloadPattern::MIC: {
+            if (steps % stepsPer(WORKLOAD_MIC_NOTE_S, settings.rateHz) == 0) {
+                root = randomNote(low, high);
+            }
+            double glide = WORKLOAD_MIC_GLIDE_PER_S * stepS;
+            pitch += std::clamp(root - pitch, -glide, glide);
+            double sung = pitch + WORKLOAD_VIBRATO_SEMITONES * std::sin(TWO_PI * WORKLOAD_VIBRATO_HZ * t);
+            std::vector<std::pair<float, float>> partials;
+            for (int i = 0; i < settings.polyphony; i++) {
+                partials.emplace_back(sung + 12 * std::log2(i + 1), 0.8f / (i + 1));
+            }
+            schedulePartials(t, true, partials);
+            break;
+        }
+    }
+}
+
+void WorkloadGenerator::schedule(WorkloadEvent event) { pending.push({std::move(event), sequence++}); }
+
+void WorkloadGenerator::scheduleNote(double timeS, int note, int velocity, double lengthS) {
+    schedule({timeS, WorkloadEventType::NOTE_ON, note, velocity, nextMessageId++, false, {}});
+    schedule({timeS + lengthS, WorkloadEventType::NOTE_OFF, note, 0, 0, false, {}});
+}
+
+void WorkloadGenerator::schedulePartials(double timeS, bool mic, std::vector<std::pair<float, float>> partials) {
+    WorkloadEvent event{timeS, WorkloadEventType::PARTIALS, 0, 0, nextMessageId, mic, std::move(partials)};
+    nextMessageId += MIDI_NOTE_MAX + 1;  // ofApp offsets each partial's id by its note
+    schedule(std::move(event));
+}
+
+int WorkloadGenerator::randomNote(int low, int high) { return std::uniform_int_distribution<int>(low, high)(random); }
+
+int WorkloadGenerator::randomVelocity() { return std::uniform_int_distribution<int>(50, 115)(random); }
+
+// ============================================================================
+// Delivery
+// ============================================================================
+
+void WorkloadGenerator::apply(const WorkloadEvent & event, KeyState & ks) {
+    switch (event.type) {
+        case WorkloadEventType::NOTE_ON:
+            ks.newKeyPressedHandler(event.note, ofMap(event.velocity, 0, MIDI_NOTE_MAX, 0, 1), event.messageId);
+            break;
+        case WorkloadEventType::NOTE_OFF:
+            ks.keyReleasedHandler(event.note);
+            break;
+        case WorkloadEventType::SUSTAIN:
+            if (event.velocity >= 64) {
+                ks.sustainOnHandler(getSystemTimeSecondsPrecise());
+            } else {
+                ks.sustainOffHandler(getSystemTimeSecondsPrecise());
+            }
+            break;
+        case WorkloadEventType::PARTIALS: {
+            std::unordered_map<int, float> presses;
+            std::unordered_map<int, unsigned int> messageIds;
+            for (const auto & [partialPitch, amplitude] : event.partials) {
+                int note = static_cast<int>(std::lround(partialPitch));
+                // The guitar sends MIDI velocities, so its amplitudes arrive in 128 steps
+                presses[note] = event.mic ? amplitude : std::round(amplitude * MIDI_NOTE_MAX) / MIDI_NOTE_MAX;
+                messageIds[note] = event.messageId + note;
+            }
+            ks.ephemeralKeyPressMapHandler(presses, messageIds);
+            break;
+        }
+    }
+}
+
+// OSC 1.0: address and type tags as padded strings, then big-endian 32-bit arguments
+class OscWriter {
+   public:
+    explicit OscWriter(const std::string & address) { string(address); }
+
+    void add(int32_t value) {
+        tags += 'i';
+        word(static_cast<uint32_t>(value));
+    }
+    void add(float value) {
+        tags += 'f';
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        word(bits);
+    }
+    void add(const std::string & value) {
+        tags += 's';
+        size_t start = arguments.size();
+        arguments.insert(arguments.end(), value.begin(), value.end());
+        arguments.resize(start + (value.size() / 4 + 1) * 4, 0);
+    }
+
+    std::vector<uint8_t> finish() {
+        string(tags);
+        packet.insert(packet.end(), arguments.begin(), arguments.end());
+        return std::move(packet);
+    }
+
+   private:
+    void string(const std::string & s) {
+        size_t start = packet.size();
+        packet.insert(packet.end(), s.begin(), s.end());
+        packet.resize(start + (s.size() / 4 + 1) * 4, 0);  // At least one terminating zero
+    }
+    void word(uint32_t value) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            arguments.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    std::vector<uint8_t> packet;
+    std::vector<uint8_t> arguments;
+    std::string tags = ",";
+};
+
+std::vector<uint8_t> WorkloadGenerator::encodeOsc(const WorkloadEvent & event) {
+    switch (event.type) {
+        case WorkloadEventType::NOTE_ON:
+        case WorkloadEventType::NOTE_OFF: {
+            OscWriter osc(WORKLOAD_KEYBOARD_OSC_ADDRESS);
+            osc.add(std::string(event.type == WorkloadEventType::NOTE_ON ? "note_on" : "note_off"));
+            osc.add(0);  // Channel
+            osc.add(event.note);
+            osc.add(event.velocity);
+            osc.add(static_cast<int32_t>(event.messageId));
+            return osc.finish();
+        }
+        case WorkloadEventType::SUSTAIN: {
+            OscWriter osc(WORKLOAD_KEYBOARD_OSC_ADDRESS);
+            osc.add(std::string("control_change"));
+            osc.add(0);
+            osc.add(event.note);
+            osc.add(event.velocity);
+            osc.add(0);  // Time
+            return osc.finish();
+        }
+        case WorkloadEventType::PARTIALS:
+            if (event.mic) {
+                OscWriter osc(WORKLOAD_MIC_OSC_ADDRESS);
+                osc.add(0);  // Time tag, unused by the app
+                for (const auto & [partialPitch, amplitude] : event.partials) {
+                    osc.add(partialPitch);
+                    osc.add(amplitude);
+                }
+                osc.add(static_cast<int32_t>(event.messageId));
+                return osc.finish();
+            } else {
+                OscWriter osc(WORKLOAD_GUITAR_OSC_ADDRESS);
+                for (const auto & [partialPitch, amplitude] : event.partials) {
+                    osc.add(static_cast<int32_t>(std::lround(partialPitch)));
+                    osc.add(static_cast<int32_t>(std::lround(amplitude * MIDI_NOTE_MAX)));
+                }
+                osc.add(static_cast<int32_t>(event.messageId));
+                return osc.finish();
+            }
+    }
+    return {};
+}
+
+// ============================================================================
+// Names
+// ============================================================================
+
+static const std::pair<WorkloadPattern, const char *> patternNames[] = {
+    {WorkloadPattern::CHORDS, "chords"}, {WorkloadPattern::TRILLS, "trills"}, {WorkloadPattern::GLISS, "gliss"},
+    {WorkloadPattern::SUSTAIN, "sustain"}, {WorkloadPattern::GUITAR, "guitar"}, {WorkloadPattern::MIC, "mic"},
+};
+
+bool WorkloadGenerator::parsePattern(const std::string & name, WorkloadPattern & pattern) {
+    for (const auto & [value, patternName] : patternNames) {
+        if (name == patternName) {
+            pattern = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string WorkloadGenerator::patternName(WorkloadPattern pattern) {
+    for (const auto & [value, name] : patternNames) {
+        if (value == pattern) {
+            return name;
+        }
+    }
+    return "";
+}
@@ -0,0 +1,117 @@
+//
+//  WorkloadGenerator.hpp
+//  orgb
+//
+//  Synthetic, reproducible input for benchmarks and soak tests. A generator plays one pattern (chords, trills,
+//  glissandi, pedalled arpeggios, guitar partial streams or a sung pitch track) as a time-ordered stream of events,
+//  which can be applied straight to a KeyState the way ofApp's handlers would, or encoded as the OSC messages the
+//  app receives. The same settings and seed always give the same stream.
+//
+//  The rate is pattern steps per second: chords, trill or glissando notes, arpeggio notes, or partial frames.
+//  Notes 107 to 109 switch forms and trigger stress modes in the app, so generated notes stay below them.
+//
+
+#ifndef WorkloadGenerator_hpp
+#define WorkloadGenerator_hpp
+
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "KeyState.hpp"
+#include "Utilities.hpp"
+
+// As in ofApp.h
+#define WORKLOAD_KEYBOARD_OSC_ADDRESS "/midi/keyboard"
+#define WORKLOAD_GUITAR_OSC_ADDRESS "/midi-guitar"
+#define WORKLOAD_MIC_OSC_ADDRESS "/pitch/mic0"
+
+#define WORKLOAD_HIGHEST_NOTE 106
+
+enum class WorkloadPattern {
+    CHORDS,   // Block chords of polyphony notes, stacked in thirds
+    TRILLS,   // Two notes a tone apart, alternating, moving every two seconds
+    GLISS,    // Chromatic sweeps up and down the range, notes overlapping for noteLengthS
+    SUSTAIN,  // Arpeggios of short notes under the pedal, which is lifted every two seconds
+    GUITAR,   // Ephemeral frames of polyphony harmonic partials over a moving fundamental
+    MIC,      // Ephemeral frames following a single sung pitch with vibrato
+};
+
+enum class WorkloadEventType {
+    NOTE_ON,
+    NOTE_OFF,
+    SUSTAIN,   // velocity is the pedal value, 127 down and 0 up
+    PARTIALS,  // Guitar or mic frame
+};
+
+struct WorkloadEvent {
+    double timeS;  // Since the generator started
+    WorkloadEventType type;
+    int note;
+    int velocity;  // 0 to 127
+    unsigned int messageId;
+    bool mic;                                       // PARTIALS: from the mic tracker rather than the guitar
+    std::vector<std::pair<float, float>> partials;  // PARTIALS: pitch (MIDI) and amplitude (0 to 1)
+};
+
+struct WorkloadSettings {
+    WorkloadPattern pattern = WorkloadPattern::CHORDS;
+    double rateHz = 4;
+    int polyphony = 4;  // Chord size, arpeggio length, or partials per frame
+    int lowNote = PIANO_LOWEST_MIDI;
+    int highNote = WORKLOAD_HIGHEST_NOTE;
+    double noteLengthS = 0.25;
+    unsigned int seed = 1;
+};
+
+class WorkloadGenerator {
+   public:
+    explicit WorkloadGenerator(const WorkloadSettings & settings);
+
+    // Append every event before untilS not yet generated, in time order. Returns the number appended.
+    size_t generateUntil(double untilS, std::vector<WorkloadEvent> & out);
+
+    // Apply an event as ofApp's MIDI and OSC handlers would
+    static void apply(const WorkloadEvent & event, KeyState & ks);
+    // The OSC packet ofApp would receive for the event
+    static std::vector<uint8_t> encodeOsc(const WorkloadEvent & event);
+
+    static bool parsePattern(const std::string & name, WorkloadPattern & pattern);
+    static std::string patternName(WorkloadPattern pattern);
+
+    [[nodiscard]] const WorkloadSettings & getSettings() const { return settings; }
+
+   private:
+    struct Pending {
+        WorkloadEvent event;
+        uint64_t sequence;  // Keeps events at the same time in the order they were scheduled
+        bool operator>(const Pending & other) const {
+            return event.timeS != other.event.timeS ? event.timeS > other.event.timeS : sequence > other.sequence;
+        }
+    };
+
+    void step();
+    void schedule(WorkloadEvent event);
+    void scheduleNote(double timeS, int note, int velocity, double lengthS);
+    void schedulePartials(double timeS, bool mic, std::vector<std::pair<float, float>> partials);
+    int randomNote(int low, int high);
+    int randomVelocity();
+
+    WorkloadSettings settings;
+    std::mt19937 random;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<>> pending;
+    uint64_t sequence = 0;
+    unsigned int nextMessageId = 1;
+    uint64_t steps = 0;
+    double nextStepS = 0;
+
+    // Pattern state
+    int root = 0;
+    int direction = 1;
+    double pitch = 0;
+};
+
+#endif /* WorkloadGenerator_hpp */
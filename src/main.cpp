@@ -1,3 +1,4 @@
+#include "StderrLoggerChannel.hpp"
 #include "ofApp.h"
 #include "ofMain.h"
 
@@ -13,6 +14,25 @@ int main() {
     height = 32;
 #endif
 
+    // An offline render (see ofAppOfflineRender.cpp) streaming to stdout keeps the stream clean of log lines
+    std::string offlineOutput = getEnv("OFFLINE_RENDER_OUTPUT", "");
+    if (offlineOutput == "-") {
+        ofSetLoggerChannel(std::make_shared<StderrLoggerChannel>());
+    }
+
+#if !defined(TARGET_RASPBERRY_PI) && !defined(__EMSCRIPTEN__)
+    // An offline render still needs a GL context, but not a window on screen
+    if (!offlineOutput.empty()) {
+        ofGLFWWindowSettings settings;
+        settings.setSize(width, height);
+        settings.windowMode = OF_WINDOW;
+        settings.visible = false;
+        ofCreateWindow(settings);
+        ofRunApp(new ofApp());
+        return 0;
+    }
+#endif
+
     //	ofSetupOpenGL(1024,768,OF_WINDOW);			// <-------- setup the GL contex
     ofSetupOpenGL(width, height, OF_WINDOW);  // <-------- setup the GL contex
     // this kicks off the running of my app
@@ -68,6 +68,9 @@ void ofApp::initializeForms() {
 #endif
     }
     // clang-format on
+    for (auto & form : forms) {
+        form->quality.setBounds(qualityMinLevel, qualityMaxLevel);
+    }
 
     // Clear every time because resize should just reinitialize everything from scratch.
     gui.clear();
@@ -152,10 +155,24 @@ void ofApp::setup() {
     ofLogNotice("ofApp::setup") << "Log levels configured";
 
     enableNDI = getEnv("ENABLE_NDI", "true") == "true";
+    adaptiveQuality = getEnv("ADAPTIVE_QUALITY", "false") == "true";
+    qualityMinLevel = stof(getEnv("QUALITY_MIN_LEVEL", "0"));
+    qualityMaxLevel = stof(getEnv("QUALITY_MAX_LEVEL", "1"));
+    frameWorkStartS = getSystemTimeSecondsPrecise();
+    gpuTimers = getEnv("GPU_TIMERS", "false") == "true";
+    FrameProfiler::setThreadName("Main");
+    FrameProfiler::setEnabled(getEnv("PROFILER", "false") == "true");
+    profilerTracePath = getEnv("PROFILER_TRACE", "");
+    sharedFrameOutput = !getEnv("SHARED_FRAME_OUTPUT", "").empty();
+    if (sharedFrameOutput) {
+        sharedFrames.setup(getEnv("SHARED_FRAME_OUTPUT"), stoi(getEnv("SHARED_FRAME_SLOTS", "3")));
+    }
 #ifdef HAS_MQTT
     enableMQTT = getEnv("ENABLE_MQTT", "true") == "true";
     requireMQTT = getEnv("REQUIRE_MQTT", "true") == "true";
 #endif
+    offlineRenderSetup();  // Overrides the live inputs above
+    inputJournalSetup();
 
     try {
         exitAfterFrames = std::optional<int>(stoi(getEnv("EXIT_AFTER_FRAMES")));
@@ -175,6 +192,14 @@ void ofApp::setup() {
         static_cast<uint8_t>(ofMap(idleLedBrightnessPct, 0, 1, 0, 100));  // LED API expects uint8_t [0,100]
 
     clockwiseRotations = initializeLEDMatrices();
+    panelResolve.setup(ofGetWidth(), ofGetHeight(), matrixWidth, matrixHeight, clockwiseRotations);
+    panelResolve.setLut(stof(getEnv("LED_GAMMA", "1.0")), stof(getEnv("LED_LUT_BRIGHTNESS", "1.0")));
+    ledReadback.setFlipVertical(false);    // The panel FBO is already stored top-down
+    frameReadback.setFlipVertical(false);  // Reads PanelResolve's frame, as nothing is drawn to the screen
+    image.setUseTexture(false);
+    ledTargetBrightness = ledBrightness;
+    ledOutput.start([this](ofPixels & pixels) { sendToLEDs(pixels); },
+                    stof(getEnv("LED_REFRESH_RATE", ofToString(TARGET_FRAME_RATE))));
 #endif
 
     ks = KeyState();
@@ -212,12 +237,14 @@ void ofApp::setup() {
 
     // OSC
 #ifndef __EMSCRIPTEN__
-    ofLogNotice("OSC") << "Setting up OSC receiver...";
-    receiver.setup(OSC_PORT);
-    ofLogNotice("OSC") << "Online. Port: " << OSC_PORT;
+    if (!offlineRender) {
+        ofLogNotice("OSC") << "Setting up OSC receiver...";
+        receiver.setup(OSC_PORT);
+        ofLogNotice("OSC") << "Online. Port: " << OSC_PORT;
 
-    // Start OSC thread for background message receiving
-    startOSCThread();
+        // Start OSC thread for background message receiving
+        startOSCThread();
+    }
 #endif
 
 #ifdef HAS_MQTT
@@ -236,25 +263,31 @@ void ofApp::setup() {
         ofLogNotice("NDI") << "Initializing NDI and watching sources.";
         NDIlib_initialize();
         finder_.watchSources();
+        startNDIThread();
     }
 #endif
 #endif
 
+    if (offlineRender) {
+        offlineRenderTimingHandler();
+    } else {
 #ifdef TARGET_RASPBERRY_PI
-    ofLogVerbose() << "VerticalSync disabled; FPS Target: " << ofGetTargetFrameRate();
-    ofSetFrameRate(TARGET_FRAME_RATE);
-    // Do not use setFrameRate if we're not bound by a display. Leave to LED to limit.
+        ofLogVerbose() << "VerticalSync disabled; FPS Target: " << ofGetTargetFrameRate();
+        ofSetFrameRate(TARGET_FRAME_RATE);
+        // Do not use setFrameRate if we're not bound by a display. Leave to LED to limit.
 #else
-    ofSetVerticalSync(true);
-    ofSetFrameRate(TARGET_FRAME_RATE);
-    ofLogVerbose() << "VerticalSync enabled; FPS Target: " << ofGetTargetFrameRate();
-    // TODO Does this impact Pi / LED ?
+        ofSetVerticalSync(true);
+        ofSetFrameRate(TARGET_FRAME_RATE);
+        ofLogVerbose() << "VerticalSync enabled; FPS Target: " << ofGetTargetFrameRate();
+        // TODO Does this impact Pi / LED ?
 #endif
+    }
 
     // Initialize post-processing pipeline
     int width = ofGetWidth();
     int height = ofGetHeight();
     postProcessing = std::make_shared<ShaderPipeline>(width, height);
+    postProcessing->setRenderGraph(dm.graph);
 
     // Create and configure effects
     filmGrainEffect = std::make_shared<FilmGrainEffect>();
@@ -295,9 +328,16 @@ void ofApp::setup() {
 
 //--------------------------------------------------------------
 void ofApp::update() {
+    frameWorkStartS = getSystemTimeSecondsPrecise();
+    FrameProfiler::collect();  // The previous frame's zones, from every thread
+    PROFILE_ZONE("Update");
     noteDebugHandler();
     startupTimeHandler();
     exitAfterFramesHandler();
+    if (offlineRender) {
+        offlineRenderUpdateHandler();  // Replays this frame's events before the form sees them
+    }
+    inputJournalUpdateHandler();
 
     if (monitorFrameRateMode) {
         monitorFrameRate(ofGetTargetFrameRate(), ofGetFrameNum(), ofGetElapsedTimef(), ofGetFrameRate());
@@ -306,13 +346,17 @@ void ofApp::update() {
 #ifndef __EMSCRIPTEN__
 #ifndef NO_NDI
     if (enableNDI) {
+        PROFILE_ZONE("NDI Update");
         ndiUpdateHandler();  // Returns true when we have an active frame
     }
 #endif
 #endif
 
     double t0 = getSystemTimeSecondsPrecise();
-    forms[currentFormIndex]->update(ks, clr);
+    {
+        PROFILE_ZONE_NAMED(forms[currentFormIndex]->name + " Update");
+        forms[currentFormIndex]->update(ks, clr);
+    }
     if (monitorFrameRateMode) {
         warnOnSlow("Form Update", t0, TARGET_FRAME_TIME_S / WARN_INTERVAL_DENOMINATOR_UPDATE_FORM, ofGetFrameNum(),
                    ofGetElapsedTimef());
@@ -325,7 +369,10 @@ void ofApp::update() {
 #endif
 
     // Clean all keys that have been released for more than 10 seconds.
-    ks.cleanup(KEYSTATE_CLEANUP_TIME, ofGetFrameNum(), ofGetLastFrameTime());
+    {
+        PROFILE_ZONE("KeyState Cleanup");
+        ks.cleanup(KEYSTATE_CLEANUP_TIME, ofGetFrameNum(), ofGetLastFrameTime());
+    }
 
     // NOTE: Disable homeostasis
     // ks.circumplexHomeostasis();
@@ -345,9 +392,16 @@ void ofApp::update() {
 //--------------------------------------------------------------
 void ofApp::draw() {
     double t0 = getSystemTimeSecondsPrecise();
+    PROFILE_ZONE("Draw");
 
     bool ndiPreempt = false;
 
+    dm.graph->getTimer().setEnabled(gpuTimers || debugShow || adaptiveQuality);
+#ifdef TARGET_RASPBERRY_PI
+    // Everything below that would go to the screen is composed for the panels instead
+    panelResolve.begin();
+    ofClear(0, 0, 0, 255);
+#endif
     dm.beginDraw();  // Sets a new main frame Context
 
     //    ofEnableAlphaBlending();
@@ -363,15 +417,19 @@ void ofApp::draw() {
 #endif
 #endif
 
-    ofPushStyle();
-    forms[currentFormIndex]->draw(ks, clr, dm);
-    ofPopStyle();
+    {
+        PROFILE_ZONE_NAMED(forms[currentFormIndex]->name + " Draw");
+        ofPushStyle();
+        forms[currentFormIndex]->draw(ks, clr, dm);
+        ofPopStyle();
+    }
 
     // End drawing to FBO (don't draw yet)
     dm.endDraw();
 
     // Apply post-processing pipeline and draw to screen
     if (postProcessing && postProcessing->hasEnabledEffects()) {
+        PROFILE_ZONE("Post-processing");
         postProcessing->processAndDraw(dm.getFboFront(), 0, 0);
     } else {
         // No post-processing - just draw FBO directly
@@ -393,6 +451,23 @@ void ofApp::draw() {
         ofSetColor(ofColor::fromHsb(ofMap(ks.arousalPct(), 0, 1, 255, 170), 255, 255));
         ofDrawRectangle(0, ofGetHeight() - 5, ofGetWidth() * ks.arousalPct(), 5);
         ofPopStyle();
+
+        float overlayY = 5;
+        if (adaptiveQuality) {
+            std::string q = forms[currentFormIndex]->quality.getSummary();
+            overlayY += helveticaNeueTiny.getStringBoundingBox(q, 0, 0).getHeight();
+            helveticaNeueTiny.drawString(q, 5, overlayY);
+            overlayY += 5;
+        }
+        std::string g = dm.graph->getSummary();
+        overlayY += helveticaNeueTiny.getLineHeight();
+        helveticaNeueTiny.drawString(g, 5, overlayY);
+        overlayY += helveticaNeueTiny.getStringBoundingBox(g, 0, 0).getHeight() + 5;
+        std::string t = dm.graph->getTimer().getSummary();
+#ifdef TARGET_RASPBERRY_PI
+        t = ledOutput.getSummary() + "\n" + t;
+#endif
+        helveticaNeueTiny.drawString(t, 5, overlayY + helveticaNeueTiny.getLineHeight());
     }
 
     bool showWebsite = getEnv("SHOW_WEBSITE", "false") == "true";
@@ -402,15 +477,55 @@ void ofApp::draw() {
     debugModeHandler();
 
 #ifdef TARGET_RASPBERRY_PI
-    brightnessUpdateHandler();
-    image.clear();
-    image.grabScreen(0, 0, ofGetWidth(), ofGetHeight());
-    led.draw(image);
+    {
+        PROFILE_ZONE("LED Submit");
+        panelResolve.end();
+        brightnessUpdateHandler();
+        // Only the panel-sized result is read back. The panels show the frame read back PIXEL_READBACK_RING_SIZE - 1
+        // frames ago, so nothing waits on the GPU, and the output thread sends it, so nothing waits on the LED driver.
+        dm.graph->getTimer().begin("Panel Resolve");
+        panelResolve.resolve();
+        dm.graph->getTimer().end();
+        ofFbo & panel = panelResolve.getPanel();
+        panel.bind();
+        ledReadback.request(0, 0, panel.getWidth(), panel.getHeight());
+        panel.unbind();
+        ofPixels * ledPixels = ledReadback.latest();
+        if (ledPixels != nullptr) {
+            ledOutput.submit(*ledPixels);
+        }
+    }
+#endif
+    if (sharedFrameOutput) {
+        PROFILE_ZONE("Shared Frame Output");
+        // Also read back a couple of frames late, so publishing never waits on the GPU
+#ifdef TARGET_RASPBERRY_PI
+        panelResolve.getFrame().bind();
+        frameReadback.request(0, 0, ofGetWidth(), ofGetHeight());
+        panelResolve.getFrame().unbind();
+#else
+        frameReadback.request(0, 0, ofGetWidth(), ofGetHeight());
 #endif
+        ofPixels * framePixels = frameReadback.latest();
+        if (framePixels != nullptr) {
+            sharedFrames.write(*framePixels);
+        }
+    }
+    if (offlineRender) {
+        offlineRenderDrawHandler();
+    }
     if (monitorFrameRateMode) {
         warnOnSlow("Draw", t0, TARGET_FRAME_TIME_S / WARN_INTERVAL_DENOMINATOR_DRAW, ofGetFrameNum(),
                    ofGetElapsedTimef());
     }
+
+    // Work time alone would miss GPU-bound frames, so the GPU time and late frame intervals count too
+    if (adaptiveQuality) {
+        GpuTimer & timer = dm.graph->getTimer();
+        double gpuS = timer.isSupported() ? timer.getTotalMs() / 1000.0 : -1;
+        forms[currentFormIndex]->quality.recordFrame(getSystemTimeSecondsPrecise() - frameWorkStartS, gpuS,
+                                                     ofGetLastFrameTime());
+    }
 }
 
 //--------------------------------------------------------------
@@ -438,9 +553,19 @@ void ofApp::windowResized(int w, int h) {
     // Resize post-processing pipeline
     if (postProcessing) {
         postProcessing->resize(w, h);
+        postProcessing->setRenderGraph(dm.graph);
         ofLogNotice("ofApp::windowResized") << "Resized shader pipeline to " << w << "x" << h;
     }
 
+#ifdef TARGET_RASPBERRY_PI
+    // As in initializeLEDMatrices()
+    if (matrixIsWindow) {
+        matrixWidth = w;
+        matrixHeight = h;
+    }
+    panelResolve.setup(w, h, matrixWidth, matrixHeight, clockwiseRotations);
+#endif
+
     initializeForms();
     switchToForm(currentFormIndex);
 }
@@ -462,9 +587,19 @@ void ofApp::switchToForm(int formIndex) {
 }
 
 void ofApp::exit() {
+#ifdef TARGET_RASPBERRY_PI
+    ledOutput.stop();
+#endif
+
 #ifndef __EMSCRIPTEN__
     // Stop OSC thread
     stopOSCThread();
+
+#ifndef NO_NDI
+    if (enableNDI) {
+        stopNDIThread();
+    }
+#endif
 #endif
 
 #ifdef HAS_MQTT
@@ -480,6 +615,10 @@ void ofApp::exit() {
     }
 #endif
 
+    sharedFrames.close();
+    offlineWriter.close();
+    journalRecord.close();
+
     ofLogNotice("ofApp") << "Cleanly exiting.";
 }
 
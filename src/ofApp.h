@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <optional>
 
 #define HAS_MQTT
@@ -36,23 +37,33 @@
 #include "Effects/AllEffects.hpp"
 #include "FatGlowShape.hpp"
 #include "Field.hpp"
+#include "FrameProfiler.hpp"
+#include "FrameSequenceWriter.hpp"
 #include "GlowLinePlayground.hpp"
 #include "GlowShape.hpp"
 #include "GravityParticles.hpp"
 #include "ImageSprocket.hpp"
+#include "InputJournal.hpp"
+#include "InputLog.hpp"
 #include "KeyState.hpp"
 #include "LaserWaves.hpp"
+#include "LedOutput.hpp"
 #include "MeshGrid.hpp"
 #include "NoiseGrid.hpp"
 #include "Orbit.hpp"
+#include "PanelResolve.hpp"
+#include "PixelReadback.hpp"
 #include "PointWaves.hpp"
 #include "Press.hpp"
 #include "RadialParticles.hpp"
 #include "RandomParticles.hpp"
 #include "RapidThunder.hpp"
 #include "ShaderPipeline.hpp"
+#include "SharedFrameRing.hpp"
 #include "Shape.hpp"
+#include "StreamingTexture.hpp"
 #include "Thunder.hpp"
+#include "TripleBuffer.hpp"
 #include "Utilities.hpp"
 #include "VisualForm.hpp"
 #ifndef __EMSCRIPTEN__
@@ -164,10 +175,23 @@ class ofApp : public ofBaseApp {
     void jsonHandlerOfParamMessage(nlohmann::basic_json<> & j);
     void jsonHandlerClassification(nlohmann::basic_json<> & j);
     std::string dumpSettingsToJsonFile();
+    std::string dumpProfileToTraceFile();  // Chrome trace of the zones kept, with percentiles logged
     void loadSettingsFromJsonString(const std::string & payloadString);
     void noteOnHandler(int key, float velocityPct, unsigned int messageId, bool ephemeral = false);
     void noteOffHandler(int key);
 
+    /*
+     * Input journal: decoded input recorded at the JSON handlers, and replayed through them
+     */
+    InputJournalWriter journalRecord;
+    InputJournalReader journalReplay;
+    double journalReplaySpeed = 1.0;
+    std::chrono::steady_clock::time_point journalReplayStart;
+    void inputJournalSetup();
+    void inputJournalUpdateHandler();
+    void replayJournalEvent(const InputJournalEvent & event);
+    bool importInputLog(const std::string & textPath, const std::string & journalPath);
+
     /*
      * LED Matrices
      */
@@ -178,9 +202,15 @@ class ofApp : public ofBaseApp {
     void brightnessUpdateHandler();
     ofParameter<float> ledBrightnessPct;      // Out of 100%, cast to uint8_t
     ofParameter<float> idleLedBrightnessPct;  // Out of 100%
-    int matrixWidth;
+    int matrixWidth;   // Frame size the driver takes, after any rotation PanelResolve does
     int matrixHeight;
-    ofImage image;
+    bool matrixIsWindow = false;  // The driver maps pixels itself and takes the window-sized frame
+    PanelResolve panelResolve;
+    PixelReadback ledReadback;
+    LedOutput ledOutput;
+    ofImage image;                                 // RGB copy of the output thread's pixels for the LED driver
+    std::atomic<uint8_t> ledTargetBrightness{0};  // Set by the main thread, applied by the output thread
+    void sendToLEDs(ofPixels & pixels);           // Runs on ledOutput's thread
 
     int clockwiseRotations;
 
@@ -255,9 +285,18 @@ class ofApp : public ofBaseApp {
     ofxNDIFinder finder_;
     ofxNDIReceiver receiver_;
     ofxNDIRecvVideoFrameSync video_;
-    ofPixels pixels_;
-
-    bool ndiUpdateHandler();
+    TripleBuffer<ofPixels> ndiFrames;  // Newest decoded frame, from ndiThread to the main thread
+    StreamingTexture ndiTexture;       // Uploaded from ndiFrames only when a new frame arrives
+
+    // Discovery, connection and decoding run in ndiThread, so update() never waits on the network
+    std::thread ndiThread;
+    std::atomic<bool> ndiThreadRunning{false};
+    std::atomic<bool> ndiConnected{false};
+    void startNDIThread();
+    void stopNDIThread();
+    void ndiThreadFunction();  // Runs in background thread
+    bool ndiReceiveHandler();  // Runs in background thread
+    bool ndiUpdateHandler();   // Processes frames in main thread
     bool ndiDrawHandler();
     bool ndiScanForVideoSources();
     bool ndiSwitchToVideoSource(ofxNDI::Source & source);
@@ -269,6 +308,43 @@ class ofApp : public ofBaseApp {
     bool debugShow;
     bool enableShader;
 
+    // When set (ADAPTIVE_QUALITY, off by default), the current form's QualityGovernor is fed the cost of every frame:
+    // the update+draw work time, the GPU timer total and late frame intervals.
+    bool adaptiveQuality;
+    // Every form's quality level stays within these, from QUALITY_MIN_LEVEL and QUALITY_MAX_LEVEL
+    float qualityMinLevel;
+    float qualityMaxLevel;
+    double frameWorkStartS;
+
+    // GPU timer queries around every render pass. Always on while the debug overlay shows or quality is adaptive.
+    bool gpuTimers;
+
+    // FrameProfiler CPU zones are on from startup with PROFILER and toggled with p. P writes a trace to
+    // PROFILER_TRACE, or a timestamped file in the data folder when unset.
+    std::string profilerTracePath;
+
+    // Every frame published to a shared-memory ring for local consumers, when SHARED_FRAME_OUTPUT names one
+    bool sharedFrameOutput;
+    PixelReadback frameReadback;
+    SharedFrameWriter sharedFrames;
+
+    /*
+     * Offline rendering: a recorded input log to video on a fixed timestep, when OFFLINE_RENDER_OUTPUT is set
+     */
+    bool offlineRender;
+    int offlineFps;
+    InputLog offlineInput;
+    PixelReadback offlineReadback;
+    FrameSequenceWriter offlineWriter;
+    uint64_t offlineFramesTotal;
+    uint64_t offlineFramesRendered;
+    uint64_t offlineFramesWritten;
+    std::chrono::steady_clock::time_point offlineStart;  // Wall clock, as OF's clock runs on the fixed step
+    void offlineRenderSetup();
+    void offlineRenderTimingHandler();
+    void offlineRenderUpdateHandler();
+    void offlineRenderDrawHandler();
+
     ofxPanel gui;
 
     ofParameterGroup metaParameterGroup;
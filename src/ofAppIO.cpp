@@ -95,13 +95,25 @@ std::string ofApp::dumpSettingsToJsonFile() {
     return settingsName;
 }
 
+std::string ofApp::dumpProfileToTraceFile() {
+    std::string path =
+        profilerTracePath.empty() ? ofToDataPath("trace_" + ofGetTimestampString() + ".json") : profilerTracePath;
+    if (!FrameProfiler::writeChromeTrace(path)) {
+        return "";
+    }
+    ofLogNotice("FrameProfiler") << FrameProfiler::getSummary();
+    return path;
+}
+
 void ofApp::loadSettingsFromJsonString(const std::string & payloadString) {
+    journalRecord.recordSettings(payloadString);
     json j = json::parse(payloadString);
     ofLogNotice() << "Loading JSON settings.";
     gui.loadFrom(j);
 }
 
 void ofApp::jsonHandlerEphemeralNote(nlohmann::basic_json<> & j, unsigned int messageId) {
+    journalRecord.recordEphemeral(j, messageId);
     std::unordered_map<int, float> incomingPresses;
     std::unordered_map<int, unsigned int> messageIds;
     if (incomingPresses.size()) {
@@ -118,6 +130,7 @@ void ofApp::jsonHandlerEphemeralNote(nlohmann::basic_json<> & j, unsigned int me
 }
 
 void ofApp::jsonHandlerClassification(nlohmann::basic_json<> & j) {
+    journalRecord.recordJson(InputJournalKind::CLASSIFICATION, j);
     // {"type": "arousal", "value": 0.5, "time": "2022-05-25T21:15:21.729171+00:00"}
 
     float messageValue = NAN;
@@ -135,6 +148,7 @@ void ofApp::jsonHandlerClassification(nlohmann::basic_json<> & j) {
 }
 
 void ofApp::jsonHandlerMidiMessage(nlohmann::basic_json<> & j) {
+    journalRecord.recordMidi(j);
     int messageNote = 0;
     int messageVelocity = 0;
     int messageChannel = 0;
@@ -264,6 +278,7 @@ void ofApp::jsonHandlerMidiMessage(nlohmann::basic_json<> & j) {
 }
 
 void ofApp::jsonHandlerParamMessage(nlohmann::basic_json<> & j) {
+    journalRecord.recordJson(InputJournalKind::PARAM, j);
     float messageValue = NAN;
     std::vector<std::vector<int>> colorRgbsRaw;
     std::vector<ofColor> colors;
@@ -293,6 +308,7 @@ void ofApp::jsonHandlerParamMessage(nlohmann::basic_json<> & j) {
 }
 
 void ofApp::jsonHandlerOfParamMessage(nlohmann::basic_json<> & j) {
+    journalRecord.recordJson(InputJournalKind::OFPARAM, j);
     ofLogNotice("IO") << "Received message: " << j;
     //    ofxBaseGui * colorGroup = gui.getControl("Color");
     //    if (!colorGroup) {
@@ -0,0 +1,128 @@
+//
+//  ofAppInputJournal.cpp
+//  orgb
+//
+//  Records decoded input to a binary InputJournal and replays it. INPUT_JOURNAL_RECORD names a journal to record
+//  to; INPUT_JOURNAL_REPLAY names one to replay, at INPUT_JOURNAL_REPLAY_SPEED times real time. A text log such as
+//  pedal.txt given to INPUT_JOURNAL_REPLAY is imported to <log>.journal first. Live input keeps working during a
+//  replay, but is not recorded.
+//
+
+#include "ofApp.h"
+
+using json = nlohmann::json;
+
+void ofApp::inputJournalSetup() {
+    std::string replayPath = getEnv("INPUT_JOURNAL_REPLAY", "");
+    if (!replayPath.empty()) {
+        if (!InputJournalReader::isJournal(replayPath)) {
+            std::string imported = replayPath + ".journal";
+            if (!importInputLog(replayPath, imported)) {
+                throw std::runtime_error("Couldn't import INPUT_JOURNAL_REPLAY.");
+            }
+            replayPath = imported;
+        }
+        if (!journalReplay.open(replayPath)) {
+            throw std::runtime_error("Couldn't open INPUT_JOURNAL_REPLAY.");
+        }
+        journalReplaySpeed = stod(getEnv("INPUT_JOURNAL_REPLAY_SPEED", "1.0"));
+    }
+
+    std::string recordPath = getEnv("INPUT_JOURNAL_RECORD", "");
+    if (!recordPath.empty()) {
+        if (journalReplay.isOpen()) {
+            ofLogWarning("InputJournal") << "Not recording while replaying";
+        } else if (!journalRecord.open(recordPath)) {
+            throw std::runtime_error("Couldn't open INPUT_JOURNAL_RECORD.");
+        }
+    }
+}
+
+bool ofApp::importInputLog(const std::string & textPath, const std::string & journalPath) {
+    InputLog log;
+    if (!log.loadText(textPath)) {
+        return false;
+    }
+    InputJournalWriter writer;
+    if (!writer.open(journalPath)) {
+        return false;
+    }
+    size_t skipped = 0;
+    for (const auto & event : log.getEvents()) {
+        auto timeUs = static_cast<int64_t>(event.timeS * 1e6 + 0.5);
+        try {
+            if (event.topic == "midi" || event.topic == "midi-piano") {
+                writer.recordMidi(json::parse(event.payload), timeUs);
+            } else if (event.topic == CLASSIFIER_MQTT_TOPIC) {
+                writer.recordJson(InputJournalKind::CLASSIFICATION, json::parse(event.payload), timeUs);
+            } else if (event.topic == ORGB_PARAM_MQTT_TOPIC) {
+                writer.recordJson(InputJournalKind::PARAM, json::parse(event.payload), timeUs);
+            } else if (event.topic == ORGB_OFPARAMETER_MQTT_TOPIC) {
+                writer.recordJson(InputJournalKind::OFPARAM, json::parse(event.payload), timeUs);
+            } else if (event.topic == SETTINGS_MQTT_TOPIC) {
+                writer.recordSettings(event.payload, timeUs);
+            } else {
+                skipped++;
+            }
+        } catch (nlohmann::detail::parse_error & e) {
+            skipped++;
+        }
+    }
+    ofLogNotice("InputJournal") << "Imported " << writer.getRecordCount() << " events from " << textPath << " to "
+                                << journalPath << (skipped > 0 ? ", skipped " + ofToString(skipped) : "");
+    return true;
+}
+
+void ofApp::inputJournalUpdateHandler() {
+    PROFILE_ZONE("Input Journal");
+    journalRecord.flush();
+    if (!journalReplay.isOpen() || offlineRender) {
+        return;  // Offline rendering replays on its own clock
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (journalReplayStart == std::chrono::steady_clock::time_point()) {
+        journalReplayStart = now;
+    }
+    double replayS = std::chrono::duration<double>(now - journalReplayStart).count() * journalReplaySpeed;
+    journalReplay.dispatchUntil(static_cast<uint64_t>(replayS * 1e6),
+                                [this](const InputJournalEvent & event) { replayJournalEvent(event); });
+    if (journalReplay.isFinished()) {
+        ofLogNotice("InputJournal") << "Replay finished";
+        journalReplay.close();
+    }
+}
+
+void ofApp::replayJournalEvent(const InputJournalEvent & event) {
+    try {
+        if (event.kind == InputJournalKind::SETTINGS) {
+            loadSettingsFromJsonString(event.text());
+            return;
+        }
+        json j = event.json();
+        switch (event.kind) {
+            case InputJournalKind::NOTE_ON:
+            case InputJournalKind::NOTE_OFF:
+            case InputJournalKind::CONTROL_CHANGE:
+            case InputJournalKind::MIDI:
+                jsonHandlerMidiMessage(j);
+                break;
+            case InputJournalKind::EPHEMERAL:
+                jsonHandlerEphemeralNote(j, event.messageId());
+                break;
+            case InputJournalKind::CLASSIFICATION:
+                jsonHandlerClassification(j);
+                break;
+            case InputJournalKind::PARAM:
+                jsonHandlerParamMessage(j);
+                break;
+            case InputJournalKind::OFPARAM:
+                jsonHandlerOfParamMessage(j);
+                break;
+            default:
+                ofLogWarning("InputJournal") << "Skipping unknown event kind " << static_cast<int>(event.kind);
+                break;
+        }
+    } catch (nlohmann::detail::exception & e) {
+        ofLogWarning("InputJournal") << "Skipping unreadable event: " << e.what();
+    }
+}
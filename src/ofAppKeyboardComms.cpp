@@ -40,6 +40,13 @@ void ofApp::keyPressed(int key) {
         case 'q':
             ofSetWindowShape(160, 32);
             break;
+        case 'p':
+            FrameProfiler::setEnabled(!FrameProfiler::isEnabled());
+            ofLogNotice("FrameProfiler") << (FrameProfiler::isEnabled() ? "Profiling" : "Not profiling");
+            break;
+        case 'P':
+            dumpProfileToTraceFile();
+            break;
     }
 }
 
@@ -8,7 +8,7 @@
 #include "ofApp.h"
 
 int ofApp::initializeLEDMatrices() {
-    // Return the number of clockwise rotations
+    // Return the number of clockwise rotations left for PanelResolve to apply
 #ifdef TARGET_RASPBERRY_PI
     std::string hardwareMapping = getEnv("HARDWARE_MAPPING");
     int columns = stoi(getEnv("LED_COLUMNS"));
@@ -22,6 +22,29 @@ int ofApp::initializeLEDMatrices() {
     int gpioSlowdown = stoi(getEnv("GPIO_SLOWDOWN"));
     std::string pixelMapperConfig = getEnv("PIXEL_MAPPER_CONFIG");
     std::string ledRgbSequence = getEnv("LED_RGB_SEQUENCE");
+
+    int rotations = 0;
+    if (pixelMapperConfig.find("Rotate:90") != std::string::npos) {
+        rotations = 1;
+    } else if (pixelMapperConfig.find("Rotate:180") != std::string::npos) {
+        rotations = 2;
+    } else if (pixelMapperConfig.find("Rotate:270") != std::string::npos) {
+        rotations = 3;
+    }
+    // A Rotate mapper on its own is done by PanelResolve while it scales the frame, instead of per pixel in the
+    // driver. Combined with other mappers it stays in the driver, which then expects the window-sized frame.
+    bool rotateOnGpu = pixelMapperConfig.rfind("Rotate:", 0) == 0 && pixelMapperConfig.find(';') == std::string::npos;
+    matrixIsWindow = !rotateOnGpu && !pixelMapperConfig.empty();
+    if (!matrixIsWindow) {
+        pixelMapperConfig = "";
+        matrixWidth = columns * chain;
+        matrixHeight = rows * parallel;
+    } else {
+        rotations = 0;
+        matrixWidth = ofGetWidth();
+        matrixHeight = ofGetHeight();
+    }
+
     // Rotate 270 , chain 5, 32x32 -> 32x160
     // chain 5, 32x32 -> 160x32
     ofLogNotice("LED") << "Initializing Panel with mapping: " << hardwareMapping << " ledColumns:" << columns
@@ -34,20 +57,8 @@ int ofApp::initializeLEDMatrices() {
               ledRgbSequence);
 
     ofLogNotice("LED") << "led.setup() successful.";
-
-    if (pixelMapperConfig.find("Rotate:90") != std::string::npos) {
-        ofLogNotice() << "Right rotations: 1";
-        return 1;
-    } else if (pixelMapperConfig.find("Rotate:180") != std::string::npos) {
-        ofLogNotice() << "Right rotations: 2";
-        return 2;
-    } else if (pixelMapperConfig.find("Rotate:270") != std::string::npos) {
-        ofLogNotice() << "Right rotations: 3";
-        return 3;
-    } else {
-        ofLogNotice() << "Right rotations: 0";
-        return 0;
-    }
+    ofLogNotice() << "Right rotations: " << rotations << (rotateOnGpu ? " (on the GPU)" : "");
+    return rotations;
 #else
     ofLogNotice() << "LED Disabled. Right rotations: 0";
     return 0;
@@ -60,14 +71,20 @@ void ofApp::brightnessUpdateHandler() {
         static_cast<uint8_t>(ofMap(ledBrightnessPct, 0, 1, 0, 100));  // LED API expects uint8_t [0,100]
     uint8_t idleLedBrightness =
         static_cast<uint8_t>(ofMap(idleLedBrightnessPct, 0, 1, 0, 100));  // LED API expects uint8_t [0,100]
-    if (applicationIsIdle()) {
-        if (led.getBrightness() != idleLedBrightness) {
-            led.setBrightness(idleLedBrightness);
-        }
-    } else {
-        if (led.getBrightness() != ledBrightness) {
-            led.setBrightness(ledBrightness);
-        }
+    // Applied by the output thread, which owns the driver
+    ledTargetBrightness = applicationIsIdle() ? idleLedBrightness : ledBrightness;
+#endif
+}
+
+void ofApp::sendToLEDs(ofPixels & pixels) {
+#ifdef TARGET_RASPBERRY_PI
+    uint8_t brightness = ledTargetBrightness;
+    if (led.getBrightness() != brightness) {
+        led.setBrightness(brightness);
     }
+    // The driver reads RGB, and the image's size only follows its pixels after update()
+    LedOutput::toRgb(pixels, image.getPixels());
+    image.update();
+    led.draw(image);
 #endif
 }
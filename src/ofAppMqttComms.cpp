@@ -113,6 +113,7 @@ void ofApp::processQueuedMQTTMessages() {
     if (!mqttClientConnectedSuccessfully) {
         return;
     }
+    PROFILE_ZONE("Input MQTT");
 
     int processedCount = 0;
     const int maxMessagesPerFrame = 100;  // Limit processing per frame
@@ -9,8 +9,14 @@
 
 #include <math.h>
 
+#include <chrono>
+#include <thread>
+
 #include "ofApp.h"
 
+// Sleep between polls of the receiver in the NDI thread
+#define NDI_POLL_INTERVAL_MS 2
+
 // Return true iff scan finds video and connection succeeds.
 bool ofApp::ndiScanForVideoSources() {
     auto sources = finder_.getSources();
@@ -81,8 +87,51 @@ bool ofApp::ndiSwitchToVideoSource(ofxNDI::Source & source) {
     }
 }
 
-// Return true iff connected.
-bool ofApp::ndiUpdateHandler() {
+// ====================
+// Threading Functions
+// ====================
+
+void ofApp::startNDIThread() {
+    if (ndiThreadRunning) {
+        ofLogWarning("NDI") << "NDI thread already running";
+        return;
+    }
+
+    ndiThreadRunning = true;
+    ndiThread = std::thread(&ofApp::ndiThreadFunction, this);
+    ofLogNotice("NDI") << "NDI thread started";
+}
+
+void ofApp::stopNDIThread() {
+    if (!ndiThreadRunning) {
+        return;
+    }
+
+    ofLogNotice("NDI") << "Stopping NDI thread...";
+    ndiThreadRunning = false;
+
+    if (ndiThread.joinable()) {
+        ndiThread.join();
+    }
+
+    ofLogNotice("NDI") << "NDI thread stopped";
+}
+
+void ofApp::ndiThreadFunction() {
+    ofLogNotice("NDI") << "NDI background thread running";
+
+    while (ndiThreadRunning) {
+        ndiConnected = ndiReceiveHandler();
+
+        // Polls well above any stream's frame rate without busy-waiting
+        std::this_thread::sleep_for(std::chrono::milliseconds(NDI_POLL_INTERVAL_MS));
+    }
+
+    ofLogNotice("NDI") << "NDI background thread exiting";
+}
+
+// Runs in the NDI thread. Return true iff connected.
+bool ofApp::ndiReceiveHandler() {
     /*
      TODO HUH
      auto sources = finder_.getSources();
@@ -97,21 +146,19 @@ bool ofApp::ndiUpdateHandler() {
         video_.update();
         if (video_.isFrameNew()) {
             ofLogVerbose("NDI") << "NDI Receiver received new frame, decoding to pixels...";
-            video_.decodeTo(pixels_);
+            video_.decodeTo(ndiFrames.writeBuffer());
+            ndiFrames.publish();
         }
         return true;
     } else {
         // Receiver is not connected or set up
-        if (pixels_.isAllocated()) {
-            ofLogVerbose("NDI") << "NDI Receiver disconnected but pixels is allocated. Clearing...";
-            pixels_.clear();
-        }
         double scheduledAttemptDue = (lastNdiReconnectAttempt.has_value() ? lastNdiReconnectAttempt.value() : 0) +
                                      stoi(getEnv("NDI_SCAN_INTERVAL_SECONDS", "10"));
         if (scheduledAttemptDue < getSystemTimeSecondsPrecise()) {
             ofLogVerbose("NDI")
                 << "Receiver is not connected and interval elapsed. Attempting to select video source...";
             double t0 = getSystemTimeSecondsPrecise();
+            lastNdiReconnectAttempt = t0;
             ndiScanForVideoSources();
             warnOnSlow("NDI Scan for Video", t0, WARN_INTERVAL_DENOMINATOR_NDI_SCAN, ofGetFrameNum(),
                        ofGetElapsedTimef());
@@ -121,15 +168,30 @@ bool ofApp::ndiUpdateHandler() {
     }
 }
 
+// Runs in the main thread; never waits on the network. Return true iff connected.
+bool ofApp::ndiUpdateHandler() {
+    if (!ndiConnected) {
+        if (ndiTexture.isAllocated()) {
+            ofLogVerbose("NDI") << "NDI Receiver disconnected but texture is allocated. Clearing...";
+            ndiTexture.clear();
+        }
+        return false;
+    }
+    if (ndiFrames.acquire()) {
+        ndiTexture.update(ndiFrames.readBuffer());
+    }
+    return true;
+}
+
 // Return true iff allocated. Will only be allocated with active stream.
 bool ofApp::ndiDrawHandler() {
-    if (pixels_.isAllocated()) {
-        ofLogVerbose("NDI") << "Pixels is allocated, drawing pixels.";
-        float xCropWidth = (pixels_.getWidth() - ofGetWidth()) / 2.0;
-        float yCropWidth = (pixels_.getHeight() - ofGetHeight()) / 2.0;
-        ofImage(pixels_).drawSubsection(0.0f, 0.0f, ofGetWidth(), ofGetHeight(), xCropWidth, yCropWidth);
-
-        // ofImage(pixels_).draw(0,0);
+    if (ndiTexture.isAllocated()) {
+        ofLogVerbose("NDI") << "Texture is allocated, drawing texture.";
+        ofTexture & texture = ndiTexture.getTexture();
+        float xCropWidth = (texture.getWidth() - ofGetWidth()) / 2.0;
+        float yCropWidth = (texture.getHeight() - ofGetHeight()) / 2.0;
+        // The crop is in the texture coordinates; nothing is copied
+        texture.drawSubsection(0.0f, 0.0f, ofGetWidth(), ofGetHeight(), xCropWidth, yCropWidth);
         return true;
     } else {
         return false;
@@ -65,6 +65,7 @@ void ofApp::oscThreadFunction() {
 
 void ofApp::processQueuedOSCMessages() {
     double t0 = getSystemTimeSecondsPrecise();
+    PROFILE_ZONE("Input OSC");
 
     int processedCount = 0;
     const int maxMessagesPerFrame = 100;  // Limit processing per frame
@@ -99,6 +100,10 @@ void ofApp::processQueuedOSCMessages() {
                         j["channel"] = m.getArgAsInt(1);
                         j["note"] = m.getArgAsInt(2);
                         j["velocity"] = m.getArgAsInt(3);
+                        // The note on handler needs an id. Senders may append one; otherwise make one as the
+                        // keyboard does.
+                        j["id"] = m.getNumArgs() > 4 ? static_cast<unsigned int>(m.getArgAsInt(4))
+                                                     : static_cast<unsigned int>(ofGetSystemTimeMicros() % UINT_MAX);
                         break;
                     case MIDITYPE::CONTROL_CHANGE:
                         j["channel"] = m.getArgAsInt(1);
@@ -221,6 +226,10 @@ void ofApp::pollForOSCMessages() {
                         j["channel"] = m.getArgAsInt(1);
                         j["note"] = m.getArgAsInt(2);
                         j["velocity"] = m.getArgAsInt(3);
+                        // The note on handler needs an id. Senders may append one; otherwise make one as the
+                        // keyboard does.
+                        j["id"] = m.getNumArgs() > 4 ? static_cast<unsigned int>(m.getArgAsInt(4))
+                                                     : static_cast<unsigned int>(ofGetSystemTimeMicros() % UINT_MAX);
                         break;
                     case MIDITYPE::CONTROL_CHANGE:
                         j["channel"] = m.getArgAsInt(1);
@@ -0,0 +1,118 @@
+//
+//  ofAppOfflineRender.cpp
+//  orgb
+//
+//  Renders a recorded input log to video as fast as the GPU allows. With OFFLINE_RENDER_OUTPUT set, the app runs
+//  on a fixed timestep of OFFLINE_RENDER_FPS: OF's clock (and so every form, KeyState and envelope) advances by
+//  exactly one frame per frame, vsync and the frame rate cap are off, and the events of OFFLINE_RENDER_INPUT are
+//  replayed at their recorded times. The input is a text log (see InputLog.hpp) or an InputJournal. Live inputs
+//  (MQTT, OSC, NDI) and adaptive quality stay off, so the same log renders the same frames every run. Frames go
+//  through the usual forms and ShaderPipeline, are read back asynchronously and are encoded by a
+//  FrameSequenceWriter thread. main() keeps the window hidden on desktop, and moves logging to stderr when the
+//  output is "-" (stdout).
+//
+//    OFFLINE_RENDER_OUTPUT=out.y4m OFFLINE_RENDER_INPUT=pedal.txt bin/orgb
+//    OFFLINE_RENDER_OUTPUT=- OFFLINE_RENDER_INPUT=pedal.txt bin/orgb | ffmpeg -i - out.mp4
+//
+
+#include <chrono>
+
+#include "ofApp.h"
+
+using json = nlohmann::json;
+
+#define OFFLINE_RENDER_DEFAULT_FPS 60
+#define OFFLINE_RENDER_TAIL_S 5.0        // Rendered after the last event, so releases can fade out
+#define OFFLINE_RENDER_EMPTY_LOG_S 10.0  // Rendered when there are no events
+#define OFFLINE_RENDER_PROGRESS_INTERVAL_S 10
+
+void ofApp::offlineRenderSetup() {
+    offlineRender = !getEnv("OFFLINE_RENDER_OUTPUT", "").empty();
+    if (!offlineRender) {
+        return;
+    }
+    offlineFps = stoi(getEnv("OFFLINE_RENDER_FPS", ofToString(OFFLINE_RENDER_DEFAULT_FPS)));
+    std::string input = getEnv("OFFLINE_RENDER_INPUT", "");
+    double inputS = -1;  // None
+    if (InputJournalReader::isJournal(input)) {
+        if (!journalReplay.open(input)) {
+            throw std::runtime_error("Couldn't read OFFLINE_RENDER_INPUT.");
+        }
+        inputS = journalReplay.getDurationUs() / 1e6;
+    } else if (!input.empty()) {
+        if (!offlineInput.loadText(input)) {
+            throw std::runtime_error("Couldn't read OFFLINE_RENDER_INPUT.");
+        }
+        inputS = offlineInput.getEvents().empty() ? -1 : offlineInput.getDurationS();
+    }
+
+    double seconds = inputS < 0 ? OFFLINE_RENDER_EMPTY_LOG_S : inputS + OFFLINE_RENDER_TAIL_S;
+    seconds = stod(getEnv("OFFLINE_RENDER_SECONDS", ofToString(seconds)));
+    offlineFramesTotal = static_cast<uint64_t>(ceil(seconds * offlineFps));
+    offlineFramesRendered = 0;
+    offlineFramesWritten = 0;
+
+    if (!offlineWriter.open(getEnv("OFFLINE_RENDER_OUTPUT"), offlineFps)) {
+        throw std::runtime_error("Couldn't open OFFLINE_RENDER_OUTPUT.");
+    }
+    ofLogNotice("OfflineRender") << "Rendering " << offlineFramesTotal << " frames (" << seconds << " s) at "
+                                 << offlineFps << " fps";
+
+    // Nothing from outside the log may reach the frames, and nothing may depend on how fast they render
+    enableNDI = false;
+#ifdef HAS_MQTT
+    enableMQTT = false;
+#endif
+    adaptiveQuality = false;
+}
+
+void ofApp::offlineRenderTimingHandler() {
+    ofSetVerticalSync(false);
+    ofSetFrameRate(0);  // Unlimited
+    ofSetTimeModeFixedRate(ofGetFixedStepForFps(offlineFps));
+}
+
+void ofApp::offlineRenderUpdateHandler() {
+    if (offlineFramesRendered == 0) {
+        offlineStart = std::chrono::steady_clock::now();
+    }
+    double frameTimeS = static_cast<double>(offlineFramesRendered) / offlineFps;
+    offlineInput.dispatchUntil(frameTimeS, [this](const InputEvent & event) {
+#if defined(HAS_MQTT) && !defined(__EMSCRIPTEN__)
+        processMQTTMessage({event.topic, event.payload});
+#else
+        if (event.topic == "midi" || event.topic == "midi-piano") {
+            auto j = json::parse(event.payload);
+            jsonHandlerMidiMessage(j);
+        }
+#endif
+    });
+    journalReplay.dispatchUntil(static_cast<uint64_t>(frameTimeS * 1e6 + 0.5),
+                                [this](const InputJournalEvent & event) { replayJournalEvent(event); });
+}
+
+void ofApp::offlineRenderDrawHandler() {
+    offlineFramesRendered++;
+    // The readback trails by its latency, so rendering runs that many frames past the end to collect the last ones
+    offlineReadback.request(0, 0, ofGetWidth(), ofGetHeight());
+    ofPixels * pixels = offlineReadback.latest();
+    if (pixels == nullptr || offlineFramesWritten >= offlineFramesTotal) {
+        return;
+    }
+    offlineWriter.write(*pixels);
+    offlineFramesWritten++;
+
+    double elapsedS = std::chrono::duration<double>(std::chrono::steady_clock::now() - offlineStart).count();
+    if (offlineFramesWritten % (offlineFps * OFFLINE_RENDER_PROGRESS_INTERVAL_S) == 0) {
+        ofLogNotice("OfflineRender") << offlineFramesWritten << "/" << offlineFramesTotal << " frames, "
+                                     << offlineFramesWritten / elapsedS << " fps";
+    }
+    if (offlineFramesWritten == offlineFramesTotal) {
+        offlineWriter.close();
+        elapsedS = std::chrono::duration<double>(std::chrono::steady_clock::now() - offlineStart).count();
+        double fps = offlineFramesTotal / elapsedS;
+        ofLogNotice("OfflineRender") << "Rendered " << offlineFramesTotal << " frames in " << elapsedS << " s: " << fps
+                                     << " fps, " << fps / offlineFps << "x realtime";
+        ofExit(0);
+    }
+}
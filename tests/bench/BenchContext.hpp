@@ -0,0 +1,24 @@
+#pragma once
+
+#include "KeyState.hpp"
+#include "ofMain.h"
+
+/**
+ * Shared setup for the benchmarks.
+ *
+ * Forms read the window size when they are built and some allocate textures, so benchmarks run with a GL
+ * context, as the integration tests do. On Linux without a display that is a HeadlessWindow on EGL (Mesa's
+ * llvmpipe on a machine without a GPU); otherwise, or with BENCH_CONTEXT=glfw, it is a hidden GLFW window. The
+ * window is 160x32, the app's default, unless BENCH_WIDTH and BENCH_HEIGHT say otherwise. Shaders load from the
+ * repo's bin/data.
+ */
+namespace bench {
+
+// Create the window. Call once, before running any benchmark.
+void setupWindow();
+
+// Hold `polyphony` notes, spread over the keyboard from A0. Every releaseEvery-th note is then released, so
+// release and cleanup paths see work too (0 = hold them all).
+void pressKeys(KeyState & ks, int polyphony, int releaseEvery = 0);
+
+}  // namespace bench
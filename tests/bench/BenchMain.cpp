@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+#include "BenchContext.hpp"
+#include "HeadlessWindow.hpp"
+#include "Utilities.hpp"
+#include "ofAppGLFWWindow.h"
+
+#define BENCH_FIRST_NOTE 21  // A0
+#define BENCH_NOTE_COUNT 100
+#define BENCH_MAX_WIDTH 1920
+#define BENCH_MAX_HEIGHT 1080
+
+namespace bench {
+
+void setupWindow() {
+    int width = stoi(getEnv("BENCH_WIDTH", "160"));
+    int height = stoi(getEnv("BENCH_HEIGHT", "32"));
+    // Render benchmarks go up to 1080p, and a pbuffer cannot grow, so the context starts at least that big
+    int contextWidth = std::max(width, BENCH_MAX_WIDTH);
+    int contextHeight = std::max(height, BENCH_MAX_HEIGHT);
+    ofSetLogLevel(OF_LOG_WARNING);
+    ofSetDataPathRoot(ORGB_DATA_DIR);
+
+#ifdef TARGET_LINUX
+    // EGL needs no display; GLFW needs one, if only Xvfb
+    std::string context = getEnv("BENCH_CONTEXT", getenv("DISPLAY") ? "glfw" : "egl");
+    if (context == "egl") {
+        HeadlessWindow::create(contextWidth, contextHeight);
+        ofSetWindowShape(width, height);
+        return;
+    }
+#endif
+
+    ofGLFWWindowSettings settings;
+    settings.setSize(contextWidth, contextHeight);
+    settings.windowMode = OF_WINDOW;
+#ifdef TARGET_LINUX
+    settings.visible = false;
+#endif
+    auto window = std::make_shared<ofAppGLFWWindow>();
+    window->setup(settings);
+    ofSetupOpenGL(window, contextWidth, contextHeight, OF_WINDOW);
+    ofSetWindowShape(width, height);
+}
+
+void pressKeys(KeyState & ks, int polyphony, int releaseEvery) {
+    for (int i = 0; i < polyphony; i++) {
+        int key = BENCH_FIRST_NOTE + i % BENCH_NOTE_COUNT;
+        ks.newKeyPressedHandler(key, ofMap(i % 7, 0, 6, 0.4, 1.0), i + 1);
+    }
+    if (releaseEvery > 0) {
+        for (int i = 0; i < polyphony; i += releaseEvery) {
+            ks.keyReleasedHandler(BENCH_FIRST_NOTE + i % BENCH_NOTE_COUNT);
+        }
+    }
+}
+
+}  // namespace bench
+
+// BENCHMARK_MAIN, with the window created first
+int main(int argc, char ** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    bench::setupWindow();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "HeadlessWindow.hpp"
+
+#ifdef TARGET_LINUX
+
+// Mesa's eglplatform.h pulls in Xlib otherwise, whose None and Status macros clash with OF
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <stdexcept>
+
+static EGLDisplay openDisplay() {
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+    auto getPlatformDisplay =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        EGLDisplay surfaceless = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (surfaceless != EGL_NO_DISPLAY) {
+            return surfaceless;
+        }
+    }
+#endif
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+HeadlessWindow::~HeadlessWindow() {
+    currentRenderer.reset();
+    if (display) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context) {
+            eglDestroyContext(display, context);
+        }
+        if (surface) {
+            eglDestroySurface(display, surface);
+        }
+        eglTerminate(display);
+    }
+}
+
+void HeadlessWindow::setup(const ofGLWindowSettings & settings) {
+    width = surfaceWidth = settings.getWidth();
+    height = surfaceHeight = settings.getHeight();
+
+    display = openDisplay();
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        throw std::runtime_error("No EGL display.");
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        throw std::runtime_error("EGL has no desktop OpenGL.");
+    }
+
+    const EGLint configAttributes[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                                       EGL_RED_SIZE,     8,               EGL_GREEN_SIZE,      8,
+                                       EGL_BLUE_SIZE,    8,               EGL_ALPHA_SIZE,      8,
+                                       EGL_DEPTH_SIZE,   24,              EGL_STENCIL_SIZE,    8,
+                                       EGL_NONE};
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        throw std::runtime_error("No EGL pbuffer config.");
+    }
+
+    const EGLint surfaceAttributes[] = {EGL_WIDTH, surfaceWidth, EGL_HEIGHT, surfaceHeight, EGL_NONE};
+    surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    if (surface == EGL_NO_SURFACE) {
+        throw std::runtime_error("Couldn't create EGL pbuffer.");
+    }
+
+    // Without a version EGL gives a compatibility context, which is what OF's GL 2 renderer needs
+    const EGLint coreAttributes[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                     settings.glVersionMajor,
+                                     EGL_CONTEXT_MINOR_VERSION,
+                                     settings.glVersionMinor,
+                                     EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                     EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                     EGL_NONE};
+    const EGLint compatibilityAttributes[] = {EGL_NONE};
+    bool programmable = settings.glVersionMajor >= 3;
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT,
+                               programmable ? coreAttributes : compatibilityAttributes);
+    if (context == EGL_NO_CONTEXT) {
+        throw std::runtime_error("Couldn't create EGL context.");
+    }
+    makeCurrent();
+
+    glewExperimental = GL_TRUE;
+    GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW built for GLX loads the GL entry points, then fails looking for a GLX display that EGL never made
+    if (err == GLEW_ERROR_NO_GLX_DISPLAY) {
+        err = GLEW_OK;
+    }
+#endif
+    if (err != GLEW_OK) {
+        throw std::runtime_error("glewInit failed: " +
+                                 std::string(reinterpret_cast<const char *>(glewGetErrorString(err))));
+    }
+    ofLogNotice("HeadlessWindow") << "EGL " << major << "." << minor << ", "
+                                  << reinterpret_cast<const char *>(glGetString(GL_RENDERER)) << ", GL "
+                                  << reinterpret_cast<const char *>(glGetString(GL_VERSION));
+
+    if (programmable) {
+        currentRenderer = std::make_shared<ofGLProgrammableRenderer>(this);
+        static_cast<ofGLProgrammableRenderer *>(currentRenderer.get())
+            ->setup(settings.glVersionMajor, settings.glVersionMinor);
+    } else {
+        currentRenderer = std::make_shared<ofGLRenderer>(this);
+        static_cast<ofGLRenderer *>(currentRenderer.get())->setup();
+    }
+}
+
+void HeadlessWindow::setWindowShape(int w, int h) {
+    if (w > surfaceWidth || h > surfaceHeight) {
+        ofLogWarning("HeadlessWindow") << w << "x" << h << " is larger than the " << surfaceWidth << "x"
+                                       << surfaceHeight << " pbuffer; drawing to the screen will be clipped";
+    }
+    width = w;
+    height = h;
+    coreEvents.notifyWindowResized(w, h);
+}
+
+void HeadlessWindow::makeCurrent() {
+    if (!eglMakeCurrent(display, surface, surface, context)) {
+        ofLogError("HeadlessWindow") << "eglMakeCurrent failed: " << std::hex << eglGetError();
+    }
+}
+
+std::shared_ptr<HeadlessWindow> HeadlessWindow::create(int width, int height, int glVersionMajor,
+                                                       int glVersionMinor) {
+    ofInit();
+    auto window = std::make_shared<HeadlessWindow>();
+    ofGetMainLoop()->addWindow(window);
+    ofGLWindowSettings settings;
+    settings.setSize(width, height);
+    settings.setGLVersion(glVersionMajor, glVersionMinor);
+    window->setup(settings);
+    return window;
+}
+
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+
+#include "ofMain.h"
+
+/**
+ * An offscreen OpenGL window for machines without a display or GPU.
+ *
+ * Renders into an EGL pbuffer, preferring Mesa's surfaceless platform so no X server is needed; on a GPU-less
+ * Linux box that is llvmpipe. The app only ever sees a window: ofGetWidth() and ofGetHeight() report the size
+ * given to setup() or setWindowShape(), and the renderer is OF's own.
+ *
+ * The pbuffer keeps the size it was set up with. Later shapes only change what the app sees, so set it up at the
+ * largest size that will be used.
+ *
+ * Linux only. Forms render into their own FBOs, so nothing needs the default framebuffer to be visible.
+ */
+#ifdef TARGET_LINUX
+
+class HeadlessWindow : public ofAppBaseGLWindow {
+   public:
+    HeadlessWindow() = default;
+    ~HeadlessWindow() override;
+
+    HeadlessWindow(const HeadlessWindow &) = delete;
+    HeadlessWindow & operator=(const HeadlessWindow &) = delete;
+
+    // Creates the context and the renderer. GL 3 and up get a core profile and the programmable renderer, as
+    // with GLFW. Throws if EGL cannot provide a context.
+    using ofAppBaseGLWindow::setup;
+    void setup(const ofGLWindowSettings & settings) override;
+    void update() override {}
+    void draw() override {}
+
+    ofCoreEvents & events() override { return coreEvents; }
+    std::shared_ptr<ofBaseRenderer> & renderer() override { return currentRenderer; }
+
+    void setWindowShape(int w, int h) override;
+    glm::vec2 getWindowSize() override { return {width, height}; }
+    glm::vec2 getScreenSize() override { return {width, height}; }
+    int getWidth() override { return width; }
+    int getHeight() override { return height; }
+
+    void makeCurrent() override;
+    void startRender() override { currentRenderer->startRender(); }
+    void finishRender() override { currentRenderer->finishRender(); }
+
+    // Set up OF with a headless window as the main window, like ofSetupOpenGL() does with GLFW
+    static std::shared_ptr<HeadlessWindow> create(int width, int height, int glVersionMajor = 2,
+                                                  int glVersionMinor = 1);
+
+   private:
+    void * display = nullptr;  // EGLDisplay and friends, kept out of the header so X11 macros stay out too
+    void * surface = nullptr;
+    void * context = nullptr;
+    int width = 0;
+    int height = 0;
+    int surfaceWidth = 0;
+    int surfaceHeight = 0;
+
+    ofCoreEvents coreEvents;
+    std::shared_ptr<ofBaseRenderer> currentRenderer;
+};
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * Benchmarks for the CPU side of form updates
+ *
+ * Covers the work a frame does before anything reaches the GPU: moving particles, steering the flock, generating
+ * lightning bolts and building shape paths. Workloads scale with what the app meets live: polyphony, the particle
+ * cap and flock population.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "BenchContext.hpp"
+#include "ColorProvider.hpp"
+#include "Flock.hpp"
+#include "KeyState.hpp"
+#include "LightningBolt.hpp"
+#include "RandomParticles.hpp"
+#include "Shape.hpp"
+
+// ============================================================================
+// Particles
+// ============================================================================
+
+// Particle emission follows the frame time, which stays near zero without the app's loop. The population is topped
+// up by hand instead, so every update moves and prunes a full pool.
+class BenchParticles : public RandomParticles {
+   public:
+    BenchParticles() : RandomParticles("BenchParticles") {}
+
+    void setParticleCap(float cap) { maxParticles = cap; }
+
+    void fill(KeyState & ks, size_t target) {
+        std::list<Press> presses = ks.activePresses();
+        if (presses.empty()) {
+            return;
+        }
+        target = std::min(target, particles.capacity());
+        int perPress = std::max<int>(1, static_cast<int>(target / presses.size()));
+        for (size_t before = SIZE_MAX; particles.size() < target && particles.size() != before;) {
+            before = particles.size();  // Stop if the pool or palette is full
+            for (auto & press : presses) {
+                int n = std::min<int>(perPress, target - particles.size());
+                createParticlesForPress(press, n, ofColor(255, 255, 255), ks.arousalPct());
+            }
+        }
+    }
+
+    [[nodiscard]] size_t particleCount() const { return particles.size(); }
+};
+
+static void BM_ParticlesUpdate(benchmark::State & state) {
+    KeyState ks;
+    ColorProvider clr;
+    BenchParticles form;
+    bench::pressKeys(ks, state.range(0));
+    form.setParticleCap(state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        form.fill(ks, state.range(1));
+        state.ResumeTiming();
+        form.update(ks, clr);
+    }
+    state.counters["particles"] = form.particleCount();
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_ParticlesUpdate)->ArgNames({"polyphony", "particles"})->ArgsProduct({{1, 10, 100}, {500, 4000, 16000}});
+
+// ============================================================================
+// Flock
+// ============================================================================
+
+static void BM_FlockUpdate(benchmark::State & state) {
+    Flock flock;
+    flock.fastForward = 1.0f;
+    flock.visualRange = 100.0f;
+    flock.minDistance = 20.0f;
+    flock.avoidFactor = 0.05f;
+    flock.alignmentFactor = 0.05f;
+    flock.centeringFactor = 0.0005f;
+    flock.turnFactor = 0.5f;
+    flock.minVelocity = 3.0f;
+    flock.maxVelocity = 6.0f;
+    flock.margin = 100.0f;
+    flock.xMin = 0.0f;
+    flock.xMax = 1920.0f;
+    flock.yMin = 0.0f;
+    flock.yMax = 1080.0f;
+    flock.zMin = -500.0f;
+    flock.zMax = 500.0f;
+    flock.threads = state.range(1);
+
+    ofSeedRandom(7);
+    for (int i = 0; i < state.range(0); i++) {
+        glm::vec3 position(ofRandom(flock.xMax), ofRandom(flock.yMax), ofRandom(flock.zMin, flock.zMax));
+        glm::vec3 velocity(ofRandom(-4, 4), ofRandom(-4, 4), ofRandom(-1, 1));
+        flock.l.emplace_back(position, velocity, ofColor(255, 255, 255), 4);
+    }
+    float elapsedS = 0;
+    for (auto _ : state) {
+        flock.update(1.0f / 60, elapsedS += 1.0f / 60);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlockUpdate)
+    ->ArgNames({"boids", "threads"})
+    ->ArgsProduct({{100, 1000, 5000}, {1, 0}})
+    ->UseRealTime();
+
+// ============================================================================
+// Lightning
+// ============================================================================
+
+// The depth Thunder picks is log2 of the longer side: 7 on the panel, 10 at 1920 wide
+static void BM_LightningBolt(benchmark::State & state) {
+    unsigned int seed = 0;
+    for (auto _ : state) {
+        LightningBolt bolt(ofVec3f(0, 16, 0), ofVec3f(1920, 16, 0), state.range(0), 0.59, 0.105, seed++ % 7759);
+        benchmark::DoNotOptimize(bolt);
+    }
+}
+BENCHMARK(BM_LightningBolt)->ArgName("depth")->Arg(7)->Arg(9)->Arg(11);
+
+// ============================================================================
+// Shapes
+// ============================================================================
+
+static void BM_ShapePath(benchmark::State & state) {
+    Shape form("BenchShape");
+    for (auto _ : state) {
+        ofPath path = form.shape(state.range(0), 64);
+        benchmark::DoNotOptimize(path.getOutline());
+    }
+}
+BENCHMARK(BM_ShapePath)->ArgName("sides")->Arg(3)->Arg(6)->Arg(10);
@@ -0,0 +1,111 @@
+/**
+ * Benchmarks for the KeyState hot paths
+ *
+ * Every form asks for the active presses and their envelopes each frame, and the app cleans up once a frame, so
+ * these run at the polyphony a performance reaches: a melody line, two hands, and a long run under the pedal. The
+ * workload benchmarks play each generated pattern through a frame at a time.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "BenchContext.hpp"
+#include "KeyState.hpp"
+#include "WorkloadGenerator.hpp"
+
+#define KEYSTATE_CLEANUP_TIME 10  // As in ofApp
+
+static void polyphonyArgs(benchmark::internal::Benchmark * b) {
+    b->ArgName("polyphony")->Arg(1)->Arg(10)->Arg(100);
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+static void BM_KeyStateActivePresses(benchmark::State & state) {
+    KeyState ks;
+    bench::pressKeys(ks, state.range(0), 3);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ks.activePresses());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_KeyStateActivePresses)->Apply(polyphonyArgs);
+
+static void BM_KeyStateAudibleAmplitude(benchmark::State & state) {
+    KeyState ks;
+    bench::pressKeys(ks, state.range(0), 3);
+    std::list<Press> presses = ks.activePresses();
+    for (auto _ : state) {
+        double total = 0;
+        for (const auto & press : presses) {
+            total += press.audibleAmplitudePct(ks.attackTimeS, ks.decayTimeS, ks.sustainLevelPct, ks.releaseTimeS);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * presses.size());
+}
+BENCHMARK(BM_KeyStateAudibleAmplitude)->Apply(polyphonyArgs);
+
+// ============================================================================
+// Cleanup
+// ============================================================================
+
+// Cleanup with nothing due to expire: the cost every frame pays
+static void BM_KeyStateCleanup(benchmark::State & state) {
+    KeyState ks;
+    bench::pressKeys(ks, state.range(0), 2);
+    unsigned int frame = 0;
+    for (auto _ : state) {
+        ks.cleanup(KEYSTATE_CLEANUP_TIME, frame++, 1.0 / 60);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_KeyStateCleanup)->Apply(polyphonyArgs);
+
+// Cleanup that removes every released press
+static void BM_KeyStateCleanupExpired(benchmark::State & state) {
+    unsigned int frame = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        KeyState ks;
+        bench::pressKeys(ks, state.range(0), 1);
+        state.ResumeTiming();
+        ks.cleanup(0, frame++, 1.0 / 60);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_KeyStateCleanupExpired)->Apply(polyphonyArgs);
+
+// ============================================================================
+// Workloads
+// ============================================================================
+
+// One frame of a generated performance: the frame's input, then the cleanup and query every frame makes
+static void BM_KeyStateWorkload(benchmark::State & state) {
+    WorkloadSettings settings;
+    settings.pattern = static_cast<WorkloadPattern>(state.range(0));
+    settings.rateHz = 30;
+    settings.polyphony = 8;
+    WorkloadGenerator generator(settings);
+    KeyState ks;
+    std::vector<WorkloadEvent> events;
+    unsigned int frame = 0;
+    size_t processed = 0;
+    for (auto _ : state) {
+        events.clear();
+        generator.generateUntil(++frame / 60.0, events);
+        for (const auto & event : events) {
+            WorkloadGenerator::apply(event, ks);
+        }
+        ks.decayEphemeralKeypressAmplitudes(1.0 / 60);
+        ks.cleanup(KEYSTATE_CLEANUP_TIME, frame, 1.0 / 60);
+        benchmark::DoNotOptimize(ks.activePresses());
+        processed += events.size();
+    }
+    state.SetItemsProcessed(processed);
+    state.SetLabel(WorkloadGenerator::patternName(settings.pattern));
+}
+BENCHMARK(BM_KeyStateWorkload)
+    ->ArgName("pattern")
+    ->DenseRange(static_cast<int>(WorkloadPattern::CHORDS), static_cast<int>(WorkloadPattern::MIC));
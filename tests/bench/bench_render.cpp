@@ -0,0 +1,100 @@
+/**
+ * Benchmarks for full rendered frames
+ *
+ * Times a frame as the app draws it: form update and draw, DrawManager's glow and blur passes, and the
+ * post-processing pipeline, at the panel's 160x32, a 640x128 preview and 1080p. Each frame ends with glFinish(),
+ * so the time includes the GPU, or llvmpipe on a machine without one.
+ *
+ * GPU time per render pass comes from RenderGraph's timer and is reported as gpu_ms/<pass> counters, in
+ * milliseconds per frame. Whatever gpu_ms does not account for is form drawing outside the timed passes and CPU
+ * work.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+
+#include "BenchContext.hpp"
+#include "ColorProvider.hpp"
+#include "DrawManager.hpp"
+#include "Effects/AllEffects.hpp"
+#include "GlowShape.hpp"
+#include "KeyState.hpp"
+#include "RandomParticles.hpp"
+#include "ShaderPipeline.hpp"
+#include "Thunder.hpp"
+
+#define RENDER_WARMUP_FRAMES 10  // Compiles shader variants and fills the target pool before timing
+#define RENDER_POLYPHONY 10
+
+struct RenderWorkload {
+    std::string name;
+    std::function<std::shared_ptr<VisualForm>()> create;
+};
+
+// A form per kind of GPU work: many glow passes, blur over bolts, and many small sprites
+static const std::vector<RenderWorkload> workloads = {
+    {"GlowShape", [] { return std::make_shared<GlowShape>("GlowShape"); }},
+    {"Thunder", [] { return std::make_shared<Thunder>("Thunder"); }},
+    {"RandomParticles", [] { return std::make_shared<RandomParticles>("RandomParticles"); }},
+};
+
+static const std::vector<std::pair<int, int>> resolutions = {{160, 32}, {640, 128}, {1920, 1080}};
+
+static void BM_RenderFrame(benchmark::State & state) {
+    const RenderWorkload & workload = workloads[state.range(0)];
+    auto [width, height] = resolutions[state.range(1)];
+    glm::vec2 previousSize = ofGetWindowSize();
+    ofSetWindowShape(width, height);  // DrawManager and the forms size themselves from the window
+    state.SetLabel(workload.name + " " + ofToString(width) + "x" + ofToString(height));
+
+    KeyState ks;
+    ColorProvider clr;
+    DrawManager dm;
+    std::shared_ptr<VisualForm> form = workload.create();
+    form->setup();
+    ShaderPipeline pipeline(width, height);
+    pipeline.setRenderGraph(dm.graph);
+    pipeline.addEffect(std::make_shared<FilmGrainEffect>());
+    pipeline.addEffect(std::make_shared<ScanlinesEffect>());
+    bench::pressKeys(ks, RENDER_POLYPHONY);
+
+    // The main loop's update and draw events advance the frame time and number that forms, the render graph and
+    // the GPU timer read
+    auto frame = [&] {
+        ofEvents().notifyUpdate();
+        form->update(ks, clr);
+        dm.beginDraw();
+        ofBackground(0, 0, 0, 255);
+        ofPushStyle();
+        form->draw(ks, clr, dm);
+        ofPopStyle();
+        dm.endDraw();
+        pipeline.processAndDraw(dm.getFboFront(), 0, 0);
+        glFinish();
+        ofEvents().notifyDraw();
+    };
+    for (int i = 0; i < RENDER_WARMUP_FRAMES; i++) {
+        frame();
+    }
+
+    GpuTimer & timer = dm.graph->getTimer();
+    timer.setEnabled(timer.isSupported());
+    for (auto _ : state) {
+        frame();
+    }
+    timer.flush();
+    if (timer.isEnabled()) {
+        for (const auto & stat : timer.getStats()) {
+            state.counters["gpu_ms/" + stat.name] = stat.averageMs;
+        }
+        state.counters["gpu_ms"] = timer.getTotalMs();
+    }
+    timer.setEnabled(false);
+    ofSetWindowShape(previousSize.x, previousSize.y);
+}
+BENCHMARK(BM_RenderFrame)
+    ->ArgNames({"form", "resolution"})
+    ->ArgsProduct({{0, 1, 2}, {0, 1, 2}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,188 @@
+/**
+ * Synthetic workload player
+ *
+ * Plays WorkloadGenerator patterns in real time, either straight into a KeyState run at the app's frame rate, or as
+ * OSC to a running app, for soak tests and reproducible load. Several comma-separated patterns play at once.
+ *
+ *   workload --pattern chords,guitar --rate 8 --polyphony 6 --duration 60
+ *   workload --pattern mic --rate 100 --target osc --host 127.0.0.1 --port 19811
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "KeyState.hpp"
+#include "WorkloadGenerator.hpp"
+
+#define KEYSTATE_CLEANUP_TIME 10  // As in ofApp
+#define OSC_PORT 19811            // As in ofApp.h
+
+struct Options {
+    std::vector<WorkloadPattern> patterns = {WorkloadPattern::CHORDS};
+    WorkloadSettings settings;
+    double durationS = 10;
+    double fps = 60;
+    bool osc = false;
+    std::string host = "127.0.0.1";
+    int port = OSC_PORT;
+};
+
+static void usage() {
+    std::cerr << "usage: workload [--pattern chords,trills,gliss,sustain,guitar,mic] [--rate HZ] [--polyphony N]\n"
+                 "                [--low NOTE] [--high NOTE] [--length S] [--seed N] [--duration S] [--fps N]\n"
+                 "                [--target keystate|osc] [--host ADDRESS] [--port N]\n";
+}
+
+static bool parseOptions(int argc, char ** argv, Options & options) {
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+        if (flag == "--pattern") {
+            options.patterns.clear();
+            std::stringstream names(value);
+            std::string name;
+            while (std::getline(names, name, ',')) {
+                WorkloadPattern pattern;
+                if (!WorkloadGenerator::parsePattern(name, pattern)) {
+                    std::cerr << "Unknown pattern: " << name << "\n";
+                    return false;
+                }
+                options.patterns.push_back(pattern);
+            }
+        } else if (flag == "--rate") {
+            options.settings.rateHz = std::stod(value);
+        } else if (flag == "--polyphony") {
+            options.settings.polyphony = std::stoi(value);
+        } else if (flag == "--low") {
+            options.settings.lowNote = std::stoi(value);
+        } else if (flag == "--high") {
+            options.settings.highNote = std::stoi(value);
+        } else if (flag == "--length") {
+            options.settings.noteLengthS = std::stod(value);
+        } else if (flag == "--seed") {
+            options.settings.seed = std::stoul(value);
+        } else if (flag == "--duration") {
+            options.durationS = std::stod(value);
+        } else if (flag == "--fps") {
+            options.fps = std::max(std::stod(value), 1.0);
+        } else if (flag == "--target") {
+            if (value != "keystate" && value != "osc") {
+                return false;
+            }
+            options.osc = value == "osc";
+        } else if (flag == "--host") {
+            options.host = value;
+        } else if (flag == "--port") {
+            options.port = std::stoi(value);
+        } else {
+            return false;
+        }
+    }
+    return !options.patterns.empty();
+}
+
+// The frame's events from every pattern, in time order
+static void generateFrame(std::vector<WorkloadGenerator> & generators, double untilS,
+                          std::vector<WorkloadEvent> & events) {
+    events.clear();
+    for (auto & generator : generators) {
+        generator.generateUntil(untilS, events);
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const WorkloadEvent & a, const WorkloadEvent & b) { return a.timeS < b.timeS; });
+}
+
+int main(int argc, char ** argv) {
+    Options options;
+    try {
+        if (!parseOptions(argc, argv, options)) {
+            usage();
+            return 2;
+        }
+    } catch (const std::exception &) {
+        usage();
+        return 2;
+    }
+
+    // Each pattern gets its own seed, so two of the same pattern don't play in unison
+    std::vector<WorkloadGenerator> generators;
+    for (size_t i = 0; i < options.patterns.size(); i++) {
+        WorkloadSettings settings = options.settings;
+        settings.pattern = options.patterns[i];
+        settings.seed += i;
+        generators.emplace_back(settings);
+    }
+
+    int sock = -1;
+    sockaddr_in address{};
+    if (options.osc) {
+        sock = socket(AF_INET, SOCK_DGRAM, 0);
+        address.sin_family = AF_INET;
+        address.sin_port = htons(options.port);
+        if (sock < 0 || inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1) {
+            std::cerr << "Cannot send to " << options.host << ":" << options.port << "\n";
+            return 1;
+        }
+    }
+
+    KeyState ks;
+    std::vector<WorkloadEvent> events;
+    uint64_t sent = 0;
+    size_t peakPolyphony = 0;
+    double handlerS = 0;
+    double worstFrameS = 0;
+    unsigned int frame = 0;
+    double frameS = 1.0 / options.fps;
+
+    auto start = std::chrono::steady_clock::now();
+    for (double t = frameS; t <= options.durationS + frameS / 2; t += frameS, frame++) {
+        std::this_thread::sleep_until(start + std::chrono::duration<double>(t));
+        generateFrame(generators, t, events);
+        sent += events.size();
+
+        if (options.osc) {
+            for (const auto & event : events) {
+                std::vector<uint8_t> packet = WorkloadGenerator::encodeOsc(event);
+                sendto(sock, packet.data(), packet.size(), 0, reinterpret_cast<sockaddr *>(&address),
+                       sizeof(address));
+            }
+            continue;
+        }
+
+        // What the app does with input each frame, before any form draws
+        double t0 = getSystemTimeSecondsPrecise();
+        for (const auto & event : events) {
+            WorkloadGenerator::apply(event, ks);
+        }
+        ks.decayEphemeralKeypressAmplitudes(frameS);
+        ks.cleanup(KEYSTATE_CLEANUP_TIME, frame, frameS);
+        peakPolyphony = std::max(peakPolyphony, ks.activePresses().size() + ks.allEphemeralPresses().size());
+        double elapsedS = getSystemTimeSecondsPrecise() - t0;
+        handlerS += elapsedS;
+        worstFrameS = std::max(worstFrameS, elapsedS);
+    }
+
+    double runS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << sent << " messages in " << runS << " s (" << sent / runS << "/s)\n";
+    if (options.osc) {
+        close(sock);
+    } else {
+        std::cout << "peak polyphony " << peakPolyphony << ", " << ks.allPresses().size() << " presses kept\n"
+                  << "KeyState " << 1e6 * handlerS / std::max(frame, 1u) << " us/frame mean, " << 1e6 * worstFrameS
+                  << " us worst\n";
+    }
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Plain thread_locals, so reading them from operator new never allocates
+static thread_local bool counting = false;
+static thread_local size_t allocations = 0;
+
+void * operator new(std::size_t size) {
+    if (counting) {
+        allocations++;
+    }
+    if (void * p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+
+ScopedAllocationCounter::ScopedAllocationCounter() {
+    allocations = 0;
+    counting = true;
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() { counting = false; }
+
+size_t ScopedAllocationCounter::count() const { return allocations; }
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Counts the heap allocations the calling thread makes while a ScopedAllocationCounter is alive.
+ *
+ * AllocationCounter.cpp replaces the global operator new for the whole test binary, but it only counts inside a
+ * scope and only on that scope's thread. Other suites, and threads the code under test doesn't own (drivers, gtest),
+ * allocate uncounted. Scopes don't nest.
+ *
+ * Usage:
+ *   ScopedAllocationCounter allocations;
+ *   runSteadyStateFrames();
+ *   EXPECT_EQ(allocations.count(), 0);
+ */
+class ScopedAllocationCounter {
+   public:
+    ScopedAllocationCounter();
+    ~ScopedAllocationCounter();
+
+    ScopedAllocationCounter(const ScopedAllocationCounter &) = delete;
+    ScopedAllocationCounter & operator=(const ScopedAllocationCounter &) = delete;
+
+    // Allocations so far; the count stops when the scope ends
+    [[nodiscard]] size_t count() const;
+};
@@ -9,11 +9,13 @@
 
 #include <gtest/gtest.h>
 
+#include "AllocationCounter.hpp"
 #include "fixtures/FormTestFixture.hpp"
 
 // Import all form types
 #include "Forms/Particles/EdgeParticles.hpp"
 #include "Forms/Particles/RadialParticles.hpp"
+#include "Forms/Particles/RandomParticles.hpp"
 #include "Forms/Shapes/MeshGrid.hpp"
 #include "Forms/Shapes/NoiseGrid.hpp"
 #include "Forms/Waves/EdgeLasers.hpp"
@@ -54,6 +56,37 @@ TEST_F(RadialParticlesTest, MultipleFrames) {
     EXPECT_EQ(glGetError(), GL_NO_ERROR);
 }
 
+// Records which presses update() emits particles for
+class PressRecordingParticles : public RadialParticles {
+   public:
+    using RadialParticles::RadialParticles;
+    std::vector<unsigned int> emittedFor;
+
+   protected:
+    void createParticlesForPress(const Press & press, int numberOfParticlesToCreate, ofColor c,
+                                 float arousalPct) override {
+        emittedFor.push_back(press.id);
+        RadialParticles::createParticlesForPress(press, numberOfParticlesToCreate, c, arousalPct);
+    }
+};
+
+TEST_F(RadialParticlesTest, UpdateEmitsForActiveAndEphemeralPresses) {
+    PressRecordingParticles recording("PressRecordingParticles");
+    recording.setup();
+    ks.newKeyPressedHandler(60, 0.8f, 1);
+    ks.newKeyPressedHandler(62, 0.8f, 2);
+    ks.keyReleasedHandler(62);
+    ks.ephemeralKeyPressedHandler(64, 0.5f, 3);
+
+    recording.update(ks, clr);
+    EXPECT_EQ(recording.emittedFor, (std::vector<unsigned int>{1, 3}));
+
+    recording.emittedFor.clear();
+    ks.keyReleasedHandler(60);
+    recording.update(ks, clr);
+    EXPECT_EQ(recording.emittedFor, (std::vector<unsigned int>{3}));
+}
+
 // ============================================================================
 
 class NoiseGridTest : public FormTestFixture {
@@ -84,6 +117,15 @@ TEST_F(NoiseGridTest, RendersWithActiveNotes) {
     expectValidUpdateDraw(*form);
 }
 
+// Blocks of 7 divide neither side of the 1920x1080 canvas, so the last row and column of blocks are clipped
+TEST_F(NoiseGridTest, BlocksThatDontDivideTheCanvasAreClipped) {
+    form->setup();
+    form->parameters.getFloat("resolution") = 7;
+    triggerNote(60, 0.8f);
+
+    expectValidUpdateDraw(*form);
+}
+
 // ============================================================================
 
 class EdgeParticlesTest : public FormTestFixture {
@@ -141,6 +183,52 @@ TEST_F(EdgeLasersTest, UpdateDrawWithoutCrash) {
     expectValidUpdateDraw(*form);
 }
 
+// ============================================================================
+
+// Without the app's loop the frame time is zero, so update() neither emits nor moves particles. Each frame emits a
+// fixed batch per held press and drifts every particle right instead, so particles keep leaving the screen and
+// being pruned, and their palette slots stay in use.
+class SteadyStateParticles : public RandomParticles {
+   public:
+    using RandomParticles::RandomParticles;
+
+    void frame(KeyState & ks, ColorProvider & clr) {
+        ks.forEachActivePress(
+            [&](const Press & press) { createParticlesForPress(press, 5, ofColor(255, 255, 255), ks.arousalPct()); });
+        for (auto & pp : particles) {
+            pp.particle.position.x += 8;
+        }
+        update(ks, clr);
+    }
+
+    [[nodiscard]] size_t particleCount() const { return particles.size(); }
+};
+
+class RandomParticlesTest : public FormTestFixture {};
+
+TEST_F(RandomParticlesTest, SteadyStateFramesDoNotAllocate) {
+    SteadyStateParticles form("SteadyStateParticles");
+    form.setup();
+    for (int note = 60; note < 68; note++) {
+        ks.newKeyPressedHandler(note, 0.8f, note);
+    }
+    // Long enough for the first particles to have left the screen, so the pool and palette have reached their size
+    for (int i = 0; i < 300; i++) {
+        form.frame(ks, clr);
+    }
+    size_t warmCount = form.particleCount();
+
+    ScopedAllocationCounter allocations;
+    for (int i = 0; i < 100; i++) {
+        form.frame(ks, clr);
+    }
+    size_t allocationCount = allocations.count();
+
+    EXPECT_EQ(allocationCount, 0);
+    EXPECT_GT(warmCount, 0);
+    EXPECT_GT(form.particleCount(), 0);
+}
+
 // ============================================================================
 // Comprehensive Tests
 // ============================================================================
@@ -273,3 +361,44 @@ TEST_F(DrawManagerTest, MultipleDrawCycles) {
 
     EXPECT_EQ(glGetError(), GL_NO_ERROR);
 }
+
+TEST_F(DrawManagerTest, GlowVariantsCompileOncePerCombination) {
+    dm.beginDraw();
+    ofClear(0, 0, 0, 255);
+    dm.shadeGlowCircle(ofVec3f(0, 0, 0), 10, ofColor::white, 1.2, 10, 1, false);
+    dm.shadeGlowCircle(ofVec3f(5, 5, 0), 20, ofColor::red, 1.2, 10, 1, false);
+    dm.shadeGlowCircle(ofVec3f(0, 0, 0), 10, ofColor::white, 1.2, 10, 2, true);
+    dm.endDraw();
+
+    EXPECT_EQ(dm.shaderVariantsGlowCircle.getCompiledCount(), 2);
+    EXPECT_EQ(&dm.shaderVariantsGlowCircle.get(1, false), &dm.shaderVariantsGlowCircle.get(1, false));
+    EXPECT_EQ(dm.shaderVariantsGlowLine.getCompiledCount(), 0);
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
+TEST_F(DrawManagerTest, GlowSpriteBlendModesMapToBlendUnit) {
+    ofBlendMode mode = OF_BLENDMODE_DISABLED;
+    ASSERT_TRUE(DrawManager::getGlowSpriteBlendMode(0, mode));
+    EXPECT_EQ(mode, OF_BLENDMODE_SCREEN);
+    ASSERT_TRUE(DrawManager::getGlowSpriteBlendMode(1, mode));
+    EXPECT_EQ(mode, OF_BLENDMODE_SCREEN);
+    ASSERT_TRUE(DrawManager::getGlowSpriteBlendMode(2, mode));
+    EXPECT_EQ(mode, OF_BLENDMODE_ADD);
+    for (int blendMode = 3; blendMode <= 8; blendMode++) {
+        EXPECT_FALSE(DrawManager::getGlowSpriteBlendMode(blendMode, mode)) << blendMode;
+    }
+}
+
+TEST_F(DrawManagerTest, GlowSpritesFallBackToShaderPassForOtherModes) {
+    std::vector<DrawManager::GlowSprite> sprites = {{glm::vec3(10, 10, 0), 5, ofFloatColor::white},
+                                                    {glm::vec3(30, 20, 0), 8, ofFloatColor::red}};
+    dm.beginDraw();
+    ofClear(0, 0, 0, 255);
+    dm.drawGlowSprites(sprites, 1.2, 10, 2, false);
+    EXPECT_EQ(dm.shaderVariantsGlowCircle.getCompiledCount(), 0);  // Batched
+
+    dm.drawGlowSprites(sprites, 1.2, 10, 5, false);
+    EXPECT_EQ(dm.shaderVariantsGlowCircle.getCompiledCount(), 1);
+    dm.endDraw();
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
@@ -0,0 +1,142 @@
+/**
+ * Integration tests for the LED output path
+ *
+ * These tests verify the frame readback that feeds the LED panels returns
+ * the same pixels as a synchronous read, after its pipeline latency, and
+ * that the panel resolve scales, rotates and maps the frame as configured.
+ *
+ * Tests require a valid OpenGL context.
+ */
+
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include "PanelResolve.hpp"
+#include "PixelReadback.hpp"
+#include "fixtures/GLTestFixture.hpp"
+
+class LedOutputTest : public GLTestFixture {
+   protected:
+    ofFbo fbo;
+
+    void SetUp() override {
+        GLTestFixture::SetUp();
+        fbo.allocate(160, 32, GL_RGBA);
+    }
+
+    // A frame that differs top to bottom and left to right, so a flip or offset shows
+    void drawFrame(const ofColor & color) {
+        fbo.begin();
+        ofClear(0, 0, 0, 255);
+        ofSetColor(color);
+        ofDrawRectangle(0, 0, 40, 8);
+        fbo.end();
+    }
+
+    static ofPixels resolveFrame(PanelResolve & resolve, std::function<void()> draw) {
+        resolve.begin();
+        ofClear(0, 0, 0, 255);
+        draw();
+        resolve.end();
+        resolve.resolve();
+        ofPixels pixels;
+        resolve.getPanel().readToPixels(pixels);
+        return pixels;
+    }
+};
+
+TEST_F(LedOutputTest, Readback_MatchesSynchronousReadAfterLatency) {
+    PixelReadback readback;
+    readback.setFlipVertical(false);  // FBO rows are already stored top-down
+
+    const ofColor colors[] = {ofColor::red, ofColor::green, ofColor::blue, ofColor::white};
+    std::vector<ofPixels> expected;
+    for (const auto & color : colors) {
+        drawFrame(color);
+        ofPixels pixels;
+        fbo.readToPixels(pixels);
+        expected.push_back(pixels);
+
+        fbo.bind();
+        readback.request(0, 0, 160, 32);
+        fbo.unbind();
+    }
+
+    ofPixels * latest = readback.latest();
+    ASSERT_NE(latest, nullptr);
+    const ofPixels & want = expected[expected.size() - 1 - readback.getLatencyFrames()];
+    ASSERT_EQ(latest->getWidth(), 160);
+    ASSERT_EQ(latest->getHeight(), 32);
+    for (int y = 0; y < 32; y += 7) {
+        for (int x = 0; x < 160; x += 13) {
+            EXPECT_EQ(latest->getColor(x, y), want.getColor(x, y)) << "at " << x << "," << y;
+        }
+    }
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
+TEST_F(LedOutputTest, Readback_KeepsOneBufferAcrossFrames) {
+    PixelReadback readback;
+    drawFrame(ofColor::red);
+    fbo.bind();
+    for (int i = 0; i < 4; i++) {
+        readback.request(0, 0, 160, 32);
+    }
+    fbo.unbind();
+
+    ofPixels * first = readback.latest();
+    ASSERT_NE(first, nullptr);
+    const unsigned char * data = first->getData();
+    fbo.bind();
+    readback.request(0, 0, 160, 32);
+    fbo.unbind();
+    EXPECT_EQ(readback.latest()->getData(), data);
+}
+
+TEST_F(LedOutputTest, Resolve_RotatesClockwise) {
+    // A portrait source on a landscape chain, as with Rotate:90
+    PanelResolve resolve;
+    resolve.setup(32, 160, 160, 32, 1);
+    ofPixels panel = resolveFrame(resolve, [] {
+        ofSetColor(ofColor::red);
+        ofDrawRectangle(0, 0, 8, 8);  // Source top-left
+    });
+
+    ASSERT_EQ(panel.getWidth(), 160);
+    ASSERT_EQ(panel.getHeight(), 32);
+    EXPECT_EQ(panel.getColor(156, 3), ofColor::red);  // Panel top-right
+    EXPECT_EQ(panel.getColor(3, 3), ofColor::black);
+    EXPECT_EQ(panel.getColor(156, 28), ofColor::black);
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
+TEST_F(LedOutputTest, Resolve_DownscaleAveragesSourcePixels) {
+    PanelResolve resolve;
+    resolve.setup(320, 64, 160, 32, 0);
+    ofPixels panel = resolveFrame(resolve, [] {
+        ofSetColor(ofColor::white);
+        for (int x = 0; x < 320; x += 2) {
+            ofDrawRectangle(x, 0, 1, 64);  // Alternate white and black columns
+        }
+    });
+
+    ASSERT_EQ(panel.getWidth(), 160);
+    for (int x = 0; x < 160; x += 17) {
+        EXPECT_NEAR(panel.getColor(x, 16).r, 128, 2) << "at " << x;
+    }
+}
+
+TEST_F(LedOutputTest, Resolve_AppliesLut) {
+    PanelResolve resolve;
+    resolve.setup(160, 32, 160, 32, 0);
+    resolve.setLut(2.2, 0.5);
+    ofPixels panel = resolveFrame(resolve, [] {
+        ofSetColor(128);
+        ofDrawRectangle(0, 0, 160, 32);
+    });
+
+    float expected = 255 * 0.5 * powf(128 / 255.0, 2.2);
+    EXPECT_NEAR(panel.getColor(80, 16).g, expected, 1);
+    EXPECT_EQ(panel.getColor(80, 16).a, 255);
+}
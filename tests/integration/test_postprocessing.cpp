@@ -336,3 +336,118 @@ TEST_F(PipelineDrawManagerTest, MultipleFrames) {
         EXPECT_EQ(glGetError(), GL_NO_ERROR);
     }
 }
+
+// ============================================================================
+// Render Graph Tests
+// ============================================================================
+
+TEST_F(PostProcessingTest, Pipeline_ChainReusesTwoPooledTargets) {
+    pipeline->addEffect(std::make_shared<FilmGrainEffect>());
+    pipeline->addEffect(std::make_shared<ScanlinesEffect>());
+    pipeline->addEffect(std::make_shared<ChromaticAberrationEffect>());
+
+    ofFbo sourceFbo;
+    sourceFbo.allocate(1920, 1080, GL_RGBA);
+
+    pipeline->process(sourceFbo);
+    pipeline->process(sourceFbo);
+
+    // Three effects ping-pong between two depthless targets, and the second frame allocates nothing new
+    RenderTargetPool & pool = pipeline->getRenderGraph()->getPool();
+    EXPECT_EQ(pool.getTargetCount(), 2);
+    EXPECT_EQ(pool.getInUseCount(), 1);  // The returned result
+    EXPECT_EQ(pool.getAllocatedBytes(), 2u * 1920 * 1080 * 4);
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
+TEST_F(PostProcessingTest, Pipeline_FirstEffectReadsInputDirectly) {
+    pipeline->addEffect(std::make_shared<FilmGrainEffect>());
+    pipeline->addEffect(std::make_shared<ScanlinesEffect>());
+
+    ofFbo sourceFbo;
+    sourceFbo.allocate(1920, 1080, GL_RGBA);
+    pipeline->process(sourceFbo);
+
+    const auto & passes = pipeline->getRenderGraph()->getCurrentPasses();
+    ASSERT_EQ(passes.size(), 2);
+    EXPECT_EQ(passes[0].name, "Film Grain");
+    ASSERT_EQ(passes[0].inputs.size(), 1);
+    EXPECT_EQ(passes[0].inputs[0], "input");
+    EXPECT_EQ(passes[1].inputs[0], "Film Grain");
+}
+
+TEST_F(PostProcessingTest, Pipeline_FusesPixelLocalRun) {
+    auto scanlines = std::make_shared<ScanlinesEffect>();
+    scanlines->setRGBShift(0.0f);
+    pipeline->addEffect(std::make_shared<FilmGrainEffect>());
+    pipeline->addEffect(scanlines);
+    pipeline->addEffect(std::make_shared<ChromaticAberrationEffect>());
+
+    ofFbo sourceFbo;
+    sourceFbo.allocate(1920, 1080, GL_RGBA);
+    pipeline->process(sourceFbo);
+
+    const auto & passes = pipeline->getRenderGraph()->getCurrentPasses();
+    ASSERT_EQ(passes.size(), 2);
+    EXPECT_EQ(passes[0].name, "Film Grain + Scanlines");
+    EXPECT_EQ(passes[1].name, "Chromatic Aberration");
+    EXPECT_EQ(pipeline->getFusedShaderCount(), 1);
+
+    // RGB shift reads neighbours, so Scanlines drops out of the run
+    scanlines->setRGBShift(1.0f);
+    pipeline->process(sourceFbo);
+    const auto & allPasses = pipeline->getRenderGraph()->getCurrentPasses();  // Same frame, so both runs
+    ASSERT_EQ(allPasses.size(), 5);
+    EXPECT_EQ(allPasses[2].name, "Film Grain");
+    EXPECT_EQ(allPasses[3].name, "Scanlines");
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
+TEST_F(PostProcessingTest, GpuTimer_AveragesEachEffectPass) {
+    GpuTimer & timer = pipeline->getRenderGraph()->getTimer();
+    if (!timer.isSupported()) {
+        GTEST_SKIP() << "Driver has no timer queries";
+    }
+    timer.setEnabled(true);
+    pipeline->addEffect(std::make_shared<FilmGrainEffect>());
+    pipeline->addEffect(std::make_shared<ChromaticAberrationEffect>());
+
+    ofFbo sourceFbo;
+    sourceFbo.allocate(1920, 1080, GL_RGBA);
+    pipeline->process(sourceFbo);
+    timer.flush();
+
+    EXPECT_GT(pipeline->getEffectGpuMs("Film Grain"), 0.0);
+    EXPECT_GT(pipeline->getEffectGpuMs("Chromatic Aberration"), 0.0);
+    EXPECT_LT(pipeline->getEffectGpuMs("Scanlines"), 0.0);  // Never ran
+    EXPECT_EQ(timer.getStats().size(), 2);
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
+TEST_F(PostProcessingTest, RenderGraph_ReleasesTransientsAfterLastRead) {
+    RenderGraph graph;
+    RenderTargetDesc full = {640, 360, GL_RGBA, false};
+    RenderTargetDesc half = {320, 180, GL_RGBA, false};
+
+    RenderGraph::ResourceId a = graph.createTarget("a", full);
+    RenderGraph::ResourceId b = graph.createTarget("b", half);
+    RenderGraph::ResourceId c = graph.createTarget("c", full);
+    auto clear = [](const std::vector<ofFbo *> & inputs, ofFbo & output) {
+        output.begin();
+        ofClear(0, 0, 0, 255);
+        output.end();
+    };
+    graph.addPass("writeA", {}, a, clear);
+    graph.addPass("aToB", {a}, b, clear);
+    graph.addPass("bToC", {b}, c, clear);  // c can take a's FBO, b has a different size
+    ofFbo * kept = graph.execute(c);
+
+    ASSERT_NE(kept, nullptr);
+    EXPECT_EQ(graph.getPool().getTargetCount(), 2);
+    EXPECT_EQ(graph.getPool().getInUseCount(), 1);
+    EXPECT_EQ(graph.getPool().getAllocatedBytes(), full.getBytes() + half.getBytes());
+
+    graph.release(*kept);
+    EXPECT_EQ(graph.getPool().getInUseCount(), 0);
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
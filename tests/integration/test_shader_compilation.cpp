@@ -14,6 +14,7 @@
 #include "Effects/AllEffects.hpp"
 #include "ShaderEffect.hpp"
 #include "ShaderPipeline.hpp"
+#include "UniformCache.hpp"
 #include "fixtures/GLTestFixture.hpp"
 
 class ShaderCompilationTest : public GLTestFixture {};
@@ -242,6 +243,74 @@ TEST_F(ShaderCompilationTest, DISABLED_Scanlines_ParametersAffectShader) {
 }
 */
 
+// ============================================================================
+// Uniform Cache Tests
+// ============================================================================
+
+TEST_F(ShaderCompilationTest, UniformCache_SkipsUnchangedUploads) {
+    ofShader shader = createShader("shaderGlowCircle");
+    UniformCache uniforms;
+    size_t params = uniforms.declare(shader, "glowParams");
+    EXPECT_EQ(uniforms.declare(shader, "glowParams"), params);
+
+    const float values[16] = {100, 100, 0, 10, 0, 0, 0, 0, 1, 0.5, 0.25, 1, 1.2, 10, 1, 0};
+    shader.begin();
+    uniforms.set4fv(params, values, 4);
+    uniforms.set4fv(params, values, 4);
+    shader.end();
+
+    EXPECT_EQ(uniforms.getUploadCount(), 1);
+    EXPECT_EQ(uniforms.getSkippedCount(), 1);
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
+// Exposes uniform declaration to the tests
+class UniformProbeEffect : public FilmGrainEffect {
+   public:
+    using ShaderEffect::declareUniform;
+    using ShaderEffect::loadShader;
+};
+
+TEST_F(ShaderCompilationTest, ShaderEffect_ResolvesFusedUniformsOnce) {
+    UniformProbeEffect effect;
+    ASSERT_TRUE(effect.isValid());
+    size_t grainIntensity = effect.declareUniform("grainIntensity");
+    EXPECT_EQ(effect.declareUniform("grainIntensity"), grainIntensity);  // The parameter's declaration
+    ASSERT_TRUE(effect.loadShader());
+    EXPECT_EQ(effect.declareUniform("grainIntensity"), grainIntensity);  // Ids outlive reloads
+
+    ofShader target = createShader("post/shaderFilmGrain");
+    UniformCache uniforms;
+    std::vector<size_t> handles;
+    target.begin();
+    effect.applyFusedUniforms(target, uniforms, handles, glm::vec2(320, 240));
+    size_t resolved = handles.size();
+    uint64_t uploads = uniforms.getUploadCount();
+    effect.applyFusedUniforms(target, uniforms, handles, glm::vec2(320, 240));
+    target.end();
+
+    EXPECT_EQ(resolved, 4);  // resolution, time, grainIntensity, grainSize
+    EXPECT_EQ(handles.size(), resolved);
+    EXPECT_EQ(uniforms.getUploadCount(), uploads);  // Nothing changed, so the second frame only compares
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
+TEST_F(ShaderCompilationTest, ProgramBinaryCache_SecondCreateLoadsFromCache) {
+    ProgramBinaryCache & cache = getProgramBinaryCache();
+    if (!cache.isSupported()) {
+        GTEST_SKIP() << "Driver does not support program binaries";
+    }
+
+    ofShader compiled = createShader("shaderGlowCircle");
+    int hits = cache.getHits();
+    ofShader cached = createShader("shaderGlowCircle");
+
+    ASSERT_TRUE(cached.isLoaded());
+    EXPECT_EQ(cache.getHits(), hits + 1);
+    EXPECT_EQ(cached.getUniformLocation("glowParams"), compiled.getUniformLocation("glowParams"));
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
 // ============================================================================
 // Error Handling Tests
 // TODO: Rewrite to use new API
@@ -0,0 +1,78 @@
+/**
+ * Integration tests for StreamingTexture
+ *
+ * These tests verify that frames uploaded through the pixel unpack buffer
+ * arrive intact, that repeated uploads reuse one texture, and that a size
+ * change reallocates it.
+ *
+ * Tests require a valid OpenGL context.
+ */
+
+#include <gtest/gtest.h>
+
+#include "StreamingTexture.hpp"
+#include "fixtures/GLTestFixture.hpp"
+
+class StreamingTextureTest : public GLTestFixture {
+   protected:
+    // A frame that differs top to bottom and left to right, so a flip or offset shows
+    static ofPixels makeFrame(int width, int height, unsigned char seed) {
+        ofPixels pixels;
+        pixels.allocate(width, height, OF_PIXELS_RGBA);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                pixels.setColor(x, y, ofColor((x * 7 + seed) % 256, (y * 13 + seed) % 256, seed, 255));
+            }
+        }
+        return pixels;
+    }
+
+    static void expectMatches(ofTexture & texture, const ofPixels & expected) {
+        ofPixels actual;
+        texture.readToPixels(actual);
+        ASSERT_EQ(actual.getWidth(), expected.getWidth());
+        ASSERT_EQ(actual.getHeight(), expected.getHeight());
+        for (size_t y = 0; y < expected.getHeight(); y += 5) {
+            for (size_t x = 0; x < expected.getWidth(); x += 11) {
+                EXPECT_EQ(actual.getColor(x, y), expected.getColor(x, y)) << "at " << x << "," << y;
+            }
+        }
+    }
+};
+
+TEST_F(StreamingTextureTest, UploadMatchesPixels) {
+    StreamingTexture texture;
+    ofPixels frame = makeFrame(192, 48, 40);
+    texture.update(frame);
+
+    ASSERT_TRUE(texture.isAllocated());
+    expectMatches(texture.getTexture(), frame);
+    EXPECT_EQ(glGetError(), GL_NO_ERROR);
+}
+
+TEST_F(StreamingTextureTest, RepeatedUploadsReuseTexture) {
+    StreamingTexture texture;
+    texture.update(makeFrame(192, 48, 1));
+    GLuint id = texture.getTexture().getTextureData().textureID;
+
+    ofPixels last;
+    for (unsigned char seed = 2; seed < 6; seed++) {
+        last = makeFrame(192, 48, seed);
+        texture.update(last);
+    }
+    EXPECT_EQ(texture.getTexture().getTextureData().textureID, id);
+    expectMatches(texture.getTexture(), last);
+}
+
+TEST_F(StreamingTextureTest, SizeChangeReallocates) {
+    StreamingTexture texture;
+    texture.update(makeFrame(192, 48, 1));
+    ofPixels larger = makeFrame(320, 64, 9);
+    texture.update(larger);
+
+    EXPECT_EQ(texture.getTexture().getWidth(), 320);
+    expectMatches(texture.getTexture(), larger);
+
+    texture.clear();
+    EXPECT_FALSE(texture.isAllocated());
+}
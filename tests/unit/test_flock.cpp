@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 #include "../src/Forms/Flock.hpp"
 #include "../src/Forms/SizedSprite.hpp"
+#include "../src/Forms/SpatialGrid.hpp"
+#include "../src/WorkerPool.hpp"
 #include "ofMain.h"
 
 class FlockTest : public ::testing::Test {
@@ -257,3 +261,156 @@ TEST_F(FlockTest, FastForwardParameter) {
     float distance2 = glm::length(flock2.l[0].position - initialPos);
     EXPECT_GT(distance2, distance1);
 }
+
+// ============================================================================
+// Test spatial grid
+// ============================================================================
+
+TEST(SpatialGridTest, CandidatesCoverAllNeighbours) {
+    std::vector<glm::vec3> positions;
+    unsigned int seed = 12345;
+    auto random = [&seed](float range) {
+        seed = seed * 1103515245 + 12345;
+        return range * static_cast<float>((seed >> 8) & 0xFFFF) / 65535.0f;
+    };
+    for (int i = 0; i < 500; i++) {
+        positions.emplace_back(random(400), random(300), random(50));
+    }
+
+    float radius = 30.0f;
+    SpatialGrid grid;
+    grid.build(positions, radius);
+    EXPECT_GT(grid.getCellCount(), 1);
+
+    for (size_t i = 0; i < positions.size(); i++) {
+        std::vector<bool> seen(positions.size(), false);
+        grid.forEachCandidate(positions[i], [&seen](uint32_t j) { seen[j] = true; });
+        for (size_t j = 0; j < positions.size(); j++) {
+            glm::vec3 diff = positions[j] - positions[i];
+            if (glm::dot(diff, diff) <= radius * radius) {
+                EXPECT_TRUE(seen[j]) << "Point " << j << " within range of " << i << " was not a candidate";
+            }
+        }
+    }
+}
+
+TEST(SpatialGridTest, VisitsEachPointOnce) {
+    std::vector<glm::vec3> positions = {glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0)};
+    SpatialGrid grid;
+    grid.build(positions, 10.0f);
+
+    std::vector<int> visits(positions.size(), 0);
+    grid.forEachCandidate(glm::vec3(0, 0, 0), [&visits](uint32_t j) { visits[j]++; });
+    for (int v : visits) {
+        EXPECT_EQ(v, 1);
+    }
+}
+
+TEST(SpatialGridTest, CellCountIsCapped) {
+    std::vector<glm::vec3> positions = {glm::vec3(0, 0, 0), glm::vec3(100000, 100000, 100000)};
+    SpatialGrid grid;
+    grid.build(positions, 1.0f, 4096);
+
+    EXPECT_LE(grid.getCellCount(), 4096);
+    EXPECT_GE(grid.getCellSize(), 1.0f);
+}
+
+TEST(SpatialGridTest, EmptyBuildVisitsNothing) {
+    SpatialGrid grid;
+    grid.build({}, 10.0f);
+
+    int visits = 0;
+    grid.forEachCandidate(glm::vec3(0, 0, 0), [&visits](uint32_t) { visits++; });
+    EXPECT_EQ(visits, 0);
+}
+
+TEST_F(FlockTest, LargePopulationStaysWithinVelocityBounds) {
+    for (int i = 0; i < 2000; i++) {
+        glm::vec3 pos(100 + (i * 37) % 1700, 100 + (i * 53) % 900, (i * 11) % 400 - 200);
+        glm::vec3 vel((i % 7) - 3.0f, (i % 5) - 2.0f, 1.0f);
+        flock.l.push_back(SizedSprite(pos, vel, ofColor::white, 5.0f));
+    }
+
+    for (int frame = 0; frame < 10; frame++) {
+        flock.update(1.0f / 60.0f, frame / 60.0f);
+    }
+
+    for (const auto & sprite : flock.l) {
+        float speed = glm::length(sprite.velocity);
+        EXPECT_LE(speed, flock.maxVelocity + 0.01f);
+        EXPECT_GE(speed, flock.minVelocity - 0.01f);
+    }
+}
+
+// ============================================================================
+// Test parallel update
+// ============================================================================
+
+TEST(WorkerPoolTest, CoversEveryIndexOnce) {
+    WorkerPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+
+    for (int round = 0; round < 20; round++) {
+        pool.parallelFor(visits.size(), 7, [&visits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                visits[i]++;
+            }
+        });
+    }
+
+    for (const auto & v : visits) {
+        EXPECT_EQ(v.load(), 20);
+    }
+}
+
+TEST_F(FlockTest, ParallelUpdateMatchesSerial) {
+    for (int i = 0; i < 1500; i++) {
+        glm::vec3 pos(100 + (i * 37) % 1700, 100 + (i * 53) % 900, (i * 11) % 400 - 200);
+        glm::vec3 vel((i % 7) - 3.0f, (i % 5) - 2.0f, 1.0f);
+        flock.l.push_back(SizedSprite(pos, vel, ofColor::white, 5.0f));
+    }
+    Flock serial;
+    serial.l = flock.l;
+    serial.fastForward = flock.fastForward;
+    serial.visualRange = flock.visualRange;
+    serial.minDistance = flock.minDistance;
+    serial.avoidFactor = flock.avoidFactor;
+    serial.alignmentFactor = flock.alignmentFactor;
+    serial.centeringFactor = flock.centeringFactor;
+    serial.turnFactor = flock.turnFactor;
+    serial.minVelocity = flock.minVelocity;
+    serial.maxVelocity = flock.maxVelocity;
+    serial.margin = flock.margin;
+    serial.xMin = flock.xMin;
+    serial.xMax = flock.xMax;
+    serial.yMin = flock.yMin;
+    serial.yMax = flock.yMax;
+    serial.zMin = flock.zMin;
+    serial.zMax = flock.zMax;
+
+    serial.threads = 1;
+    flock.threads = 4;
+    for (int frame = 0; frame < 10; frame++) {
+        serial.update(1.0f / 60.0f, frame / 60.0f);
+        flock.update(1.0f / 60.0f, frame / 60.0f);
+    }
+
+    // Bitwise equal: the result must not depend on how boids were split across threads
+    for (size_t i = 0; i < flock.l.size(); i++) {
+        EXPECT_EQ(flock.l[i].position.x, serial.l[i].position.x);
+        EXPECT_EQ(flock.l[i].position.y, serial.l[i].position.y);
+        EXPECT_EQ(flock.l[i].position.z, serial.l[i].position.z);
+        EXPECT_EQ(flock.l[i].velocity.x, serial.l[i].velocity.x);
+    }
+}
+
+TEST_F(FlockTest, UpdateDoesNotDependOnOrder) {
+    // Two mirrored boids must get mirrored velocities regardless of which is updated first
+    flock.l.push_back(SizedSprite(glm::vec3(900, 500, 0), glm::vec3(1, 0, 0), ofColor::white, 5.0f));
+    flock.l.push_back(SizedSprite(glm::vec3(1020, 500, 0), glm::vec3(-1, 0, 0), ofColor::white, 5.0f));
+
+    flock.update(1.0f / 60.0f, 0.0f);
+
+    EXPECT_FLOAT_EQ(flock.l[0].velocity.x, -flock.l[1].velocity.x);
+    EXPECT_FLOAT_EQ(flock.l[0].velocity.y, flock.l[1].velocity.y);
+}
@@ -0,0 +1,194 @@
+/**
+ * Unit tests for FrameProfiler
+ *
+ * Tests that zones are only recorded while profiling is on, that percentiles come from the recent window of each
+ * zone, that threads record side by side without losing zones until a ring fills, and that the Chrome trace parses.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <set>
+#include <thread>
+
+#include "FrameProfiler.hpp"
+#include "ofMain.h"
+
+#define TRACE_PATH "/tmp/orgb-test-trace.json"
+
+class FrameProfilerTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        FrameProfiler::reset();
+        FrameProfiler::setEnabled(true);
+    }
+    void TearDown() override {
+        FrameProfiler::setEnabled(false);
+        FrameProfiler::reset();
+        std::remove(TRACE_PATH);
+    }
+
+    static std::optional<FrameProfiler::Stat> statFor(const std::string & name) {
+        for (const auto & stat : FrameProfiler::getStats()) {
+            if (stat.name == name) {
+                return stat;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Durations of whole milliseconds, without waiting for them
+    static void recordMs(const std::string & name, double ms) {
+        FrameProfiler::record(FrameProfiler::zoneId(name), 0, static_cast<uint64_t>(ms * 1e6));
+    }
+};
+
+// ============================================================================
+// Test recording
+// ============================================================================
+
+TEST_F(FrameProfilerTest, DisabledRecordsNothing) {
+    FrameProfiler::setEnabled(false);
+    { PROFILE_ZONE("Disabled"); }
+    FrameProfiler::collect();
+    EXPECT_FALSE(statFor("Disabled").has_value());
+    EXPECT_EQ(FrameProfiler::getSummary(), "Profiler: off");
+}
+
+TEST_F(FrameProfilerTest, ZonesNest) {
+    for (int i = 0; i < 3; i++) {
+        PROFILE_ZONE("Outer");
+        {
+            PROFILE_ZONE("Inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    FrameProfiler::collect();
+    auto outer = statFor("Outer");
+    auto inner = statFor("Inner");
+    ASSERT_TRUE(outer.has_value());
+    ASSERT_TRUE(inner.has_value());
+    EXPECT_EQ(outer->count, 3u);
+    EXPECT_EQ(inner->count, 3u);
+    EXPECT_GE(inner->p50Ms, 1.0);
+    EXPECT_GE(outer->p50Ms, inner->p50Ms);
+}
+
+TEST_F(FrameProfilerTest, NamedZonesOnlyBuildNamesWhileEnabled) {
+    int built = 0;
+    auto name = [&built]() {
+        built++;
+        return std::string("Named");
+    };
+    { PROFILE_ZONE_NAMED(name()); }
+    FrameProfiler::setEnabled(false);
+    { PROFILE_ZONE_NAMED(name()); }
+    EXPECT_EQ(built, 1);
+    FrameProfiler::collect();
+    EXPECT_EQ(statFor("Named")->count, 1u);
+}
+
+// ============================================================================
+// Test percentiles
+// ============================================================================
+
+TEST_F(FrameProfilerTest, PercentilesAreNearestRank) {
+    for (int ms = 100; ms >= 1; ms--) {
+        recordMs("Ranked", ms);
+    }
+    FrameProfiler::collect();
+    auto stat = statFor("Ranked");
+    ASSERT_TRUE(stat.has_value());
+    EXPECT_EQ(stat->count, 100u);
+    EXPECT_DOUBLE_EQ(stat->p50Ms, 50);
+    EXPECT_DOUBLE_EQ(stat->p95Ms, 95);
+    EXPECT_DOUBLE_EQ(stat->p99Ms, 99);
+    EXPECT_DOUBLE_EQ(stat->maxMs, 100);
+}
+
+TEST_F(FrameProfilerTest, PercentilesForgetOldZones) {
+    for (int i = 0; i < 1000; i++) {
+        recordMs("Windowed", 1000);
+    }
+    FrameProfiler::collect();
+    for (int i = 0; i < 2000; i++) {
+        recordMs("Windowed", 1);
+    }
+    FrameProfiler::collect();
+    auto stat = statFor("Windowed");
+    EXPECT_EQ(stat->count, 1024u);
+    EXPECT_DOUBLE_EQ(stat->maxMs, 1);
+}
+
+TEST_F(FrameProfilerTest, SlowestMedianFirst) {
+    recordMs("Fast", 1);
+    recordMs("Slow", 10);
+    FrameProfiler::collect();
+    std::vector<FrameProfiler::Stat> stats = FrameProfiler::getStats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].name, "Slow");
+    EXPECT_NE(FrameProfiler::getSummary().find("Slow: 10.00 / 10.00 / 10.00"), std::string::npos);
+}
+
+// ============================================================================
+// Test threads
+// ============================================================================
+
+TEST_F(FrameProfilerTest, FullRingDropsZones) {
+    for (int i = 0; i < 10000; i++) {
+        recordMs("Flood", 1);
+    }
+    EXPECT_EQ(FrameProfiler::getDropped(), 10000u - 8192u);
+    FrameProfiler::collect();
+    recordMs("Flood", 1);  // Drained, so there is room again
+    EXPECT_EQ(FrameProfiler::getDropped(), 10000u - 8192u);
+}
+
+TEST_F(FrameProfilerTest, ThreadsAppearInTrace) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t]() {
+            FrameProfiler::setThreadName("Worker " + std::to_string(t));
+            for (int i = 0; i < 1000; i++) {
+                PROFILE_ZONE("Work");
+            }
+        });
+    }
+    // Drained while the threads are still recording
+    for (int i = 0; i < 10; i++) {
+        FrameProfiler::collect();
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    FrameProfiler::setThreadName("Main");
+    { PROFILE_ZONE("Main \"quoted\""); }
+    ASSERT_TRUE(FrameProfiler::writeChromeTrace(TRACE_PATH));
+    EXPECT_EQ(FrameProfiler::getDropped(), 0u);
+    EXPECT_EQ(statFor("Work")->count, 1024u);  // The window, of 4000
+
+    std::ifstream file(TRACE_PATH);
+    ofJson trace = ofJson::parse(file);
+    std::set<int> workThreads;
+    std::set<std::string> threadNames;
+    int work = 0;
+    bool quoted = false;
+    for (const auto & event : trace["traceEvents"]) {
+        if (event["ph"] == "X" && event["name"] == "Work") {
+            work++;
+            workThreads.insert(event["tid"].get<int>());
+            EXPECT_GE(event["dur"].get<double>(), 0);
+        } else if (event["ph"] == "X" && event["name"] == "Main \"quoted\"") {
+            quoted = true;
+        } else if (event["name"] == "thread_name") {
+            threadNames.insert(event["args"]["name"].get<std::string>());
+        }
+    }
+    EXPECT_EQ(work, 4000);
+    EXPECT_EQ(workThreads.size(), 4u);
+    EXPECT_TRUE(quoted);
+    EXPECT_TRUE(threadNames.count("Worker 3"));
+    EXPECT_TRUE(threadNames.count("Main"));
+}
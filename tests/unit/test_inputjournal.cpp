@@ -0,0 +1,175 @@
+/**
+ * Unit tests for InputJournal
+ *
+ * Tests that recorded events replay with their times and the JSON their handlers expect, that notes and control
+ * changes take the fixed-size records, and that a journal cut short replays up to the damaged record.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "InputJournal.hpp"
+
+#define JOURNAL_PATH "/tmp/orgb-test.journal"
+
+class InputJournalTest : public ::testing::Test {
+   protected:
+    InputJournalWriter writer;
+    InputJournalReader reader;
+
+    void SetUp() override { ASSERT_TRUE(writer.open(JOURNAL_PATH, 1662693581000000)); }
+    void TearDown() override {
+        reader.close();
+        std::remove(JOURNAL_PATH);
+    }
+
+    static size_t fileBytes() {
+        std::ifstream file(JOURNAL_PATH, std::ios::binary | std::ios::ate);
+        return static_cast<size_t>(file.tellg());
+    }
+};
+
+// ============================================================================
+// Test round trips
+// ============================================================================
+
+TEST_F(InputJournalTest, NotesAndControlChangesRoundTrip) {
+    writer.recordMidi({{"type", "note_on"}, {"note", 60}, {"velocity", 100}, {"channel", 0}, {"id", 3000000000u}},
+                      1000);
+    writer.recordMidi({{"type", "note_on"}, {"note", 62}, {"velocity", 90}, {"id", 7}, {"ephemeral", true}}, 1500);
+    writer.recordMidi({{"type", "note_off"}, {"note", 60}, {"velocity", 0}, {"channel", 0}}, 2000);
+    writer.recordMidi({{"type", "control_change"}, {"control", 64}, {"value", 127}, {"channel", 0}}, 2500);
+    writer.close();
+    ASSERT_TRUE(reader.open(JOURNAL_PATH));
+    EXPECT_EQ(reader.getStartUnixUs(), 1662693581000000u);
+    EXPECT_EQ(reader.getDurationUs(), 2500u);
+
+    InputJournalEvent event;
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.kind, InputJournalKind::NOTE_ON);
+    EXPECT_EQ(event.timeUs, 1000u);
+    EXPECT_EQ(event.bodyBytes, 8u);
+    ofJson j = event.json();
+    EXPECT_EQ(j["type"], "note_on");
+    EXPECT_EQ(j["note"], 60);
+    EXPECT_EQ(j["velocity"], 100);
+    EXPECT_EQ(j["id"], 3000000000u);
+    EXPECT_FALSE(j.contains("ephemeral"));
+
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.json()["ephemeral"], true);
+
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.kind, InputJournalKind::NOTE_OFF);
+    EXPECT_EQ(event.bodyBytes, 4u);
+    EXPECT_EQ(event.json()["note"], 60);
+
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.kind, InputJournalKind::CONTROL_CHANGE);
+    j = event.json();
+    EXPECT_EQ(j["type"], "control_change");
+    EXPECT_EQ(j["control"], 64);
+    EXPECT_EQ(j["value"], 127);
+    EXPECT_EQ(j["channel"], 0);
+
+    EXPECT_FALSE(reader.next(event));
+    EXPECT_TRUE(reader.isFinished());
+}
+
+TEST_F(InputJournalTest, OtherMessagesKeepTheirJson) {
+    ofJson sysex = {{"type", "sysex"}, {"data", {1, 2, 3}}};
+    ofJson noteWithoutId = {{"type", "note_on"}, {"note", 60}, {"velocity", 100}};
+    ofJson ephemeral = {{"60", 0.5}, {"64", 0.25}};
+    ofJson arousal = {{"type", "arousal"}, {"value", 0.75}};
+    writer.recordMidi(sysex, 10);
+    writer.recordMidi(noteWithoutId, 20);
+    writer.recordEphemeral(ephemeral, 4242, 30);
+    writer.recordJson(InputJournalKind::CLASSIFICATION, arousal, 40);
+    writer.recordSettings(R"({"Color": {}})", 50);
+    writer.close();
+    ASSERT_TRUE(reader.open(JOURNAL_PATH));
+
+    InputJournalEvent event;
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.kind, InputJournalKind::MIDI);
+    EXPECT_EQ(event.json(), sysex);
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.kind, InputJournalKind::MIDI);  // The handler needs the id, so the fixed record cannot hold it
+    EXPECT_EQ(event.json(), noteWithoutId);
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.kind, InputJournalKind::EPHEMERAL);
+    EXPECT_EQ(event.messageId(), 4242u);
+    EXPECT_EQ(event.json(), ephemeral);
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.kind, InputJournalKind::CLASSIFICATION);
+    EXPECT_EQ(event.json(), arousal);
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.kind, InputJournalKind::SETTINGS);
+    EXPECT_EQ(event.text(), R"({"Color": {}})");
+    EXPECT_EQ(event.json()["Color"], ofJson::object());
+}
+
+TEST_F(InputJournalTest, NotesAreCompact) {
+    for (int i = 0; i < 100; i++) {
+        writer.recordMidi({{"type", "note_on"}, {"note", 60}, {"velocity", 100}, {"channel", 0}, {"id", i}}, i);
+    }
+    writer.close();
+    EXPECT_EQ(fileBytes(), 32u + 100u * (16 + 8));
+}
+
+// ============================================================================
+// Test replay
+// ============================================================================
+
+TEST_F(InputJournalTest, DispatchUntilReplaysEachEventOnceInOrder) {
+    for (int i = 0; i < 5; i++) {
+        writer.recordMidi({{"type", "note_off"}, {"note", 60 + i}, {"channel", 0}}, i * 1000);
+    }
+    writer.close();
+    ASSERT_TRUE(reader.open(JOURNAL_PATH));
+
+    std::vector<int> notes;
+    auto record = [&notes](const InputJournalEvent & event) { notes.push_back(event.json()["note"]); };
+    EXPECT_EQ(reader.dispatchUntil(0, record), 1u);
+    EXPECT_EQ(reader.dispatchUntil(999, record), 0u);
+    EXPECT_EQ(reader.dispatchUntil(3000, record), 3u);
+    EXPECT_EQ(reader.dispatchUntil(UINT64_MAX, record), 1u);
+    EXPECT_EQ(notes, (std::vector<int>{60, 61, 62, 63, 64}));
+
+    reader.rewind();
+    EXPECT_EQ(reader.dispatchUntil(UINT64_MAX, record), 5u);
+}
+
+TEST_F(InputJournalTest, TruncatedRecordEndsReplay) {
+    writer.recordMidi({{"type", "note_off"}, {"note", 60}, {"channel", 0}}, 100);
+    writer.recordMidi({{"type", "note_off"}, {"note", 61}, {"channel", 0}}, 200);
+    writer.close();
+    std::string bytes;
+    {
+        std::ifstream file(JOURNAL_PATH, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(JOURNAL_PATH, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), bytes.size() - 3);  // As if the app died mid-write
+    }
+
+    ASSERT_TRUE(reader.open(JOURNAL_PATH));
+    EXPECT_EQ(reader.getDurationUs(), 100u);
+    InputJournalEvent event;
+    EXPECT_TRUE(reader.next(event));
+    EXPECT_FALSE(reader.next(event));
+}
+
+TEST_F(InputJournalTest, RecognizesJournals) {
+    writer.close();
+    EXPECT_TRUE(InputJournalReader::isJournal(JOURNAL_PATH));
+
+    std::ofstream(JOURNAL_PATH, std::ios::trunc) << R"(2022-09-08T20:19:41-0700 midi {"type": "note_on"})"
+                                                  << std::string(32, ' ') << "\n";
+    EXPECT_FALSE(InputJournalReader::isJournal(JOURNAL_PATH));
+    EXPECT_FALSE(reader.open(JOURNAL_PATH));
+    EXPECT_FALSE(InputJournalReader::isJournal("/nonexistent/orgb.journal"));
+}
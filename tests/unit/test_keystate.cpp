@@ -7,7 +7,9 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include "KeyState.hpp"
 #include "Utilities.hpp"
@@ -44,6 +46,22 @@ TEST_F(KeyStateTest, ActivePressTracking) {
     EXPECT_FALSE(ks.isActivelyPressed(60));
 }
 
+TEST_F(KeyStateTest, ForEachActivePressSkipsReleased) {
+    ks.newKeyPressedHandler(60, 0.8f, 1);
+    ks.newKeyPressedHandler(62, 0.8f, 2);
+    ks.newKeyPressedHandler(64, 0.8f, 3);
+    ks.keyReleasedHandler(62);
+
+    std::vector<unsigned int> visited;
+    ks.forEachActivePress([&](const Press & press) { visited.push_back(press.id); });
+    std::vector<unsigned int> copied;
+    for (const auto & press : ks.activePresses()) {
+        copied.push_back(press.id);
+    }
+    EXPECT_EQ(visited, (std::vector<unsigned int>{1, 3}));
+    EXPECT_EQ(visited, copied);
+}
+
 TEST_F(KeyStateTest, GetActivePress) {
     EXPECT_FALSE(ks.getActivePress(60).has_value());
 
@@ -282,6 +300,15 @@ TEST_F(KeyStateTest, AllEphemeralPresses) {
     EXPECT_EQ(ephemeral.size(), 2);
 }
 
+TEST_F(KeyStateTest, ForEachEphemeralPressVisitsEveryPress) {
+    ks.ephemeralKeyPressedHandler(60, 0.8f, 1);
+    ks.ephemeralKeyPressedHandler(64, 0.7f, 2);
+
+    std::set<unsigned int> visited;
+    ks.forEachEphemeralPress([&](const Press & press) { visited.insert(press.id); });
+    EXPECT_EQ(visited, (std::set<unsigned int>{1, 2}));
+}
+
 TEST_F(KeyStateTest, AllEphemeralPressesChromaticGrouped) {
     ks.ephemeralKeyPressedHandler(60, 0.8f, 1);  // C
     ks.ephemeralKeyPressedHandler(72, 0.7f, 2);  // C (octave higher)
@@ -0,0 +1,203 @@
+/**
+ * Unit tests for TripleBuffer and LedOutput
+ *
+ * Tests that the newest published value wins, that replaced and re-sent frames are counted, that values cross
+ * threads intact, and that frames reach the driver as RGB of the current size.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+#include "LedOutput.hpp"
+#include "TripleBuffer.hpp"
+
+#define REFRESH_HZ 500
+#define WAIT_TIMEOUT_S 5.0
+
+// ============================================================================
+// Test TripleBuffer
+// ============================================================================
+
+TEST(TripleBufferTest, NothingToAcquireBeforePublish) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.acquire());
+}
+
+TEST(TripleBufferTest, AcquireReturnsPublishedValue) {
+    TripleBuffer<int> buffer;
+    buffer.writeBuffer() = 7;
+    EXPECT_FALSE(buffer.publish());
+
+    ASSERT_TRUE(buffer.acquire());
+    EXPECT_EQ(buffer.readBuffer(), 7);
+    EXPECT_FALSE(buffer.acquire());
+    EXPECT_EQ(buffer.readBuffer(), 7);
+}
+
+TEST(TripleBufferTest, NewestPublishWins) {
+    TripleBuffer<int> buffer;
+    buffer.writeBuffer() = 1;
+    EXPECT_FALSE(buffer.publish());
+    buffer.writeBuffer() = 2;
+    EXPECT_TRUE(buffer.publish());  // 1 was never acquired
+
+    ASSERT_TRUE(buffer.acquire());
+    EXPECT_EQ(buffer.readBuffer(), 2);
+}
+
+TEST(TripleBufferTest, WriterNeverTouchesReadBuffer) {
+    TripleBuffer<int> buffer;
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    ASSERT_TRUE(buffer.acquire());
+    int * held = &buffer.readBuffer();
+
+    for (int i = 2; i < 10; i++) {
+        buffer.writeBuffer() = i;
+        EXPECT_NE(&buffer.writeBuffer(), held);
+        buffer.publish();
+    }
+    EXPECT_EQ(*held, 1);
+}
+
+TEST(TripleBufferTest, ValuesCrossThreadsIntact) {
+    // Each value is an array of one repeated number, so a torn read shows up as a mix
+    TripleBuffer<std::array<int, 64>> buffer;
+    const int count = 100000;
+
+    std::thread producer([&] {
+        for (int i = 1; i <= count; i++) {
+            buffer.writeBuffer().fill(i);
+            buffer.publish();
+        }
+    });
+
+    int last = 0;
+    bool torn = false;
+    bool backwards = false;
+    while (last < count) {
+        if (!buffer.acquire()) {
+            continue;
+        }
+        const auto & value = buffer.readBuffer();
+        for (int v : value) {
+            torn |= v != value[0];
+        }
+        backwards |= value[0] <= last;
+        last = value[0];
+    }
+    producer.join();
+
+    EXPECT_FALSE(torn);
+    EXPECT_FALSE(backwards);
+}
+
+// ============================================================================
+// Test LedOutput
+// ============================================================================
+
+class LedOutputTest : public ::testing::Test {
+   protected:
+    LedOutput output;
+
+    static ofPixels frame(unsigned char value) {
+        ofPixels pixels;
+        pixels.allocate(4, 2, OF_PIXELS_RGBA);
+        pixels.setColor(ofColor(value, value, value, 255));
+        return pixels;
+    }
+
+    // Poll until the condition holds or the timeout passes
+    template <typename Condition>
+    static bool waitFor(Condition condition) {
+        float start = ofGetElapsedTimef();
+        while (!condition()) {
+            if (ofGetElapsedTimef() - start > WAIT_TIMEOUT_S) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+TEST_F(LedOutputTest, FramesReplacedBeforeSendingAreDropped) {
+    output.submit(frame(10));
+    output.submit(frame(20));
+    output.submit(frame(30));
+
+    EXPECT_EQ(output.getSubmittedFrames(), 3u);
+    EXPECT_EQ(output.getDroppedFrames(), 2u);
+    EXPECT_EQ(output.getSentFrames(), 0u);
+}
+
+TEST_F(LedOutputTest, SendsNewestFrameThenRepeatsIt) {
+    output.submit(frame(10));
+    output.submit(frame(20));
+
+    std::atomic<int> calls{0};
+    std::atomic<int> lastValue{-1};
+    output.start(
+        [&](ofPixels & pixels) {
+            lastValue = pixels.getColor(0, 0).r;
+            calls++;
+        },
+        REFRESH_HZ);
+    ASSERT_TRUE(waitFor([&] { return calls >= 3; }));
+    output.stop();
+
+    EXPECT_EQ(lastValue, 20);
+    EXPECT_EQ(output.getSentFrames(), 1u);
+    EXPECT_EQ(output.getRepeatedFrames(), static_cast<uint64_t>(calls - 1));
+}
+
+TEST_F(LedOutputTest, NothingSentBeforeFirstFrame) {
+    std::atomic<int> calls{0};
+    output.start([&](ofPixels &) { calls++; }, REFRESH_HZ);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(calls, 0);
+
+    output.submit(frame(5));
+    ASSERT_TRUE(waitFor([&] { return calls >= 1; }));
+    output.stop();
+
+    EXPECT_EQ(output.getRepeatedFrames(), static_cast<uint64_t>(calls - 1));
+    EXPECT_FALSE(output.isRunning());
+}
+
+// ============================================================================
+// Test RGB conversion
+// ============================================================================
+
+TEST(LedOutputRgbTest, DropsAlphaAndFollowsResize) {
+    ofPixels rgba;
+    rgba.allocate(4, 2, OF_PIXELS_RGBA);
+    rgba.setColor(ofColor(10, 20, 30, 128));
+    ofImage image;
+    image.setUseTexture(false);
+
+    LedOutput::toRgb(rgba, image.getPixels());
+    image.update();
+    EXPECT_EQ(image.getWidth(), 4);
+    EXPECT_EQ(image.getHeight(), 2);
+    EXPECT_EQ(image.getPixels().getNumChannels(), 3u);
+    EXPECT_EQ(image.getPixels().getColor(3, 1), ofColor(10, 20, 30));
+
+    // As after a window resize
+    rgba.allocate(6, 3, OF_PIXELS_RGBA);
+    rgba.setColor(ofColor(40, 50, 60, 255));
+    LedOutput::toRgb(rgba, image.getPixels());
+    image.update();
+    EXPECT_EQ(image.getWidth(), 6);
+    EXPECT_EQ(image.getHeight(), 3);
+    EXPECT_EQ(image.getPixels().getNumChannels(), 3u);
+    EXPECT_EQ(image.getPixels().getColor(5, 2), ofColor(40, 50, 60));
+
+    // Same size again reuses the allocation
+    const unsigned char * data = image.getPixels().getData();
+    LedOutput::toRgb(rgba, image.getPixels());
+    EXPECT_EQ(image.getPixels().getData(), data);
+}
@@ -0,0 +1,162 @@
+/**
+ * Unit tests for offline rendering
+ *
+ * Tests that recorded input logs parse with the right event times and replay in order, and that the frame writer
+ * produces a well-formed y4m stream with the expected colour conversion.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "FrameSequenceWriter.hpp"
+#include "InputLog.hpp"
+
+#define Y4M_PATH "/tmp/orgb-test-offline.y4m"
+#define LOG_PATH "/tmp/orgb-test-offline.txt"
+
+static std::string readFile(const std::string & path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static ofPixels solidFrame(int width, int height, ofColor color) {
+    ofPixels pixels;
+    pixels.allocate(width, height, OF_PIXELS_RGBA);
+    pixels.setColor(color);
+    return pixels;
+}
+
+// ============================================================================
+// Test InputLog
+// ============================================================================
+
+TEST(InputLogTest, LineStampAppliesUtcOffset) {
+    InputEvent event;
+    ASSERT_TRUE(InputLog::parseLine(R"(2022-09-08T20:19:41-0700 midi {"type": "note_on"})", event));
+    EXPECT_DOUBLE_EQ(event.timeS, 1662693581.0);  // 2022-09-09 03:19:41 UTC
+    EXPECT_EQ(event.topic, "midi");
+    EXPECT_EQ(event.payload, R"({"type": "note_on"})");
+}
+
+TEST(InputLogTest, MidiReadTimeTakesPrecedence) {
+    InputEvent event;
+    ASSERT_TRUE(InputLog::parseLine(
+        R"(2022-09-08T20:19:41-0700 midi {"type": "control_change", "midi_read_time": "2022-09-09 03:19:41.168939"})",
+        event));
+    EXPECT_NEAR(event.timeS, 1662693581.168939, 1e-6);
+}
+
+TEST(InputLogTest, RejectsMalformedLines) {
+    InputEvent event;
+    EXPECT_FALSE(InputLog::parseLine("", event));
+    EXPECT_FALSE(InputLog::parseLine("2022-09-08T20:19:41-0700 midi", event));
+    EXPECT_FALSE(InputLog::parseLine("yesterday midi {}", event));
+    EXPECT_FALSE(InputLog::parseLine("2022-09-08T20:19:41-0700 midi {not json", event));
+}
+
+TEST(InputLogTest, LoadTextMakesTimesRelativeAndSorted) {
+    {
+        std::ofstream file(LOG_PATH);
+        file << R"(2022-09-08T20:19:42-0700 midi {"id": 2, "midi_read_time": "2022-09-09 03:19:42.500000"})" << "\n";
+        file << "garbage\n\n";
+        file << R"(2022-09-08T20:19:41-0700 midi {"id": 1, "midi_read_time": "2022-09-09 03:19:41.250000"})" << "\n";
+        file << R"(2022-09-08T20:19:45-0700 orgb-param {"id": 3})" << "\n";
+    }
+    InputLog log;
+    ASSERT_TRUE(log.loadText(LOG_PATH));
+    std::remove(LOG_PATH);
+
+    ASSERT_EQ(log.getEvents().size(), 3u);
+    EXPECT_DOUBLE_EQ(log.getEvents()[0].timeS, 0.0);
+    EXPECT_NEAR(log.getEvents()[1].timeS, 1.25, 1e-6);
+    EXPECT_NEAR(log.getEvents()[2].timeS, 3.75, 1e-6);
+    EXPECT_EQ(log.getEvents()[2].topic, "orgb-param");
+    EXPECT_NEAR(log.getDurationS(), 3.75, 1e-6);
+}
+
+TEST(InputLogTest, LoadTextFailsOnMissingFile) {
+    InputLog log;
+    EXPECT_FALSE(log.loadText("/nonexistent/orgb-input.txt"));
+}
+
+TEST(InputLogTest, DispatchUntilReplaysEachEventOnceInOrder) {
+    InputLog log;
+    log.setEvents({{12.0, "b", "{}"}, {10.0, "a", "{}"}, {10.5, "c", "{}"}});
+
+    std::vector<std::string> seen;
+    auto record = [&seen](const InputEvent & event) { seen.push_back(event.topic); };
+    EXPECT_EQ(log.dispatchUntil(0.0, record), 1u);
+    EXPECT_EQ(log.dispatchUntil(0.0, record), 0u);
+    EXPECT_EQ(log.dispatchUntil(0.49, record), 0u);
+    EXPECT_EQ(log.dispatchUntil(5.0, record), 2u);
+    EXPECT_TRUE(log.isFinished());
+    EXPECT_EQ(seen, (std::vector<std::string>{"a", "c", "b"}));
+
+    log.rewind();
+    EXPECT_FALSE(log.isFinished());
+    EXPECT_EQ(log.dispatchUntil(5.0, record), 3u);
+}
+
+// ============================================================================
+// Test FrameSequenceWriter
+// ============================================================================
+
+TEST(FrameSequenceWriterTest, ConvertsToLimitedRangeBt601) {
+    const unsigned char rgba[] = {0, 0, 0, 255, 255, 255, 255, 255, 255, 0, 0, 255};
+    unsigned char y[3], u[3], v[3];
+    FrameSequenceWriter::rgbToYuv444(rgba, 4, 3, y, u, v);
+    EXPECT_EQ(y[0], 16);  // Black
+    EXPECT_EQ(u[0], 128);
+    EXPECT_EQ(v[0], 128);
+    EXPECT_EQ(y[1], 235);  // White
+    EXPECT_EQ(u[1], 128);
+    EXPECT_EQ(v[1], 128);
+    EXPECT_EQ(y[2], 82);  // Red
+    EXPECT_EQ(u[2], 90);
+    EXPECT_EQ(v[2], 240);
+}
+
+TEST(FrameSequenceWriterTest, WritesY4mStream) {
+    FrameSequenceWriter writer;
+    ASSERT_TRUE(writer.open(Y4M_PATH, 30, 2));  // A short queue, so write() has to wait on the thread
+    EXPECT_TRUE(writer.isStream());
+    for (int i = 0; i < 5; i++) {
+        writer.write(solidFrame(4, 2, ofColor(255, 255, 255)));
+    }
+    writer.close();
+    EXPECT_EQ(writer.getFramesWritten(), 5u);
+    EXPECT_EQ(writer.getFramesFailed(), 0u);
+
+    std::string data = readFile(Y4M_PATH);
+    std::remove(Y4M_PATH);
+    std::string header = "YUV4MPEG2 W4 H2 F30:1 Ip A1:1 C444\n";
+    size_t frameBytes = 6 + 4 * 2 * 3;  // "FRAME\n" and three full planes
+    ASSERT_EQ(data.size(), header.size() + 5 * frameBytes);
+    EXPECT_EQ(data.substr(0, header.size()), header);
+
+    std::string frame = data.substr(header.size(), frameBytes);
+    EXPECT_EQ(frame.substr(0, 6), "FRAME\n");
+    EXPECT_EQ(frame.substr(6, 8), std::string(8, static_cast<char>(235)));   // Y
+    EXPECT_EQ(frame.substr(14, 16), std::string(16, static_cast<char>(128)));  // U and V
+}
+
+TEST(FrameSequenceWriterTest, SkipsFramesOfAnotherSize) {
+    FrameSequenceWriter writer;
+    ASSERT_TRUE(writer.open(Y4M_PATH, 60));
+    writer.write(solidFrame(4, 2, ofColor(0, 0, 0)));
+    writer.write(solidFrame(2, 2, ofColor(0, 0, 0)));
+    writer.write(solidFrame(4, 2, ofColor(0, 0, 0)));
+    writer.close();
+    std::remove(Y4M_PATH);
+    EXPECT_EQ(writer.getFramesWritten(), 2u);
+    EXPECT_EQ(writer.getFramesFailed(), 1u);
+}
+
+TEST(FrameSequenceWriterTest, OpenFailsOnUnwritablePath) {
+    FrameSequenceWriter writer;
+    EXPECT_FALSE(writer.open("/nonexistent/orgb.y4m", 60));
+    EXPECT_FALSE(writer.isOpen());
+}
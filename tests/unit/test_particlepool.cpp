@@ -0,0 +1,187 @@
+/**
+ * Unit tests for ParticlePool and PressPalette
+ *
+ * Tests batched emission, capacity limits, swap-removal, palette slot reference counting and growth,
+ * and that a steady-state emit/prune cycle performs zero heap allocations.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "AllocationCounter.hpp"
+#include "ParticlePool.hpp"
+#include "PressPalette.hpp"
+
+class ParticlePoolTest : public ::testing::Test {
+   protected:
+    ParticlePool pool{64};
+};
+
+// ============================================================================
+// Test emission
+// ============================================================================
+
+TEST_F(ParticlePoolTest, StartsEmptyWithCapacity) {
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_EQ(pool.capacity(), 64);
+    EXPECT_EQ(pool.droppedCount(), 0);
+}
+
+TEST_F(ParticlePoolTest, EmitTagsBatchWithSlot) {
+    ParticleBatch batch = pool.emit(7, 10);
+
+    EXPECT_EQ(batch.size(), 10);
+    EXPECT_EQ(pool.size(), 10);
+    for (const auto & pp : batch) {
+        EXPECT_EQ(pp.slot, 7);
+    }
+}
+
+TEST_F(ParticlePoolTest, EmitFillsInPlace) {
+    for (auto & pp : pool.emit(1, 3)) {
+        pp.particle.position = glm::vec3(5, 6, 0);
+        pp.particle.velocity = glm::vec3(1, 0, 0);
+    }
+
+    for (const auto & pp : pool) {
+        EXPECT_FLOAT_EQ(pp.particle.position.x, 5.0f);
+        EXPECT_FLOAT_EQ(pp.particle.velocity.x, 1.0f);
+    }
+}
+
+TEST_F(ParticlePoolTest, EmitTruncatesAtCapacity) {
+    pool.emit(1, 60);
+    ParticleBatch batch = pool.emit(2, 10);
+
+    EXPECT_EQ(batch.size(), 4);
+    EXPECT_EQ(pool.size(), 64);
+    EXPECT_EQ(pool.droppedCount(), 6);
+}
+
+// ============================================================================
+// Test removal
+// ============================================================================
+
+TEST_F(ParticlePoolTest, RemoveIfKeepsSurvivors) {
+    pool.emit(1, 5);
+    pool.emit(2, 5);
+    pool.emit(3, 5);
+
+    pool.removeIf([](const PooledParticle & pp) { return pp.slot == 2; });
+
+    EXPECT_EQ(pool.size(), 10);
+    for (const auto & pp : pool) {
+        EXPECT_NE(pp.slot, 2);
+    }
+}
+
+TEST_F(ParticlePoolTest, RemoveIfAll) {
+    pool.emit(1, 20);
+    pool.removeIf([](const PooledParticle &) { return true; });
+    EXPECT_TRUE(pool.empty());
+}
+
+// ============================================================================
+// Test PressPalette
+// ============================================================================
+
+TEST(PressPaletteTest, AcquireReusesSlotForSamePress) {
+    PressPalette palette(8);
+    uint16_t a = palette.acquire(100, 3);
+    uint16_t b = palette.acquire(100, 2);
+    uint16_t c = palette.acquire(200, 1);
+
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(palette.find(100), a);
+    EXPECT_EQ(palette.activeSlotCount(), 2);
+}
+
+TEST(PressPaletteTest, ReleaseFreesSlotAtZeroReferences) {
+    PressPalette palette(8);
+    uint16_t slot = palette.acquire(100, 2);
+
+    palette.release(slot);
+    EXPECT_EQ(palette.find(100), slot);
+
+    palette.release(slot);
+    EXPECT_EQ(palette.find(100), PressPalette::NO_SLOT);
+    EXPECT_EQ(palette.activeSlotCount(), 0);
+}
+
+TEST(PressPaletteTest, ColorIsSharedBySlot) {
+    PressPalette palette(8);
+    uint16_t slot = palette.acquire(100, 1);
+    palette.setColor(slot, ofColor(10, 20, 30, 40));
+
+    EXPECT_EQ(palette.color(slot).r, 10);
+    EXPECT_EQ(palette.color(slot).a, 40);
+}
+
+TEST(PressPaletteTest, ExhaustedTableGrows) {
+    PressPalette palette(2);
+    uint16_t first = palette.acquire(1, 1);
+    palette.setColor(first, ofColor(10, 20, 30, 40));
+    palette.acquire(2, 1);
+    uint16_t third = palette.acquire(3, 1);
+
+    ASSERT_NE(third, PressPalette::NO_SLOT);
+    EXPECT_GE(palette.slotCount(), 3);
+    EXPECT_EQ(palette.activeSlotCount(), 3);
+    EXPECT_EQ(palette.find(1), first);
+    EXPECT_EQ(palette.color(first).a, 40);  // Kept across the growth
+}
+
+TEST(PressPaletteTest, ThousandsOfPressesEachKeepASlot) {
+    PressPalette palette(512);
+    std::vector<uint16_t> slots;
+    // Spaced like microsecond timestamps, so neighbouring ids share low bits
+    for (unsigned int i = 0; i < 3000; i++) {
+        slots.push_back(palette.acquire(1000000 + i * 1024, 1));
+        ASSERT_NE(slots.back(), PressPalette::NO_SLOT);
+    }
+    EXPECT_EQ(palette.activeSlotCount(), 3000);
+    for (unsigned int i = 0; i < 3000; i++) {
+        EXPECT_EQ(palette.find(1000000 + i * 1024), slots[i]);
+    }
+
+    // Releasing every other press leaves the rest findable
+    for (unsigned int i = 0; i < 3000; i += 2) {
+        palette.release(slots[i]);
+    }
+    for (unsigned int i = 0; i < 3000; i++) {
+        EXPECT_EQ(palette.find(1000000 + i * 1024), i % 2 == 0 ? PressPalette::NO_SLOT : slots[i]);
+    }
+    EXPECT_EQ(palette.activeSlotCount(), 1500);
+}
+
+// ============================================================================
+// Test steady-state allocations
+// ============================================================================
+
+TEST_F(ParticlePoolTest, SteadyStateDoesNotAllocate) {
+    ParticlePool bigPool(4096);
+    PressPalette palette(64);
+    ScopedAllocationCounter allocations;
+
+    // Simulate a few hundred frames of emission, palette updates, and pruning
+    for (int frame = 0; frame < 300; frame++) {
+        uint16_t slot = palette.acquire(frame / 30, 40);
+        palette.setColor(slot, ofColor(frame % 255, 0, 0));
+        for (auto & pp : bigPool.emit(slot, 40)) {
+            pp.particle.position = glm::vec3(frame, 0, 0);
+        }
+        bigPool.removeIf([frame, &palette](const PooledParticle & pp) {
+            if (pp.particle.position.x < frame - 30) {
+                palette.release(pp.slot);
+                return true;
+            }
+            return false;
+        });
+    }
+
+    EXPECT_EQ(allocations.count(), 0);
+    EXPECT_GT(bigPool.size(), 0);
+}
@@ -0,0 +1,172 @@
+/**
+ * Unit tests for QualityGovernor
+ *
+ * Tests downgrade on sustained slow frames, hysteresis before upgrading, per-knob cost measurement,
+ * frame cost from CPU, GPU and interval timings, and quality bounds.
+ */
+
+#include <gtest/gtest.h>
+
+#include "QualityGovernor.hpp"
+
+#define TARGET_S (1.0 / 60.0)
+#define WINDOW 10
+
+class QualityGovernorTest : public ::testing::Test {
+   protected:
+    QualityGovernor governor{TARGET_S, WINDOW};
+
+    void feedWindows(int windows, double frameTimeS) {
+        for (int i = 0; i < windows * WINDOW; i++) {
+            governor.recordFrame(frameTimeS);
+        }
+    }
+};
+
+// ============================================================================
+// Test stepping
+// ============================================================================
+
+TEST_F(QualityGovernorTest, StartsAtFullQuality) {
+    size_t knob = governor.addKnob("count", 0.25);
+    EXPECT_FLOAT_EQ(governor.scale(knob), 1.0f);
+    EXPECT_FLOAT_EQ(governor.level(), 1.0f);
+}
+
+TEST_F(QualityGovernorTest, SlowFramesStepDown) {
+    size_t knob = governor.addKnob("count", 0.25, 3);
+    feedWindows(1, TARGET_S * 2);
+
+    EXPECT_FLOAT_EQ(governor.scale(knob), 0.75f);
+    EXPECT_LT(governor.level(), 1.0f);
+}
+
+TEST_F(QualityGovernorTest, NeverGoesBelowMinScale) {
+    size_t knob = governor.addKnob("count", 0.25, 3);
+    feedWindows(10, TARGET_S * 2);
+
+    EXPECT_FLOAT_EQ(governor.scale(knob), 0.25f);
+}
+
+TEST_F(QualityGovernorTest, SingleHitchIsIgnored) {
+    size_t knob = governor.addKnob("count", 0.25);
+    for (int i = 0; i < WINDOW; i++) {
+        governor.recordFrame(i == 3 ? TARGET_S * 10 : TARGET_S * 0.8);
+    }
+    EXPECT_FLOAT_EQ(governor.scale(knob), 1.0f);
+}
+
+TEST_F(QualityGovernorTest, UpgradeNeedsSustainedHeadroom) {
+    size_t knob = governor.addKnob("count", 0.25, 3);
+    feedWindows(1, TARGET_S * 2);
+    ASSERT_LT(governor.scale(knob), 1.0f);
+
+    // Inside the hysteresis band: nothing changes
+    feedWindows(5, TARGET_S * 0.9);
+    EXPECT_FLOAT_EQ(governor.scale(knob), 0.75f);
+
+    // Two good windows are not enough, the third restores quality
+    feedWindows(2, TARGET_S * 0.5);
+    EXPECT_FLOAT_EQ(governor.scale(knob), 0.75f);
+    feedWindows(1, TARGET_S * 0.5);
+    EXPECT_FLOAT_EQ(governor.scale(knob), 1.0f);
+}
+
+// ============================================================================
+// Test cost measurement
+// ============================================================================
+
+TEST_F(QualityGovernorTest, MeasuresCostAndCutsMostExpensiveKnob) {
+    size_t cheap = governor.addKnob("cheap", 0.25, 4);
+    size_t costly = governor.addKnob("costly", 0.25, 4);
+
+    // Simulated frame time: each cheap step saves 1ms, each costly step saves 8ms
+    auto frameTime = [&]() {
+        int cheapLevel = governor.getKnobs()[cheap].level;
+        int costlyLevel = governor.getKnobs()[costly].level;
+        return 0.040 - 0.001 * cheapLevel - 0.008 * costlyLevel;
+    };
+    for (int w = 0; w < 4; w++) {
+        for (int i = 0; i < WINDOW; i++) {
+            governor.recordFrame(frameTime());
+        }
+    }
+
+    EXPECT_NEAR(governor.getKnobs()[cheap].costMs, 1.0f, 0.01f);
+    EXPECT_NEAR(governor.getKnobs()[costly].costMs, 8.0f, 0.01f);
+    // Once both are measured the costly knob is the one that keeps being cut
+    EXPECT_GE(governor.getKnobs()[costly].level, 2);
+    EXPECT_EQ(governor.getKnobs()[cheap].level, 1);
+}
+
+// ============================================================================
+// Test frame cost
+// ============================================================================
+
+// draw() returns quickly while the GPU runs long, as on the Pi
+TEST_F(QualityGovernorTest, GpuBoundFramesStepDown) {
+    size_t knob = governor.addKnob("count", 0.25, 3);
+    for (int i = 0; i < WINDOW; i++) {
+        governor.recordFrame(TARGET_S * 0.2, TARGET_S * 2, TARGET_S * 2);
+    }
+    EXPECT_FLOAT_EQ(governor.scale(knob), 0.75f);
+}
+
+TEST_F(QualityGovernorTest, LateIntervalsStepDownWithoutGpuTimer) {
+    size_t knob = governor.addKnob("count", 0.25, 3);
+    EXPECT_DOUBLE_EQ(governor.frameCost(TARGET_S * 0.2, -1, TARGET_S * 2), TARGET_S * 2);
+    for (int i = 0; i < WINDOW; i++) {
+        governor.recordFrame(TARGET_S * 0.2, -1, TARGET_S * 2);
+    }
+    EXPECT_FLOAT_EQ(governor.scale(knob), 0.75f);
+}
+
+// An on-time interval is the vsync period, whatever the frame cost
+TEST_F(QualityGovernorTest, OnTimeIntervalsKeepHeadroom) {
+    size_t knob = governor.addKnob("count", 0.25, 3);
+    feedWindows(1, TARGET_S * 2);
+    ASSERT_FLOAT_EQ(governor.scale(knob), 0.75f);
+
+    EXPECT_DOUBLE_EQ(governor.frameCost(TARGET_S * 0.2, TARGET_S * 0.3, TARGET_S), TARGET_S * 0.3);
+    for (int i = 0; i < 5 * WINDOW; i++) {
+        governor.recordFrame(TARGET_S * 0.2, TARGET_S * 0.3, TARGET_S);
+    }
+    EXPECT_FLOAT_EQ(governor.scale(knob), 1.0f);
+}
+
+// ============================================================================
+// Test bounds
+// ============================================================================
+
+TEST_F(QualityGovernorTest, MinLevelStopsDowngrades) {
+    governor.addKnob("count", 0.25, 4);
+    governor.setBounds(0.5f, 1.0f);
+    feedWindows(10, TARGET_S * 2);
+
+    EXPECT_GE(governor.level(), 0.5f - 0.0001f);
+}
+
+TEST_F(QualityGovernorTest, MaxLevelCapsQualityWithHeadroom) {
+    governor.addKnob("count", 0.25, 4);
+    governor.setBounds(0.0f, 0.5f);
+    feedWindows(10, TARGET_S * 0.1);
+
+    EXPECT_LE(governor.level(), 0.5f + 0.0001f);
+}
+
+TEST_F(QualityGovernorTest, DisabledIgnoresFrames) {
+    size_t knob = governor.addKnob("count", 0.25);
+    governor.setEnabled(false);
+    feedWindows(5, TARGET_S * 2);
+
+    EXPECT_FLOAT_EQ(governor.scale(knob), 1.0f);
+}
+
+TEST_F(QualityGovernorTest, ResetRestoresFullQuality) {
+    size_t knob = governor.addKnob("count", 0.25);
+    feedWindows(3, TARGET_S * 2);
+    ASSERT_LT(governor.scale(knob), 1.0f);
+
+    governor.reset();
+    EXPECT_FLOAT_EQ(governor.scale(knob), 1.0f);
+}
@@ -0,0 +1,98 @@
+/**
+ * Unit tests for SharedFrameRing
+ *
+ * Tests that frames written to the shared-memory ring are read back in place with their header, that the reader
+ * detects being lapped, and that a size change replaces the segment.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "SharedFrameRing.hpp"
+
+#define RING_NAME "/orgb-test-frames"
+#define SLOTS 3
+
+class SharedFrameRingTest : public ::testing::Test {
+   protected:
+    SharedFrameWriter writer;
+    SharedFrameReader reader;
+
+    void SetUp() override { writer.setup(RING_NAME, SLOTS); }
+
+    static ofPixels frame(int width, int height, unsigned char value) {
+        ofPixels pixels;
+        pixels.allocate(width, height, OF_PIXELS_RGBA);
+        for (size_t i = 0; i < pixels.getTotalBytes(); i++) {
+            pixels.getData()[i] = static_cast<unsigned char>(value + i % 4);
+        }
+        return pixels;
+    }
+};
+
+// ============================================================================
+// Test writing and reading
+// ============================================================================
+
+TEST_F(SharedFrameRingTest, NothingToReadBeforeFirstWrite) {
+    EXPECT_FALSE(reader.open(RING_NAME));  // Created lazily
+    ASSERT_TRUE(writer.write(frame(16, 4, 10)));
+    ASSERT_TRUE(reader.open(RING_NAME));
+    EXPECT_FALSE(reader.isClosed());
+}
+
+TEST_F(SharedFrameRingTest, ReadsNewestFrameInPlace) {
+    ofPixels first = frame(16, 4, 10);
+    ofPixels second = frame(16, 4, 50);
+    ASSERT_TRUE(writer.write(first));
+    ASSERT_TRUE(reader.open(RING_NAME));
+    ASSERT_TRUE(writer.write(second));
+
+    SharedFrameReader::Frame latest;
+    ASSERT_TRUE(reader.latest(latest));
+    EXPECT_EQ(latest.sequence, 2u);
+    EXPECT_EQ(latest.width, 16u);
+    EXPECT_EQ(latest.height, 4u);
+    EXPECT_EQ(latest.rowBytes, 64u);
+    EXPECT_EQ(latest.format, static_cast<uint32_t>(SHARED_FRAME_FORMAT_RGBA));
+    EXPECT_GT(latest.timestampUs, 0u);
+    EXPECT_EQ(memcmp(latest.pixels, second.getData(), second.getTotalBytes()), 0);
+    EXPECT_TRUE(reader.stillValid(latest));
+}
+
+TEST_F(SharedFrameRingTest, DetectsBeingLapped) {
+    ASSERT_TRUE(writer.write(frame(16, 4, 10)));
+    ASSERT_TRUE(reader.open(RING_NAME));
+
+    SharedFrameReader::Frame held;
+    ASSERT_TRUE(reader.latest(held));
+    for (int i = 0; i < SLOTS - 1; i++) {
+        writer.write(frame(16, 4, 20));
+        EXPECT_TRUE(reader.stillValid(held)) << "after " << i + 1 << " more frames";
+    }
+    writer.write(frame(16, 4, 30));  // Reuses the held frame's slot
+    EXPECT_FALSE(reader.stillValid(held));
+}
+
+TEST_F(SharedFrameRingTest, SizeChangeClosesOldSegment) {
+    ASSERT_TRUE(writer.write(frame(16, 4, 10)));
+    ASSERT_TRUE(reader.open(RING_NAME));
+    ASSERT_TRUE(writer.write(frame(32, 8, 10)));
+    EXPECT_TRUE(reader.isClosed());
+
+    ASSERT_TRUE(reader.open(RING_NAME));
+    SharedFrameReader::Frame latest;
+    ASSERT_TRUE(reader.latest(latest));
+    EXPECT_EQ(latest.width, 32u);
+}
+
+TEST_F(SharedFrameRingTest, CloseUnlinksSegment) {
+    ASSERT_TRUE(writer.write(frame(16, 4, 10)));
+    ASSERT_TRUE(reader.open(RING_NAME));
+    writer.close();
+
+    EXPECT_TRUE(reader.isClosed());
+    SharedFrameReader other;
+    EXPECT_FALSE(other.open(RING_NAME));
+}
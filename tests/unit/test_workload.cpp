@@ -0,0 +1,219 @@
+/**
+ * Unit tests for WorkloadGenerator
+ *
+ * Tests that streams are reproducible and time-ordered however they are pulled, that each pattern keeps to its
+ * shape and range, that events reach KeyState as ofApp would deliver them, and that OSC packets are well formed.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "KeyState.hpp"
+#include "WorkloadGenerator.hpp"
+
+static std::vector<WorkloadEvent> generate(const WorkloadSettings & settings, double durationS) {
+    WorkloadGenerator generator(settings);
+    std::vector<WorkloadEvent> events;
+    generator.generateUntil(durationS, events);
+    return events;
+}
+
+static WorkloadSettings settingsFor(WorkloadPattern pattern, int polyphony = 4, double rateHz = 4) {
+    WorkloadSettings settings;
+    settings.pattern = pattern;
+    settings.polyphony = polyphony;
+    settings.rateHz = rateHz;
+    return settings;
+}
+
+static size_t countType(const std::vector<WorkloadEvent> & events, WorkloadEventType type) {
+    return std::count_if(events.begin(), events.end(), [type](const WorkloadEvent & e) { return e.type == type; });
+}
+
+static uint32_t readWord(const std::vector<uint8_t> & packet, size_t offset) {
+    return (packet[offset] << 24) | (packet[offset + 1] << 16) | (packet[offset + 2] << 8) | packet[offset + 3];
+}
+
+// ============================================================================
+// Test streams
+// ============================================================================
+
+TEST(WorkloadGeneratorTest, SameSeedGivesSameStream) {
+    WorkloadSettings settings = settingsFor(WorkloadPattern::CHORDS);
+    std::vector<WorkloadEvent> a = generate(settings, 10);
+    std::vector<WorkloadEvent> b = generate(settings, 10);
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a[i].timeS, b[i].timeS);
+        EXPECT_EQ(a[i].note, b[i].note);
+        EXPECT_EQ(a[i].velocity, b[i].velocity);
+    }
+
+    settings.seed = 2;
+    std::vector<WorkloadEvent> c = generate(settings, 10);
+    bool differs = false;
+    for (size_t i = 0; i < std::min(a.size(), c.size()); i++) {
+        differs |= a[i].note != c[i].note;
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST(WorkloadGeneratorTest, FrameByFrameMatchesAllAtOnce) {
+    WorkloadSettings settings = settingsFor(WorkloadPattern::SUSTAIN, 4, 30);
+    std::vector<WorkloadEvent> whole = generate(settings, 5);
+
+    WorkloadGenerator generator(settings);
+    std::vector<WorkloadEvent> frames;
+    for (int frame = 1; frame <= 300; frame++) {
+        generator.generateUntil(frame / 60.0, frames);
+    }
+    ASSERT_EQ(frames.size(), whole.size());
+    for (size_t i = 0; i < whole.size(); i++) {
+        EXPECT_EQ(frames[i].timeS, whole[i].timeS);
+        EXPECT_EQ(frames[i].type, whole[i].type);
+        EXPECT_EQ(frames[i].note, whole[i].note);
+        if (i > 0) {
+            EXPECT_GE(frames[i].timeS, frames[i - 1].timeS);
+        }
+    }
+}
+
+// ============================================================================
+// Test patterns
+// ============================================================================
+
+TEST(WorkloadGeneratorTest, ChordsPlayPolyphonyNotesPerStep) {
+    std::vector<WorkloadEvent> events = generate(settingsFor(WorkloadPattern::CHORDS, 10, 2), 0.01);
+    EXPECT_EQ(countType(events, WorkloadEventType::NOTE_ON), 10u);
+    for (const auto & event : events) {
+        EXPECT_GE(event.note, PIANO_LOWEST_MIDI);
+        EXPECT_LE(event.note, WORKLOAD_HIGHEST_NOTE);
+    }
+
+    events = generate(settingsFor(WorkloadPattern::CHORDS, 10, 2), 10);
+    EXPECT_EQ(countType(events, WorkloadEventType::NOTE_ON), 200u);
+    EXPECT_EQ(countType(events, WorkloadEventType::NOTE_OFF), 200u);  // The last chord ends within the run
+}
+
+TEST(WorkloadGeneratorTest, NotesStayBelowControlNotes) {
+    WorkloadSettings settings = settingsFor(WorkloadPattern::GLISS, 1, 100);
+    settings.lowNote = 100;
+    settings.highNote = 127;
+    std::vector<WorkloadEvent> events = generate(settings, 2);
+    int highest = 0;
+    for (const auto & event : events) {
+        highest = std::max(highest, event.note);
+    }
+    EXPECT_EQ(highest, WORKLOAD_HIGHEST_NOTE);
+}
+
+TEST(WorkloadGeneratorTest, TrillAlternatesTwoNotes) {
+    std::vector<WorkloadEvent> events = generate(settingsFor(WorkloadPattern::TRILLS, 1, 8), 1.9);
+    std::vector<int> notes;
+    for (const auto & event : events) {
+        if (event.type == WorkloadEventType::NOTE_ON) {
+            notes.push_back(event.note);
+        }
+    }
+    ASSERT_EQ(notes.size(), 16u);
+    for (size_t i = 2; i < notes.size(); i++) {
+        EXPECT_EQ(notes[i], notes[i - 2]);
+    }
+    EXPECT_EQ(notes[1] - notes[0], 2);
+}
+
+TEST(WorkloadGeneratorTest, PedalIsLiftedAndPressedAgain) {
+    std::vector<WorkloadEvent> events = generate(settingsFor(WorkloadPattern::SUSTAIN, 4, 8), 4.5);
+    std::vector<int> pedal;
+    for (const auto & event : events) {
+        if (event.type == WorkloadEventType::SUSTAIN) {
+            pedal.push_back(event.velocity);
+        }
+    }
+    EXPECT_EQ(pedal, (std::vector<int>{127, 0, 127, 0, 127}));
+}
+
+TEST(WorkloadGeneratorTest, GuitarFramesCarryHarmonicPartials) {
+    std::vector<WorkloadEvent> events = generate(settingsFor(WorkloadPattern::GUITAR, 6, 100), 1);
+    ASSERT_EQ(events.size(), 100u);
+    for (const auto & event : events) {
+        ASSERT_EQ(event.type, WorkloadEventType::PARTIALS);
+        EXPECT_FALSE(event.mic);
+        ASSERT_EQ(event.partials.size(), 6u);
+        float fundamental = event.partials[0].first;
+        EXPECT_GE(fundamental, GUITAR_MIDI_MIN);
+        EXPECT_LE(fundamental, GUITAR_MIDI_MAX);
+        EXPECT_EQ(event.partials[1].first, fundamental + 12);
+        EXPECT_GT(event.partials[0].second, event.partials[5].second);
+    }
+    EXPECT_NE(events[0].messageId, events[1].messageId);
+}
+
+// ============================================================================
+// Test delivery
+// ============================================================================
+
+TEST(WorkloadGeneratorTest, AppliesToKeyState) {
+    KeyState ks;
+    WorkloadGenerator generator(settingsFor(WorkloadPattern::CHORDS, 5, 1));
+    std::vector<WorkloadEvent> events;
+    generator.generateUntil(0.1, events);
+    for (const auto & event : events) {
+        WorkloadGenerator::apply(event, ks);
+    }
+    EXPECT_EQ(ks.activePresses().size(), 5u);
+
+    events.clear();
+    generator.generateUntil(0.9, events);  // The chord's note offs, at 0.25 s
+    for (const auto & event : events) {
+        WorkloadGenerator::apply(event, ks);
+    }
+    EXPECT_EQ(ks.activePresses().size(), 0u);
+
+    WorkloadGenerator mic(settingsFor(WorkloadPattern::MIC, 2, 50));
+    events.clear();
+    mic.generateUntil(0.01, events);
+    ASSERT_EQ(events.size(), 1u);
+    WorkloadGenerator::apply(events[0], ks);
+    EXPECT_EQ(ks.ephemeralPresses.size(), 2u);
+}
+
+TEST(WorkloadGeneratorTest, EncodesKeyboardNoteAsOsc) {
+    WorkloadEvent event{0, WorkloadEventType::NOTE_ON, 60, 100, 7, false, {}};
+    std::vector<uint8_t> packet = WorkloadGenerator::encodeOsc(event);
+    // Address, type tags and the type string are each zero-terminated and padded to four bytes
+    ASSERT_EQ(packet.size(), 16u + 8u + 8u + 4 * 4u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(packet.data())), "/midi/keyboard");
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(packet.data() + 16)), ",siiii");
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(packet.data() + 24)), "note_on");
+    EXPECT_EQ(readWord(packet, 32), 0u);  // Channel
+    EXPECT_EQ(readWord(packet, 36), 60u);
+    EXPECT_EQ(readWord(packet, 40), 100u);
+    EXPECT_EQ(readWord(packet, 44), 7u);
+}
+
+TEST(WorkloadGeneratorTest, EncodesMicFrameAsOsc) {
+    WorkloadEvent event{0, WorkloadEventType::PARTIALS, 0, 0, 9, true, {{60.5f, 0.25f}}};
+    std::vector<uint8_t> packet = WorkloadGenerator::encodeOsc(event);
+    ASSERT_EQ(packet.size(), 12u + 8u + 4 * 4u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(packet.data())), "/pitch/mic0");
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(packet.data() + 12)), ",iffi");
+    uint32_t pitchBits = readWord(packet, 24);
+    float pitch;
+    std::memcpy(&pitch, &pitchBits, sizeof(pitch));
+    EXPECT_FLOAT_EQ(pitch, 60.5f);
+    EXPECT_EQ(readWord(packet, 32), 9u);
+}
+
+TEST(WorkloadGeneratorTest, PatternNamesRoundTrip) {
+    for (auto pattern : {WorkloadPattern::CHORDS, WorkloadPattern::TRILLS, WorkloadPattern::GLISS,
+                         WorkloadPattern::SUSTAIN, WorkloadPattern::GUITAR, WorkloadPattern::MIC}) {
+        WorkloadPattern parsed;
+        ASSERT_TRUE(WorkloadGenerator::parsePattern(WorkloadGenerator::patternName(pattern), parsed));
+        EXPECT_EQ(parsed, pattern);
+    }
+    WorkloadPattern parsed;
+    EXPECT_FALSE(WorkloadGenerator::parsePattern("polka", parsed));
+}